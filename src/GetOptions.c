@@ -2,9 +2,24 @@
 /******** Include statements ********/
 /************************************/
 
+#define _GNU_SOURCE // memfd_create, F_ADD_SEALS
+
 #include "SeverityLog_api.h"
 #include "GetOptions.h"
 #include <string.h> // strlen, strcmp
+#include <stdio.h>  // snprintf
+#include <fcntl.h>      // open, fcntl
+#include <unistd.h>     // close, sysconf
+#include <sys/mman.h>   // mmap, munmap, memfd_create
+#include <sys/stat.h>   // fstat
+#include <ctype.h>      // isspace, toupper
+#include <stdatomic.h>  // atomic_exchange, atomic_fetch_add
+#include <signal.h>     // sig_atomic_t
+#include <stddef.h>     // offsetof
+#include <sys/un.h>     // struct sockaddr_un
+#include <netinet/in.h> // struct sockaddr_in, struct sockaddr_in6
+#include <arpa/inet.h>  // inet_pton, inet_ntop
+#include <math.h>       // isfinite
 
 /************************************/
 
@@ -14,6 +29,12 @@
 
 #define getName(var)  #var
 
+extern char** environ;
+
+// Reports an error found while validating the option definition SetOptionDefinition is working on.
+#define REPORT_DEF_ERROR(code)  ReportOptError( code, option_number, -1, opt_char, opt_long, opt_detail,  \
+                                                opt_var_type, opt_min_value, opt_max_value)
+
 /***********************************/
 
 /***********************************/
@@ -26,13 +47,67 @@ static int                  option_number           = 0;
 static int                  verbose_flag            = 1;
 static PRIV_OPT_LONG        opt_long_verbose        = {"verbose"    , no_argument   ,   &verbose_flag,  1};
 static PRIV_OPT_LONG        opt_long_brief          = {"brief"      , no_argument   ,   &verbose_flag,  0};
+static GET_OPT_DIAG*        diag_sink               = NULL;
+static char                 env_prefix[GET_OPT_SIZE_ENV_PREFIX_MAX + 1] = {0};
+static char                 cache_file_path[PATH_MAX + 1] = {0};
+static int                  retained_provenance_number  = 0;
+static int                  registration_batch_start    = -1;
+static int                  registration_batch_result   = 0;
+static GET_OPT_CODEC        option_codecs[GET_OPT_SIZE_CODEC_MAX];
+static int                  codec_number            = 0;
+static GET_OPT_CODEC        endpoint_codec          = {sizeof(struct sockaddr_storage), ParseOptEndpoint, CompareOptEndpoint, FormatOptEndpoint};
+static GET_OPT_CODEC        blob_codec              = {0, NULL, CompareOptBlob, FormatOptBlob};   // Decoded by ConvertOptBlob.
+static uint8_t              hex_decode_table[UCHAR_MAX + 1];
+static uint8_t              base64_decode_table[UCHAR_MAX + 1];
 char min_str[]              = {0};
 char max_str[PATH_MAX + 1]  = {0};
 
 /******** Private heap variables ********/
 
 static char*                short_options_string    = NULL;
+static PRIV_OPT_LONG*       long_options_table      = NULL;
+static int                  short_option_index[UCHAR_MAX + 1];  // Option index + 1 per option character, 0 means none.
+static int                  dispatch_number         = 0;
+static int                  dispatch_capacity       = 0;
+static PRIV_OPT_TRIE_NODE*  long_name_trie          = NULL;     // Built from the long options table once it is needed.
 static PRIV_OPT_DEFINITION* private_options         = NULL;
+static int                  private_option_capacity = 0;
+static int*                 free_option_slots       = NULL;
+static int                  removed_option_number   = 0;
+static int*                 long_name_index         = NULL;
+static int                  long_name_index_size    = 0;
+static int                  long_name_index_used    = 0;
+static uint64_t*            seen_options            = NULL;
+static PRIV_OPT_CONSTRAINT* options_constraints     = NULL;
+static int                  constraint_number       = 0;
+static uint64_t*            constraint_masks        = NULL;
+static int                  constraint_mask_words   = 0;
+static uint64_t*            options_flag_set        = NULL;
+static int                  flag_set_size           = 0;
+static uint64_t*            used_flag_bits          = NULL;     // Bits of the flag set taken by flag options.
+static PRIV_CONFIG_MAP*     config_maps             = NULL;
+static int                  config_map_number       = 0;
+static PRIV_OPT_PROVENANCE* retained_provenance     = NULL;
+static PRIV_OPT_ARENA_CHUNK* options_arena          = NULL;
+static size_t               arena_chunk_size        = 0;        // Size of the last chunk along the doubling sequence.
+
+// Reload mode: the schema is kept after ParseOptions, and values are published as immutable snapshots.
+static int                      reload_mode             = 0;
+static int                      retained_argc           = 0;
+static char**                   retained_argv           = NULL;
+static volatile sig_atomic_t    reload_requested        = 0;
+static uint64_t                 snapshot_generation     = 0;
+static char* _Atomic            current_snapshot        = NULL;
+static atomic_ulong             global_epoch            = 1;
+static atomic_ulong             reader_epochs[GET_OPT_SIZE_READER_SLOTS];
+static atomic_int               reader_slots_used[GET_OPT_SIZE_READER_SLOTS];
+static __thread int             reader_slot             = -1;
+static __thread int             reader_nesting          = 0;
+static PRIV_OPT_RETIRED*        retired_snapshots       = NULL;
+static int                      retired_snapshot_number = 0;
+static char**                   shared_images           = NULL;
+static PRIV_CONFIG_MAP          schema_map              = {0};
+static int                      shared_image_number     = 0;
 
 /***********************************/
 
@@ -42,10 +117,19 @@ static PRIV_OPT_DEFINITION* private_options         = NULL;
 
 void FreeHeapOptData(void)
 {
+    // Choice tables are owned by their options.
+    for(int i = 0; private_options != NULL && i < option_number; i++)
+    {
+        free(private_options[i].opt_choice);
+        free(private_options[i].opt_str_constraint);
+        free(private_options[i].opt_codec_values);
+        free(private_options[i].opt_codec_owned);
+    }
+
     if(short_options_string == NULL)
     {
         SVRTY_LOG_WNG(GET_OPT_MSG_ALREADY_NULL_PTR);
-        SVRTY_LOG_DBG("FILE: %s\tFUNCTION: %s\tLINE: %d\tPOINTER NAME: %s", __FILE__, __func__, __LINE__, getName(short_options_string));
+        GET_OPT_LOG_DBG("FILE: %s\tFUNCTION: %s\tLINE: %d\tPOINTER NAME: %s", __FILE__, __func__, __LINE__, getName(short_options_string));
     }
     else
     {
@@ -57,7 +141,7 @@ void FreeHeapOptData(void)
     if(private_options == NULL)
     {
         SVRTY_LOG_WNG(GET_OPT_MSG_ALREADY_NULL_PTR);
-        SVRTY_LOG_DBG("FILE: %s\tFUNCTION: %s\tLINE: %d\tPOINTER NAME: %s", __FILE__, __func__, __LINE__, getName(private_options));
+        GET_OPT_LOG_DBG("FILE: %s\tFUNCTION: %s\tLINE: %d\tPOINTER NAME: %s", __FILE__, __func__, __LINE__, getName(private_options));
     }
     else
     {
@@ -65,6 +149,313 @@ void FreeHeapOptData(void)
         private_options = NULL;
         option_number = 0;
     }
+
+    free(long_name_index);
+    long_name_index = NULL;
+    long_name_index_size = 0;
+    long_name_index_used = 0;
+
+    free(long_options_table);
+    long_options_table = NULL;
+    memset(short_option_index, 0, sizeof(short_option_index));
+    dispatch_number = 0;
+    dispatch_capacity = 0;
+    ReleaseLongNameTrie();
+
+    free(free_option_slots);
+    free_option_slots = NULL;
+    removed_option_number = 0;
+    private_option_capacity = 0;
+
+    free(seen_options);
+    seen_options = NULL;
+    FreeOptionsConstraints();
+
+    options_flag_set = NULL;
+    flag_set_size = 0;
+    free(used_flag_bits);
+    used_flag_bits = NULL;
+
+    registration_batch_start = -1;
+    registration_batch_result = 0;
+
+    // Config file values are staged as pointers to their mapping, so these are kept until now.
+    for(int i = 0; i < config_map_number; i++)
+    {
+        munmap(config_maps[i].map_addr, config_maps[i].map_size);
+        free(config_maps[i].file_path);
+    }
+
+    free(config_maps);
+    config_maps = NULL;
+    config_map_number = 0;
+
+    // Boundaries and defaults of options loaded from a schema file point to its mapping.
+    if(schema_map.map_addr != NULL)
+    {
+        munmap(schema_map.map_addr, schema_map.map_size);
+        schema_map.map_addr = NULL;
+        schema_map.map_size = 0;
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Sets the record in which errors are stored instead of being logged.
+/// @param diag Caller-owned error record. NULL restores logging.
+//////////////////////////////////////////////////////////////////////////////
+void SetOptionsDiagnostics(GET_OPT_DIAG* diag)
+{
+    diag_sink = diag;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Fills an error record. The message is only formatted (and logged) if no diagnostics
+///        record has been set by the caller, so failing validations stay cheap otherwise.
+/// @param code Error code.
+/// @param option_index Index of the option within the registry, -1 if unknown.
+/// @param token_offset Index of the offending token within argv, -1 if not parsing.
+/// @param opt_char Option character.
+/// @param opt_long Option string.
+/// @param opt_detail Option details.
+/// @param opt_var_type Option variable type.
+/// @param opt_min_value Option minimum value.
+/// @param opt_max_value Option maximum value.
+//////////////////////////////////////////////////////////////////////////////////////////////
+void ReportOptError(int             code            ,
+                    int             option_index    ,
+                    int             token_offset    ,
+                    char            opt_char        ,
+                    char*           opt_long        ,
+                    char*           opt_detail      ,
+                    int             opt_var_type    ,
+                    OPT_DATA_TYPE   opt_min_value   ,
+                    OPT_DATA_TYPE   opt_max_value   )
+{
+    GET_OPT_DIAG local_diag;
+    GET_OPT_DIAG* diag = (diag_sink != NULL ? diag_sink : &local_diag);
+
+    diag->code          = code          ;
+    diag->option_index  = option_index  ;
+    diag->token_offset  = token_offset  ;
+    diag->opt_char      = opt_char      ;
+    diag->opt_var_type  = opt_var_type  ;
+    diag->expected_min  = opt_min_value ;
+    diag->expected_max  = opt_max_value ;
+
+    diag->opt_long[0]   = '\0';
+    diag->opt_detail[0] = '\0';
+
+    if(opt_long != NULL)
+    {
+        size_t long_len = strnlen(opt_long, GET_OPT_SIZE_LONG_MAX);
+        memcpy(diag->opt_long, opt_long, long_len);
+        diag->opt_long[long_len] = '\0';
+    }
+
+    if(opt_detail != NULL)
+    {
+        size_t detail_len = strnlen(opt_detail, GET_OPT_SIZE_DETAIL_MAX);
+        memcpy(diag->opt_detail, opt_detail, detail_len);
+        diag->opt_detail[detail_len] = '\0';
+    }
+
+    if(diag_sink != NULL)
+    {
+        return;
+    }
+
+    char msg[GET_OPT_SIZE_DIAG_MSG_MAX];
+    GetOptionsDiagMessage(diag, msg, sizeof(msg));
+    SVRTY_LOG_ERR("%s", msg);
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+/// @brief Fills an error record taking the data from an already registered option.
+/// @param code Error code.
+/// @param option_index Index of the option within the registry.
+/// @param token_offset Index of the offending token within argv, -1 if not parsing.
+//////////////////////////////////////////////////////////////////////////////////
+void ReportOptErrorFromDef(int code, int option_index, int token_offset)
+{
+    PUB_OPT_DEFINITION* pub_opt = &private_options[option_index].pub_opt;
+
+    ReportOptError( code                        ,
+                    option_index                ,
+                    token_offset                ,
+                    pub_opt->opt_char           ,
+                    (char*)pub_opt->opt_long    ,
+                    (char*)pub_opt->opt_detail  ,
+                    pub_opt->opt_var_type       ,
+                    pub_opt->opt_min_value      ,
+                    pub_opt->opt_max_value      );
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Formats the message matching a previously filled error record.
+/// @param diag Error record.
+/// @param buffer Destination buffer.
+/// @param buffer_size Destination buffer size.
+/// @return < 0 if any error happened, formatted message length otherwise.
+//////////////////////////////////////////////////////////////////////////////
+int GetOptionsDiagMessage(GET_OPT_DIAG* diag, char* buffer, int buffer_size)
+{
+    if(diag == NULL || buffer == NULL || buffer_size <= 0)
+    {
+        return GET_OPT_ERR_NULL_PTR;
+    }
+
+    switch(diag->code)
+    {
+        case GET_OPT_ERR_NO_OPT_CHAR:
+            return snprintf(buffer, buffer_size, GET_OPT_MSG_NO_OPT_CHAR);
+
+        case GET_OPT_ERR_OPT_CHAR_ALREADY_EXISTS:
+            return snprintf(buffer, buffer_size, GET_OPT_MSG_OPT_CHAR_ALREADY_EXISTS, diag->opt_char, diag->opt_long, diag->opt_detail);
+
+        case GET_OPT_ERR_NO_OPT_LONG:
+            return snprintf(buffer, buffer_size, GET_OPT_MSG_NO_OPT_LONG);
+
+        case GET_OPT_ERR_LONG_LENGTH_EXCEEDED:
+            return snprintf(buffer, buffer_size, GET_OPT_MSG_LONG_LENGTH_EXCEEDED);
+
+        case GET_OPT_ERR_OPT_LONG_ALREADY_EXISTS:
+            return snprintf(buffer, buffer_size, GET_OPT_MSG_OPT_LONG_ALREADY_EXISTS, diag->opt_char, diag->opt_long, diag->opt_detail);
+
+        case GET_OPT_ERR_DETAIL_LENGTH_EXCEEDED:
+            return snprintf(buffer, buffer_size, GET_OPT_MSG_DETAIL_LENGTH_EXCEEDED);
+
+        case GET_OPT_ERR_UNKNOWN_TYPE:
+            return snprintf(buffer, buffer_size, GET_OPT_MSG_UNKNOWN_TYPE, diag->opt_char, diag->opt_long, diag->opt_detail);
+
+        case GET_OPT_ERR_UNKNOWN_ARG_REQ:
+            return snprintf(buffer, buffer_size, GET_OPT_MSG_UNKNOWN_ARG_REQ, diag->opt_char, diag->opt_long, diag->opt_detail);
+
+        case GET_OPT_ERR_WRONG_BOUNDARIES:
+            return snprintf(buffer, buffer_size, GET_OPT_MSG_WRONG_BOUNDARIES, diag->opt_char, diag->opt_long, diag->opt_detail);
+
+        case GET_OPT_ERR_VAL_OUT_OF_BOUNDS:
+        {
+            // Default values are checked at definition time, when no token is being parsed.
+            if(diag->token_offset < 0)
+            {
+                return snprintf(buffer, buffer_size, GET_OPT_MSG_DEF_VAL_OUT_OF_BOUNDS, diag->opt_char, diag->opt_long, diag->opt_detail);
+            }
+
+            return snprintf(buffer, buffer_size, GET_OPT_MSG_PROV_VAL_OUT_OF_BOUNDS, diag->opt_char, diag->opt_long, diag->opt_detail);
+        }
+
+        case GET_OPT_ERR_NULL_DEST_VAR:
+            return snprintf(buffer, buffer_size, GET_OPT_MSG_NULL_DEST_VAR, diag->opt_char, diag->opt_long, diag->opt_detail);
+
+        case GET_OPT_ERR_OPT_NUM_ZERO:
+            return snprintf(buffer, buffer_size, GET_OPT_MSG_OPT_NUM_ZERO);
+
+        case GET_OPT_ERR_NULL_PTR:
+            return snprintf(buffer, buffer_size, GET_OPT_MSG_NULL_PTR);
+
+        case GET_OPT_ERR_NO_ARG_FOUND:
+            return snprintf(buffer, buffer_size, GET_OPT_MSG_NO_ARG_FOUND, diag->opt_char);
+
+        case GET_OPT_ERR_UNKNOWN_OPTION:
+        {
+            // Options found in config files are only known by their long name.
+            if(diag->opt_char == '\0' && diag->opt_long[0] != '\0')
+            {
+                return snprintf(buffer, buffer_size, GET_OPT_MSG_UNKNOWN_OPTION_LONG, diag->opt_long);
+            }
+
+            // Options removed by handle are only known by it.
+            if(diag->opt_char == '\0')
+            {
+                return snprintf(buffer, buffer_size, GET_OPT_MSG_UNKNOWN_OPTION_HANDLE, diag->option_index);
+            }
+
+            return snprintf(buffer, buffer_size, GET_OPT_MSG_UNKNOWN_OPTION, diag->opt_char);
+        }
+
+        case GET_OPT_ERR_CONFIG_FILE:
+            return snprintf(buffer, buffer_size, GET_OPT_MSG_CONFIG_FILE);
+
+        case GET_OPT_ERR_CONFIG_SYNTAX:
+            return snprintf(buffer, buffer_size, GET_OPT_MSG_CONFIG_SYNTAX, diag->token_offset);
+
+        case GET_OPT_ERR_CMDLINE_SYNTAX:
+            return snprintf(buffer, buffer_size, GET_OPT_MSG_CMDLINE_SYNTAX, diag->token_offset);
+
+        case GET_OPT_ERR_STREAM_TOKEN:
+            return snprintf(buffer, buffer_size, GET_OPT_MSG_STREAM_TOKEN, GET_OPT_SIZE_STREAM_TOKEN_MAX, diag->token_offset);
+
+        case GET_OPT_ERR_EXPORT_SIZE:
+            return snprintf(buffer, buffer_size, GET_OPT_MSG_EXPORT_SIZE, diag->token_offset);
+
+        case GET_OPT_ERR_AMBIGUOUS_OPTION:
+            return snprintf(buffer, buffer_size, GET_OPT_MSG_AMBIGUOUS_OPTION, diag->opt_long);
+
+        case GET_OPT_ERR_RELOAD_MODE:
+            return snprintf(buffer, buffer_size, GET_OPT_MSG_RELOAD_MODE);
+
+        case GET_OPT_ERR_READER_SLOTS:
+            return snprintf(buffer, buffer_size, GET_OPT_MSG_READER_SLOTS, GET_OPT_SIZE_READER_SLOTS);
+
+        case GET_OPT_ERR_READ_SECTION:
+            return snprintf(buffer, buffer_size, GET_OPT_MSG_READ_SECTION, diag->opt_long);
+
+        case GET_OPT_ERR_NO_OPT_STORE:
+            return snprintf(buffer, buffer_size, GET_OPT_MSG_NO_OPT_STORE);
+
+        case GET_OPT_ERR_SHARED_MEM:
+            return snprintf(buffer, buffer_size, GET_OPT_MSG_SHARED_MEM);
+
+        case GET_OPT_ERR_SCHEMA_FILE:
+            return snprintf(buffer, buffer_size, GET_OPT_MSG_SCHEMA_FILE);
+
+        case GET_OPT_ERR_REGISTRATION_BATCH:
+            return snprintf(buffer, buffer_size, GET_OPT_MSG_REGISTRATION_BATCH);
+
+        case GET_OPT_ERR_CONSTRAINT_DEF:
+            return snprintf(buffer, buffer_size, GET_OPT_MSG_CONSTRAINT_DEF);
+
+        case GET_OPT_ERR_REQUIRED_OPTION:
+            return snprintf(buffer, buffer_size, GET_OPT_MSG_REQUIRED_OPTION, diag->opt_char, diag->opt_long);
+
+        case GET_OPT_ERR_EXCLUSIVE_OPTIONS:
+            return snprintf(buffer, buffer_size, GET_OPT_MSG_EXCLUSIVE_OPTIONS, diag->opt_char, diag->opt_long);
+
+        case GET_OPT_ERR_DEPENDENT_OPTION:
+            return snprintf(buffer, buffer_size, GET_OPT_MSG_DEPENDENT_OPTION, diag->opt_char, diag->opt_long);
+
+        case GET_OPT_ERR_FLAG_SET:
+            return snprintf(buffer, buffer_size, GET_OPT_MSG_FLAG_SET, diag->opt_char, diag->opt_long);
+
+        case GET_OPT_ERR_FLAG_HEADER:
+            return snprintf(buffer, buffer_size, GET_OPT_MSG_FLAG_HEADER);
+
+        case GET_OPT_ERR_FLAG_MACRO:
+            return snprintf(buffer, buffer_size, GET_OPT_MSG_FLAG_MACRO, diag->opt_char, diag->opt_long);
+
+        case GET_OPT_ERR_CHOICE_DEF:
+            return snprintf(buffer, buffer_size, GET_OPT_MSG_CHOICE_DEF, diag->opt_char, diag->opt_long);
+
+        case GET_OPT_ERR_UNKNOWN_CHOICE:
+            return snprintf(buffer, buffer_size, GET_OPT_MSG_UNKNOWN_CHOICE, diag->opt_char, diag->opt_long);
+
+        case GET_OPT_ERR_STRING_CONSTRAINT_DEF:
+            return snprintf(buffer, buffer_size, GET_OPT_MSG_STRING_CONSTRAINT_DEF, diag->opt_char, diag->opt_long);
+
+        case GET_OPT_ERR_STRING_CONSTRAINT:
+            return snprintf(buffer, buffer_size, GET_OPT_MSG_STRING_CONSTRAINT, diag->opt_char, diag->opt_long);
+
+        case GET_OPT_ERR_CODEC_DEF:
+            return snprintf(buffer, buffer_size, GET_OPT_MSG_CODEC_DEF, GET_OPT_SIZE_CODEC_MAX);
+
+        case GET_OPT_ERR_CODEC_VALUE:
+            return snprintf(buffer, buffer_size, GET_OPT_MSG_CODEC_VALUE, diag->opt_char, diag->opt_long);
+
+        default:
+        break;
+    }
+
+    return snprintf(buffer, buffer_size, GET_OPT_MSG_UNKNOWN_ERROR, diag->code);
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -92,22 +483,151 @@ int CheckExistingOptionChar(char current_opt_char)
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 int CheckExistingOptionLong(char* current_opt_long)
 {
-    for(int i = 0; i < option_number; i++)
+    if(GetOptionIndexFromLong(current_opt_long, strlen(current_opt_long)) >= 0)
+    {
+        return GET_OPT_ERR_OPT_LONG_ALREADY_EXISTS;
+    }
+
+    return GET_OPT_SUCCESS;
+}
+
+/////////////////////////////////////////////////////////////////////
+/// @brief Hashes an option long name (FNV-1a).
+/// @param opt_long Option string, does not need to be NUL-terminated.
+/// @param opt_long_len Option string length.
+/// @return Hash value.
+/////////////////////////////////////////////////////////////////////
+uint32_t GetOptHashLong(char* opt_long, int opt_long_len)
+{
+    uint32_t hash = GET_OPT_HASH_FNV_OFFSET;
+
+    for(int i = 0; i < opt_long_len; i++)
+    {
+        hash ^= (unsigned char)opt_long[i];
+        hash *= GET_OPT_HASH_FNV_PRIME;
+    }
+
+    return hash;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Inserts an already filled option into the long name index (open addressing).
+///        The index is rebuilt whenever it gets half full (tombstones included), with
+///        twice the capacity needed by live options.
+/// @param option_index Index of the option within private_options.
+/// @return GET_OPT_ERR_NULL_PTR if the index could not be allocated, 0 otherwise.
+////////////////////////////////////////////////////////////////////////////////////////////
+int InsertLongNameIndex(int option_index)
+{
+    if(2 * (long_name_index_used + 1) > long_name_index_size)
     {
-        if(strcmp((char*)(private_options[i].pub_opt.opt_long), current_opt_long) == 0)
+        // The option being inserted is not counted yet, neither as a new one nor as a reused slot.
+        int new_size = GET_OPT_SIZE_LONG_INDEX_MIN;
+        while(new_size < 2 * (option_number - removed_option_number + 1))
         {
-            SVRTY_LOG_WNG(GET_OPT_MSG_OPT_LONG_ALREADY_EXISTS,
-                    private_options[i].pub_opt.opt_char,
-                    private_options[i].pub_opt.opt_long,
-                    private_options[i].pub_opt.opt_detail);
+            new_size *= 2;
+        }
 
-            return GET_OPT_ERR_OPT_LONG_ALREADY_EXISTS;
+        int* new_index = (int*)calloc(new_size, sizeof(int));
+
+        if(new_index == NULL)
+        {
+            return GET_OPT_ERR_NULL_PTR;
         }
+
+        FillLongNameIndex(new_index, new_size, option_index);
+    }
+
+    char* opt_long = (char*)private_options[option_index].pub_opt.opt_long;
+    uint32_t slot = GetOptHashLong(opt_long, strlen(opt_long)) & (long_name_index_size - 1);
+
+    while(long_name_index[slot] != 0)
+    {
+        slot = (slot + 1) & (long_name_index_size - 1);
     }
 
+    // Slots store index + 1, so that 0 means empty.
+    long_name_index[slot] = option_index + 1;
+    long_name_index_used++;
+
     return GET_OPT_SUCCESS;
 }
 
+//////////////////////////////////////////////////////////////////////////////////
+/// @brief Replaces the long name index with an empty one, then rehashes every
+///        live option into it. Tombstones are dropped along the way.
+/// @param new_index Zeroed index.
+/// @param new_size Index size (power of two).
+/// @param skip_index Option not to be rehashed (the one being inserted), or -1.
+//////////////////////////////////////////////////////////////////////////////////
+void FillLongNameIndex(int* new_index, int new_size, int skip_index)
+{
+    free(long_name_index);
+    long_name_index = new_index;
+    long_name_index_size = new_size;
+    long_name_index_used = 0;
+
+    for(int i = 0; i < option_number; i++)
+    {
+        if(i != skip_index && !GET_OPT_IS_REMOVED(&private_options[i]))
+        {
+            InsertLongNameIndex(i);
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////////////////
+/// @brief Removes an option from the long name index. Its slot becomes a tombstone,
+///        so that probing goes on past it for the options inserted after it.
+/// @param option_index Index of the option within private_options.
+//////////////////////////////////////////////////////////////////////////////////////
+void RemoveLongNameIndex(int option_index)
+{
+    char* opt_long = (char*)private_options[option_index].pub_opt.opt_long;
+    uint32_t slot = GetOptHashLong(opt_long, strlen(opt_long)) & (long_name_index_size - 1);
+
+    while(long_name_index[slot] != 0)
+    {
+        if(long_name_index[slot] == option_index + 1)
+        {
+            long_name_index[slot] = GET_OPT_INDEX_TOMBSTONE;
+            return;
+        }
+
+        slot = (slot + 1) & (long_name_index_size - 1);
+    }
+}
+
+//////////////////////////////////////////////////////////////////////
+/// @brief Looks for an option by its long name through the index.
+/// @param opt_long Option string, does not need to be NUL-terminated.
+/// @param opt_long_len Option string length.
+/// @return Index of the option within private_options, -1 if not found.
+//////////////////////////////////////////////////////////////////////
+int GetOptionIndexFromLong(char* opt_long, int opt_long_len)
+{
+    if(long_name_index == NULL)
+    {
+        return -1;
+    }
+
+    uint32_t slot = GetOptHashLong(opt_long, opt_long_len) & (long_name_index_size - 1);
+
+    while(long_name_index[slot] != 0)
+    {
+        char* candidate = (long_name_index[slot] == GET_OPT_INDEX_TOMBSTONE ? NULL : (char*)private_options[long_name_index[slot] - 1].pub_opt.opt_long);
+
+        if(candidate != NULL && strncmp(candidate, opt_long, opt_long_len) == 0 && candidate[opt_long_len] == '\0')
+        {
+            return long_name_index[slot] - 1;
+        }
+
+        slot = (slot + 1) & (long_name_index_size - 1);
+    }
+
+    return -1;
+}
+
 //////////////////////////////////////////////////////////////////////////////
 /// @brief Checks if the data type specifier is valid or not.
 /// @param opt_var_type Option variable type.
@@ -115,6 +635,11 @@ int CheckExistingOptionLong(char* current_opt_long)
 //////////////////////////////////////////////////////////////////////////////
 int CheckValidDataType(int opt_var_type)
 {
+    if(GET_OPT_IS_CODEC(opt_var_type))
+    {
+        return GET_OPT_SUCCESS;
+    }
+
     for(int i = GET_OPT_TYPE_MIN; i <= GET_OPT_TYPE_MAX; i++)
     {
         if(opt_var_type == i)
@@ -153,6 +678,18 @@ int CheckOptArgRequirement(int arg_requirement)
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 int CheckOptLowerOrEqual(int opt_var_type, OPT_DATA_TYPE min, OPT_DATA_TYPE max)
 {
+    // Codec values are ordered by the codec itself. Unset boundaries bound nothing.
+    if(GET_OPT_IS_CODEC(opt_var_type))
+    {
+        if(min.custom == NULL || max.custom == NULL)
+            return GET_OPT_SUCCESS;
+
+        if(GET_OPT_CODEC_OF(opt_var_type)->compare == NULL || GET_OPT_CODEC_OF(opt_var_type)->compare(min.custom, max.custom) > 0)
+            return GET_OPT_ERR_WRONG_BOUNDARIES;
+
+        return GET_OPT_SUCCESS;
+    }
+
     switch (opt_var_type)
     {
         case GET_OPT_TYPE_INT:
@@ -223,6 +760,16 @@ int CheckBoundaries(int opt_var_type    ,
                     OPT_DATA_TYPE opt_min_value ,
                     OPT_DATA_TYPE opt_max_value )
 {
+    // String boundaries are only measured here, once, so that values do not have to measure them again.
+    if(opt_var_type == GET_OPT_TYPE_CHAR_STRING)
+    {
+        if( strnlen(opt_min_value.char_string, PATH_MAX + 1) > PATH_MAX ||
+            (opt_max_value.char_string != max_str && strnlen(opt_max_value.char_string, PATH_MAX + 1) > PATH_MAX) )
+        {
+            return GET_OPT_ERR_WRONG_BOUNDARIES;
+        }
+    }
+
     int check_boundaries = CheckOptLowerOrEqual(opt_var_type, opt_min_value, opt_max_value);
 
     if(check_boundaries < 0)
@@ -246,14 +793,20 @@ int CheckValueInRange(  int             opt_var_type    ,
                         OPT_DATA_TYPE   opt_max_value   ,
                         OPT_DATA_TYPE   opt_check_value )
 {
+    // Boundaries have already been measured by CheckBoundaries. Only the value is, and no further than PATH_MAX.
     if(opt_var_type == GET_OPT_TYPE_CHAR_STRING)
     {
-        int check_string_min        = strlen(opt_min_value.char_string  )   > PATH_MAX ? -1 : 0;
-        int check_string_max        = strlen(opt_max_value.char_string  )   > PATH_MAX ? -1 : 0;
-        int check_string_default    = strlen(opt_check_value.char_string)   > PATH_MAX ? -1 : 0;
-
-        if(check_string_min < 0 || check_string_max < 0 || check_string_default < 0)
+        if(strnlen(opt_check_value.char_string, PATH_MAX + 1) > PATH_MAX)
             return GET_OPT_ERR_VAL_OUT_OF_BOUNDS;
+
+        // Unbounded strings share max_str, which no value of at most PATH_MAX bytes can exceed.
+        if(opt_max_value.char_string == max_str)
+            return CheckOptLowerOrEqual(opt_var_type, opt_min_value, opt_check_value) < 0 ? GET_OPT_ERR_VAL_OUT_OF_BOUNDS : GET_OPT_SUCCESS;
+    }
+
+    if(GET_OPT_IS_CODEC(opt_var_type) && opt_check_value.custom == NULL)
+    {
+        return GET_OPT_ERR_VAL_OUT_OF_BOUNDS;
     }
 
     int check_def_val_be_min = CheckOptLowerOrEqual(opt_var_type, opt_min_value, opt_check_value);
@@ -291,24 +844,23 @@ int FillPrivateOptStruct(   char            opt_char            ,
                             OPT_DATA_TYPE   opt_default_value   ,
                             void*           opt_dest_var        )
 {
-    option_number++;
-
-    if(option_number == 0)
-    {
-        return GET_OPT_ERR_OPT_NUM_ZERO;
-    }
+    // Either the option is fully registered, or the registry is left untouched. Slots of removed
+    // options are reused, except within registration batches, which are rolled back by position,
+    // and while an option store is published, as handles to removed options would then read this one.
+    int reuse_slot = (registration_batch_start < 0 && removed_option_number > 0 && atomic_load(&current_snapshot) == NULL);
+    int option_index = option_number;
 
-    if(option_number == 1)
+    if(reuse_slot)
     {
-        private_options = (PRIV_OPT_DEFINITION*)calloc(option_number, sizeof(PRIV_OPT_DEFINITION));
+        option_index = free_option_slots[removed_option_number - 1];
     }
-    else
+    else if(ReserveOptionDefinitions(option_number + 1) < 0)
     {
-        private_options = (PRIV_OPT_DEFINITION*)realloc(private_options, option_number * sizeof(PRIV_OPT_DEFINITION));
+        return GET_OPT_ERR_NULL_PTR;
     }
 
-    int option_index = option_number - 1;
-    
+    memset(&private_options[option_index], 0, sizeof(PRIV_OPT_DEFINITION));
+
     private_options[option_index].pub_opt.opt_char  = opt_char;
     strcpy((char*)(private_options[option_index].pub_opt.opt_long), opt_long);
 
@@ -324,12 +876,49 @@ int FillPrivateOptStruct(   char            opt_char            ,
     private_options[option_index].pub_opt.opt_default_value = opt_default_value ;
     private_options[option_index].pub_opt.opt_dest_var      = opt_dest_var      ;
 
-    private_options[option_index].struct_opt_long.name      = (char*)private_options[option_index].pub_opt.opt_long;
-    private_options[option_index].struct_opt_long.has_arg   = private_options[option_index].pub_opt.opt_needs_arg;
-    private_options[option_index].struct_opt_long.flag      = NULL;
-    private_options[option_index].struct_opt_long.val       = private_options[option_index].pub_opt.opt_char;
+    private_options[option_index].opt_value         = opt_default_value;
+    private_options[option_index].opt_provenance    = GET_OPT_PROV_BIT(GET_OPT_SRC_DEFAULT);
+
+    BindOptionConverter(&private_options[option_index]);
+
+    // Blobs are decoded into the options arena instead, as their size is only known once decoded.
+    if(GET_OPT_IS_CODEC(opt_var_type) && !GET_OPT_IS_BLOB(opt_var_type))
+    {
+        private_options[option_index].opt_codec_values = (char*)calloc(2, GET_OPT_CODEC_OF(opt_var_type)->value_size);
+
+        if(private_options[option_index].opt_codec_values == NULL)
+        {
+            memset(&private_options[option_index], 0, sizeof(PRIV_OPT_DEFINITION));
+            return GET_OPT_ERR_NULL_PTR;
+        }
+    }
+
+    int add_option_dispatch = AddOptionDispatch(option_index);
+    int insert_long_name_index = (add_option_dispatch < 0 ? add_option_dispatch : InsertLongNameIndex(option_index));
+
+    if(insert_long_name_index < 0)
+    {
+        if(add_option_dispatch == GET_OPT_SUCCESS)
+        {
+            RemoveOptionDispatch(option_index);
+        }
+
+        // Back to a tombstone (reused slot) or to unused capacity.
+        free(private_options[option_index].opt_codec_values);
+        memset(&private_options[option_index], 0, sizeof(PRIV_OPT_DEFINITION));
+        return insert_long_name_index;
+    }
+
+    if(reuse_slot)
+    {
+        removed_option_number--;
+    }
+    else
+    {
+        option_number++;
+    }
 
-    private_options[option_index].opt_has_value = false;
+    constraint_mask_words = 0;
 
     return GET_OPT_SUCCESS;
 }
@@ -360,9 +949,8 @@ int SetOptionDefinition(char            opt_char            ,
     // Check if option character exists.
     if(opt_char == '\0')
     {
-        SVRTY_LOG_ERR(GET_OPT_MSG_NO_OPT_CHAR);
-        FreeHeapOptData();
-        return GET_OPT_ERR_NO_OPT_CHAR;
+        REPORT_DEF_ERROR(GET_OPT_ERR_NO_OPT_CHAR);
+        return RejectOptionDefinition(GET_OPT_ERR_NO_OPT_CHAR);
     }
 
     // If the option character is valid, check whether it already exists.
@@ -370,17 +958,15 @@ int SetOptionDefinition(char            opt_char            ,
 
     if(check_existing_option_char < 0)
     {
-        // SeverityLog is called within CheckExistingOptionChar, as long as the data to be shown depends on the private options data.
-        FreeHeapOptData();
-        return check_existing_option_char;
+        REPORT_DEF_ERROR(check_existing_option_char);
+        return RejectOptionDefinition(check_existing_option_char);
     }
 
     // Check if option long string exists.
     if(opt_long == NULL)
     {
-        SVRTY_LOG_ERR(GET_OPT_MSG_NO_OPT_LONG);
-        FreeHeapOptData();
-        return GET_OPT_ERR_NO_OPT_LONG;
+        REPORT_DEF_ERROR(GET_OPT_ERR_NO_OPT_LONG);
+        return RejectOptionDefinition(GET_OPT_ERR_NO_OPT_LONG);
     }
 
     // If option long string exists, then check if its length exceeds the allowed maximum.
@@ -388,9 +974,8 @@ int SetOptionDefinition(char            opt_char            ,
     {
         if(strlen(opt_long) > GET_OPT_SIZE_LONG_MAX)
         {
-            SVRTY_LOG_ERR(GET_OPT_MSG_LONG_LENGTH_EXCEEDED);
-            FreeHeapOptData();
-            return GET_OPT_ERR_LONG_LENGTH_EXCEEDED;
+            REPORT_DEF_ERROR(GET_OPT_ERR_LONG_LENGTH_EXCEEDED);
+            return RejectOptionDefinition(GET_OPT_ERR_LONG_LENGTH_EXCEEDED);
         }
     }
 
@@ -399,13 +984,12 @@ int SetOptionDefinition(char            opt_char            ,
 
     if(check_existing_option_long < 0)
     {
-        // SeverityLog is called within CheckExistingOptionLong, as long as the data to be shown depends on the private options data.
-        FreeHeapOptData();
-        return check_existing_option_long;
+        REPORT_DEF_ERROR(check_existing_option_long);
+        return RejectOptionDefinition(check_existing_option_long);
     }
 
-    // Check if option detail exists.
-    if(opt_detail == NULL)
+    // Check if option detail exists. Warnings are not formatted if the caller handles diagnostics.
+    if(opt_detail == NULL && diag_sink == NULL)
     {
         SVRTY_LOG_WNG(GET_OPT_MSG_NO_OPT_DETAIL   ,
                 opt_char                    ,
@@ -417,9 +1001,8 @@ int SetOptionDefinition(char            opt_char            ,
     {
         if(strlen(opt_detail) > GET_OPT_SIZE_DETAIL_MAX)
         {
-            SVRTY_LOG_ERR(GET_OPT_MSG_DETAIL_LENGTH_EXCEEDED);
-            FreeHeapOptData();
-            return GET_OPT_ERR_DETAIL_LENGTH_EXCEEDED;
+            REPORT_DEF_ERROR(GET_OPT_ERR_DETAIL_LENGTH_EXCEEDED);
+            return RejectOptionDefinition(GET_OPT_ERR_DETAIL_LENGTH_EXCEEDED);
         }
     }
 
@@ -428,12 +1011,8 @@ int SetOptionDefinition(char            opt_char            ,
 
     if(check_valid_data_type < 0)
     {
-        SVRTY_LOG_ERR(GET_OPT_MSG_UNKNOWN_TYPE,
-                opt_char                ,
-                opt_long                ,
-                opt_detail              );
-        FreeHeapOptData();
-        return check_valid_data_type;
+        REPORT_DEF_ERROR(check_valid_data_type);
+        return RejectOptionDefinition(check_valid_data_type);
     }
     
     // Check whether the option requires an argument or not.
@@ -441,12 +1020,8 @@ int SetOptionDefinition(char            opt_char            ,
     
     if(check_opt_arg_requirement < 0)
     {
-        SVRTY_LOG_ERR(GET_OPT_MSG_UNKNOWN_ARG_REQ ,
-                opt_char                    ,
-                opt_long                    ,
-                opt_detail                  );
-        FreeHeapOptData();
-        return check_opt_arg_requirement;
+        REPORT_DEF_ERROR(check_opt_arg_requirement);
+        return RejectOptionDefinition(check_opt_arg_requirement);
     }
 
     // If the current option requires arguments, then:
@@ -457,12 +1032,8 @@ int SetOptionDefinition(char            opt_char            ,
         
         if(check_opt_min_max < 0)
         {
-            SVRTY_LOG_ERR(GET_OPT_MSG_WRONG_BOUNDARIES,
-                    opt_char                    ,
-                    opt_long                    ,
-                    opt_detail                  );
-            FreeHeapOptData();
-            return check_opt_min_max;
+            REPORT_DEF_ERROR(check_opt_min_max);
+            return RejectOptionDefinition(check_opt_min_max);
         }
 
         // Check if default value is within boundaries or not.
@@ -473,24 +1044,16 @@ int SetOptionDefinition(char            opt_char            ,
 
         if(check_default_value < 0)
         {
-            SVRTY_LOG_ERR(GET_OPT_MSG_DEF_VAL_OUT_OF_BOUNDS   ,
-                    opt_char                            ,
-                    opt_long                            ,
-                    opt_detail                          );
-            FreeHeapOptData();
-            return check_default_value;
+            REPORT_DEF_ERROR(check_default_value);
+            return RejectOptionDefinition(check_default_value);
         }
     }
 
     // Check whether the pointer to the target output variable is null or not.
     if(opt_dest_var == NULL)
     {
-        SVRTY_LOG_ERR(GET_OPT_MSG_NULL_DEST_VAR   ,
-                opt_char                    ,
-                opt_long                    ,
-                opt_detail                  );
-        FreeHeapOptData();
-        return GET_OPT_ERR_NULL_DEST_VAR;
+        REPORT_DEF_ERROR(GET_OPT_ERR_NULL_DEST_VAR);
+        return RejectOptionDefinition(GET_OPT_ERR_NULL_DEST_VAR);
     }
 
     // Generate private option definition based on the values received by the current function.
@@ -506,368 +1069,7085 @@ int SetOptionDefinition(char            opt_char            ,
 
     if(fill_private_opt_struct < 0)
     {
-        SVRTY_LOG_ERR(GET_OPT_MSG_OPT_NUM_ZERO);
-        FreeHeapOptData();
-        return fill_private_opt_struct;
+        REPORT_DEF_ERROR(fill_private_opt_struct);
+        return RejectOptionDefinition(fill_private_opt_struct);
     }
 
     return GET_OPT_SUCCESS;
 }
 
-///////////////////////////////////////////////////////////////////////////
-/// @brief Set multiple option definition taking a struct array as input. 
-/// @param pub_opt_def Head of the array which includes option definitions.
-/// @param pub_opt_def_size Array size.
-/// @return < 0 if any error happened, 0 otherwise.
-///////////////////////////////////////////////////////////////////////////
-int GetOptDefFromStruct(PUB_OPT_DEFINITION* pub_opt_def, int pub_opt_def_size)
+/////////////////////////////////////////////////////////////////////////////////////
+/// @brief Handles a rejected option definition. The registry is left untouched, but
+///        if a registration batch is open, the batch is marked as failed.
+/// @param code Error code.
+/// @return The same error code.
+/////////////////////////////////////////////////////////////////////////////////////
+int RejectOptionDefinition(int code)
 {
-    for(int i = 0; i < pub_opt_def_size; i++)
+    if(registration_batch_start >= 0 && registration_batch_result == GET_OPT_SUCCESS)
     {
-        int set_opt_def =   SetOptionDefinition(pub_opt_def[i].opt_char         ,
-                                                (char*)pub_opt_def[i].opt_long  ,
-                                                (char*)pub_opt_def[i].opt_detail,
-                                                pub_opt_def[i].opt_var_type     ,
-                                                pub_opt_def[i].opt_needs_arg    ,
-                                                pub_opt_def[i].opt_min_value    ,
-                                                pub_opt_def[i].opt_max_value    ,
-                                                pub_opt_def[i].opt_default_value,
-                                                pub_opt_def[i].opt_dest_var     );
-        
-        if(set_opt_def < 0)
-        {
+        registration_batch_result = code;
+    }
+
+    return code;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Opens a registration batch: options defined from now on are either all kept (see
+///        CommitOptionsRegistration) or all rolled back, leaving previous options untouched.
+/// @return GET_OPT_ERR_REGISTRATION_BATCH if a batch is already open, 0 otherwise.
+///////////////////////////////////////////////////////////////////////////////////////////////
+int BeginOptionsRegistration(void)
+{
+    if(registration_batch_start >= 0)
+    {
+        ReportOptError(GET_OPT_ERR_REGISTRATION_BATCH, -1, -1, '\0', NULL, NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+        return GET_OPT_ERR_REGISTRATION_BATCH;
+    }
+
+    registration_batch_start = option_number;
+    registration_batch_result = GET_OPT_SUCCESS;
+
+    return GET_OPT_SUCCESS;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Closes the current registration batch. If any definition within it failed,
+///        every option defined within the batch is rolled back.
+/// @return < 0 (first error within the batch) if it was rolled back, 0 otherwise.
+/////////////////////////////////////////////////////////////////////////////////////////
+int CommitOptionsRegistration(void)
+{
+    if(registration_batch_start < 0)
+    {
+        ReportOptError(GET_OPT_ERR_REGISTRATION_BATCH, -1, -1, '\0', NULL, NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+        return GET_OPT_ERR_REGISTRATION_BATCH;
+    }
+
+    int batch_result = registration_batch_result;
+
+    if(batch_result < 0)
+    {
+        RollbackOptionDefinitions(registration_batch_start);
+    }
+
+    registration_batch_start = -1;
+    registration_batch_result = GET_OPT_SUCCESS;
+
+    return batch_result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Closes the current registration batch, rolling back every option
+///        defined within it.
+/// @return GET_OPT_ERR_REGISTRATION_BATCH if no batch is open, 0 otherwise.
+////////////////////////////////////////////////////////////////////////////////
+int AbortOptionsRegistration(void)
+{
+    if(registration_batch_start < 0)
+    {
+        ReportOptError(GET_OPT_ERR_REGISTRATION_BATCH, -1, -1, '\0', NULL, NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+        return GET_OPT_ERR_REGISTRATION_BATCH;
+    }
+
+    RollbackOptionDefinitions(registration_batch_start);
+
+    registration_batch_start = -1;
+    registration_batch_result = GET_OPT_SUCCESS;
+
+    return GET_OPT_SUCCESS;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////
+/// @brief Removes an option, given its long name. The option is left out of following
+///        parsings (or reloads), and its slot is reused by options defined later on.
+/// @param opt_long Option string.
+/// @return < 0 if the option is unknown or a registration batch is open, 0 otherwise.
+///////////////////////////////////////////////////////////////////////////////////////
+int RemoveOptionDefinition(char* opt_long)
+{
+    int option_index = (opt_long == NULL ? -1 : GetOptionIndexFromLong(opt_long, strlen(opt_long)));
+
+    if(option_index < 0)
+    {
+        ReportOptError(GET_OPT_ERR_UNKNOWN_OPTION, -1, -1, '\0', opt_long, NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+        return GET_OPT_ERR_UNKNOWN_OPTION;
+    }
+
+    return RemoveOptionDefinitionByHandle(option_index);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////
+/// @brief Removes an option, given its handle (see GetOptHandle). Handles match option
+///        positions within the registry, which compaction and slot reuse change, so
+///        both are deferred until the option store is freed.
+/// @param opt_handle Option handle.
+/// @return < 0 if the option is unknown or a registration batch is open, 0 otherwise.
+///////////////////////////////////////////////////////////////////////////////////////
+int RemoveOptionDefinitionByHandle(int opt_handle)
+{
+    if(registration_batch_start >= 0)
+    {
+        ReportOptError(GET_OPT_ERR_REGISTRATION_BATCH, -1, -1, '\0', NULL, NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+        return GET_OPT_ERR_REGISTRATION_BATCH;
+    }
+
+    if(opt_handle < 0 || opt_handle >= option_number || GET_OPT_IS_REMOVED(&private_options[opt_handle]))
+    {
+        ReportOptError(GET_OPT_ERR_UNKNOWN_OPTION, opt_handle, -1, '\0', NULL, NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+        return GET_OPT_ERR_UNKNOWN_OPTION;
+    }
+
+    RemoveOptionAt(opt_handle);
+    CompactSparseOptionDefinitions();
+
+    return GET_OPT_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+/// @brief Compacts the registry once most of it is made of tombstones, unless an
+///        option store is published or a registration batch is open.
+////////////////////////////////////////////////////////////////////////////////////
+void CompactSparseOptionDefinitions(void)
+{
+    // Compaction moves options around, which would make handles handed out so far point elsewhere.
+    if( option_number >= GET_OPT_SIZE_COMPACT_MIN          &&
+        2 * removed_option_number > option_number           &&
+        registration_batch_start < 0                        &&
+        atomic_load(&current_snapshot) == NULL              )
+    {
+        CompactOptionDefinitions();
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////
+/// @brief Turns an option into a tombstone: it is taken out of the dispatch tables
+///        and the long name index, its record is zeroed (so it has no option character,
+///        which tells it apart) and its slot is pushed onto the free slot stack. O(1).
+/// @param option_index Index of the option within private_options.
+///////////////////////////////////////////////////////////////////////////////////////
+void RemoveOptionAt(int option_index)
+{
+    RemoveOptionDispatch(option_index);
+    RemoveLongNameIndex(option_index);
+    ReleaseOptFlagBit(&private_options[option_index]);
+
+    free(private_options[option_index].opt_choice);
+    free(private_options[option_index].opt_str_constraint);
+    free(private_options[option_index].opt_codec_values);
+    free(private_options[option_index].opt_codec_owned);
+    memset(&private_options[option_index], 0, sizeof(PRIV_OPT_DEFINITION));
+    free_option_slots[removed_option_number++] = option_index;
+    constraint_mask_words = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+/// @brief Moves live options down over tombstones, then rebuilds the long name
+///        index. Dispatch tables keep their layout, only their names are refreshed.
+///        Nothing changes if the new index can not be allocated.
+////////////////////////////////////////////////////////////////////////////////////
+void CompactOptionDefinitions(void)
+{
+    int live_options = option_number - removed_option_number;
+    int new_size = GET_OPT_SIZE_LONG_INDEX_MIN;
+    while(new_size < 2 * live_options)
+    {
+        new_size *= 2;
+    }
+
+    int* new_index = (int*)calloc(new_size, sizeof(int));
+
+    if(new_index == NULL)
+    {
+        return;
+    }
+
+    int live_index = 0;
+
+    for(int i = 0; i < option_number; i++)
+    {
+        if(GET_OPT_IS_REMOVED(&private_options[i]))
+        {
+            continue;
+        }
+
+        if(i != live_index)
+        {
+            private_options[live_index] = private_options[i];
+        }
+
+        live_index++;
+    }
+
+    option_number = live_index;
+    removed_option_number = 0;
+    constraint_mask_words = 0;
+
+    FillLongNameIndex(new_index, new_size, -1);
+    RefreshOptionDispatchNames();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////
+/// @brief Makes sure there is room for a given number of options, growing the registry
+///        (and the free slot stack along with it) geometrically.
+/// @param required_number Number of options the registry must be able to hold.
+/// @return GET_OPT_ERR_NULL_PTR if the registry could not be grown, 0 otherwise.
+///////////////////////////////////////////////////////////////////////////////////////
+int ReserveOptionDefinitions(int required_number)
+{
+    if(required_number <= private_option_capacity)
+    {
+        return GET_OPT_SUCCESS;
+    }
+
+    int new_capacity = (private_option_capacity == 0 ? GET_OPT_SIZE_LONG_INDEX_MIN : 2 * private_option_capacity);
+    while(new_capacity < required_number)
+    {
+        new_capacity *= 2;
+    }
+
+    PRIV_OPT_DEFINITION* new_private_options = (PRIV_OPT_DEFINITION*)realloc(private_options, new_capacity * sizeof(PRIV_OPT_DEFINITION));
+
+    if(new_private_options == NULL)
+    {
+        return GET_OPT_ERR_NULL_PTR;
+    }
+
+    int registry_moved = (new_private_options != private_options);
+    private_options = new_private_options;
+
+    if(registry_moved)
+    {
+        RefreshOptionDispatchNames();
+    }
+
+    int* new_free_option_slots = (int*)realloc(free_option_slots, new_capacity * sizeof(int));
+
+    if(new_free_option_slots == NULL)
+    {
+        return GET_OPT_ERR_NULL_PTR;
+    }
+
+    free_option_slots = new_free_option_slots;
+
+    uint64_t* new_seen_options = (uint64_t*)realloc(seen_options, GET_OPT_BITSET_WORDS(new_capacity) * sizeof(uint64_t));
+
+    if(new_seen_options == NULL)
+    {
+        return GET_OPT_ERR_NULL_PTR;
+    }
+
+    seen_options = new_seen_options;
+    memset(seen_options + GET_OPT_BITSET_WORDS(private_option_capacity), 0, (GET_OPT_BITSET_WORDS(new_capacity) - GET_OPT_BITSET_WORDS(private_option_capacity)) * sizeof(uint64_t));
+    private_option_capacity = new_capacity;
+
+    return GET_OPT_SUCCESS;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Removes the most recently defined options, from the last one back to first_index.
+///        Undoing linear probing insertions in reverse order restores the long name index
+///        exactly as it was, so only the removed options are touched: O(removed options).
+/// @param first_index Index of the first option to be removed.
+///////////////////////////////////////////////////////////////////////////////////////////////
+void RollbackOptionDefinitions(int first_index)
+{
+    for(int i = option_number - 1; i >= first_index; i--)
+    {
+        char* opt_long = (char*)private_options[i].pub_opt.opt_long;
+        uint32_t slot = GetOptHashLong(opt_long, strlen(opt_long)) & (long_name_index_size - 1);
+
+        while(long_name_index[slot] != 0 && long_name_index[slot] != i + 1)
+        {
+            slot = (slot + 1) & (long_name_index_size - 1);
+        }
+
+        long_name_index[slot] = 0;
+        long_name_index_used--;
+
+        // Batch options were the last ones added to the dispatch tables as well, so nothing is moved.
+        RemoveOptionDispatch(i);
+        ReleaseOptFlagBit(&private_options[i]);
+        free(private_options[i].opt_choice);
+        free(private_options[i].opt_str_constraint);
+        free(private_options[i].opt_codec_values);
+        free(private_options[i].opt_codec_owned);
+    }
+
+    if(first_index < option_number)
+    {
+        option_number = first_index;
+        constraint_mask_words = 0;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////
+/// @brief Set multiple option definition taking a struct array as input. 
+/// @param pub_opt_def Head of the array which includes option definitions.
+/// @param pub_opt_def_size Array size.
+/// @return < 0 if any error happened, 0 otherwise.
+///////////////////////////////////////////////////////////////////////////
+int GetOptDefFromStruct(PUB_OPT_DEFINITION* pub_opt_def, int pub_opt_def_size)
+{
+    // The whole array is registered as a batch, unless the caller already opened one.
+    int own_batch = (registration_batch_start < 0 && BeginOptionsRegistration() == GET_OPT_SUCCESS);
+
+    for(int i = 0; i < pub_opt_def_size; i++)
+    {
+        int set_opt_def =   SetOptionDefinition(pub_opt_def[i].opt_char         ,
+                                                (char*)pub_opt_def[i].opt_long  ,
+                                                (char*)pub_opt_def[i].opt_detail,
+                                                pub_opt_def[i].opt_var_type     ,
+                                                pub_opt_def[i].opt_needs_arg    ,
+                                                pub_opt_def[i].opt_min_value    ,
+                                                pub_opt_def[i].opt_max_value    ,
+                                                pub_opt_def[i].opt_default_value,
+                                                pub_opt_def[i].opt_dest_var     );
+        
+        if(set_opt_def < 0)
+        {
+            if(own_batch)
+            {
+                AbortOptionsRegistration();
+            }
+
             return set_opt_def;
         }
     }
 
+    return (own_batch ? CommitOptionsRegistration() : GET_OPT_SUCCESS);
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Adds an option to the tables getopt_long dispatches on: short_options_string and
+///        the long options table, both kept from one parsing to the next. The option gets
+///        the last cell of each one, and tables grow geometrically. O(1) amortized.
+/// @param option_index Index of the option within private_options.
+/// @return GET_OPT_ERR_NULL_PTR if the tables could not be grown, 0 otherwise.
+//////////////////////////////////////////////////////////////////////////////////////////////
+int AddOptionDispatch(int option_index)
+{
+    ReleaseLongNameTrie();
+
+    if(dispatch_number == dispatch_capacity)
+    {
+        int new_capacity = (dispatch_capacity == 0 ? GET_OPT_SIZE_LONG_INDEX_MIN : 2 * dispatch_capacity);
+
+        char* new_short_options_string = (char*)realloc(short_options_string, 1 + new_capacity * GET_OPT_SIZE_SHORT_OPT_CELL + 1);
+
+        if(new_short_options_string == NULL)
+        {
+            return GET_OPT_ERR_NULL_PTR;
+        }
+
+        short_options_string = new_short_options_string;
+
+        PRIV_OPT_LONG* new_long_options_table = (PRIV_OPT_LONG*)realloc(long_options_table, (GET_OPT_SIZE_VERB_BRIEF + new_capacity + 1) * sizeof(PRIV_OPT_LONG));
+
+        if(new_long_options_table == NULL)
+        {
+            return GET_OPT_ERR_NULL_PTR;
+        }
+
+        long_options_table = new_long_options_table;
+
+        if(dispatch_capacity == 0)
+        {
+            short_options_string[0] = ':';
+            memcpy(&long_options_table[0], &opt_long_verbose, sizeof(PRIV_OPT_LONG));
+            memcpy(&long_options_table[1], &opt_long_brief, sizeof(PRIV_OPT_LONG));
+        }
+
+        dispatch_capacity = new_capacity;
+    }
+
+    PUB_OPT_DEFINITION* pub_opt = &private_options[option_index].pub_opt;
+
+    // Cells have a fixed size, so that they can be moved around. Room left is filled with the option
+    // character itself: getopt only looks at its first occurrence, so "ccc" means "c", and "c:c" means "c:".
+    char* cell = short_options_string + 1 + dispatch_number * GET_OPT_SIZE_SHORT_OPT_CELL;
+    memset(cell, pub_opt->opt_char, GET_OPT_SIZE_SHORT_OPT_CELL);
+
+    if(pub_opt->opt_needs_arg != GET_OPT_ARG_REQ_NO)
+    {
+        cell[1] = ':';
+    }
+
+    if(pub_opt->opt_needs_arg == GET_OPT_ARG_REQ_OPTIONAL)
+    {
+        cell[2] = ':';
+    }
+
+    cell[GET_OPT_SIZE_SHORT_OPT_CELL] = '\0';
+
+    PRIV_OPT_LONG* opt_long_entry = &long_options_table[GET_OPT_SIZE_VERB_BRIEF + dispatch_number];
+
+    opt_long_entry->name    = (char*)pub_opt->opt_long;
+    opt_long_entry->has_arg = pub_opt->opt_needs_arg;
+    opt_long_entry->flag    = NULL;
+    opt_long_entry->val     = pub_opt->opt_char;
+
+    memset(opt_long_entry + 1, 0, sizeof(PRIV_OPT_LONG));
+
+    short_option_index[(unsigned char)pub_opt->opt_char] = option_index + 1;
+    private_options[option_index].opt_dispatch = dispatch_number;
+    dispatch_number++;
+
+    return GET_OPT_SUCCESS;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////
+/// @brief Removes an option from the dispatch tables, moving the last option into its
+///        cells, so that neither table has to be generated again. O(1).
+/// @param option_index Index of the option within private_options.
+///////////////////////////////////////////////////////////////////////////////////////
+void RemoveOptionDispatch(int option_index)
+{
+    ReleaseLongNameTrie();
+
+    int dispatch_slot = private_options[option_index].opt_dispatch;
+    int last_slot = dispatch_number - 1;
+
+    if(dispatch_slot != last_slot)
+    {
+        memcpy( short_options_string + 1 + dispatch_slot * GET_OPT_SIZE_SHORT_OPT_CELL  ,
+                short_options_string + 1 + last_slot * GET_OPT_SIZE_SHORT_OPT_CELL      ,
+                GET_OPT_SIZE_SHORT_OPT_CELL                                             );
+
+        long_options_table[GET_OPT_SIZE_VERB_BRIEF + dispatch_slot] = long_options_table[GET_OPT_SIZE_VERB_BRIEF + last_slot];
+
+        char* moved_opt_long = (char*)long_options_table[GET_OPT_SIZE_VERB_BRIEF + dispatch_slot].name;
+        private_options[GetOptionIndexFromLong(moved_opt_long, strlen(moved_opt_long))].opt_dispatch = dispatch_slot;
+    }
+
+    short_options_string[1 + last_slot * GET_OPT_SIZE_SHORT_OPT_CELL] = '\0';
+    memset(&long_options_table[GET_OPT_SIZE_VERB_BRIEF + last_slot], 0, sizeof(PRIV_OPT_LONG));
+    short_option_index[(unsigned char)private_options[option_index].pub_opt.opt_char] = 0;
+
+    dispatch_number--;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+/// @brief Points long options table names (and option characters) to the registry
+///        again, once options have been moved (registry growth or compaction).
+//////////////////////////////////////////////////////////////////////////////////
+void RefreshOptionDispatchNames(void)
+{
+    // Trie labels point to long names too.
+    ReleaseLongNameTrie();
+
+    for(int i = 0; i < option_number; i++)
+    {
+        if(!GET_OPT_IS_REMOVED(&private_options[i]))
+        {
+            long_options_table[GET_OPT_SIZE_VERB_BRIEF + private_options[i].opt_dispatch].name = (char*)private_options[i].pub_opt.opt_long;
+            short_option_index[(unsigned char)private_options[i].pub_opt.opt_char] = i + 1;
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+/// @brief Frees the long name trie, which is built again once it is needed. Any
+///        change to the long options table must release it.
+//////////////////////////////////////////////////////////////////////////////////
+void ReleaseLongNameTrie(void)
+{
+    free(long_name_trie);
+    long_name_trie = NULL;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Gets the radix trie over the long options table, building it the first time the
+///        schema is used as a whole (parsing, completion), so that it is built once and kept
+///        across reloads. Long names are sorted, then each node takes the prefix shared by
+///        the range of names below it, and children are split by the byte that follows.
+/// @return NULL if it could not be built, long name trie (root first) otherwise.
+////////////////////////////////////////////////////////////////////////////////////////////
+PRIV_OPT_TRIE_NODE* GetLongNameTrie(void)
+{
+    if(long_name_trie != NULL || long_options_table == NULL)
+    {
+        return long_name_trie;
+    }
+
+    int entry_number = GET_OPT_SIZE_VERB_BRIEF + dispatch_number;
+    PRIV_OPT_TRIE_ENTRY* entries = (PRIV_OPT_TRIE_ENTRY*)malloc(entry_number * sizeof(PRIV_OPT_TRIE_ENTRY));
+
+    // Every leaf is a long name, and every other node but the root splits at least two of them.
+    long_name_trie = (PRIV_OPT_TRIE_NODE*)malloc((2 * entry_number + 1) * sizeof(PRIV_OPT_TRIE_NODE));
+
+    if(entries == NULL || long_name_trie == NULL)
+    {
+        free(entries);
+        ReleaseLongNameTrie();
+        return NULL;
+    }
+
+    for(int i = 0; i < entry_number; i++)
+    {
+        entries[i].name         = long_options_table[i].name;
+        entries[i].long_entry   = i;
+        entries[i].option_index = -1;
+    }
+
+    for(int i = 0; i < option_number; i++)
+    {
+        if(!GET_OPT_IS_REMOVED(&private_options[i]))
+        {
+            entries[GET_OPT_SIZE_VERB_BRIEF + private_options[i].opt_dispatch].option_index = i;
+        }
+    }
+
+    qsort(entries, entry_number, sizeof(PRIV_OPT_TRIE_ENTRY), CompareOptTrieEntries);
+
+    uint32_t node_number = GET_OPT_TRIE_ROOT + 1;
+    FillLongNameTrieNode(entries, 0, entry_number, 0, GET_OPT_TRIE_ROOT, &node_number);
+
+    free(entries);
+
+    return long_name_trie;
+}
+
+int CompareOptTrieEntries(const void* entry_a, const void* entry_b)
+{
+    return strcmp(((PRIV_OPT_TRIE_ENTRY*)entry_a)->name, ((PRIV_OPT_TRIE_ENTRY*)entry_b)->name);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Fills a trie node out of a range of sorted long names sharing depth bytes.
+/// @param entries Long names, sorted.
+/// @param first_entry First long name of the range.
+/// @param last_entry End of the range (excluded).
+/// @param depth Bytes shared by the range, already matched by the nodes above.
+/// @param node Node to be filled.
+/// @param node_number Nodes used so far, children being taken from the end.
+/////////////////////////////////////////////////////////////////////////////////////////
+void FillLongNameTrieNode(PRIV_OPT_TRIE_ENTRY* entries, int first_entry, int last_entry, size_t depth, uint32_t node, uint32_t* node_number)
+{
+    PRIV_OPT_TRIE_NODE* trie_node = &long_name_trie[node];
+
+    trie_node->label            = (first_entry < last_entry ? entries[first_entry].name + depth : min_str);
+    trie_node->label_length     = 0;
+    trie_node->child_number     = 0;
+    trie_node->first_child      = *node_number;
+    trie_node->leaf_number      = last_entry - first_entry;
+    trie_node->long_entry       = -1;
+    trie_node->option_index     = -1;
+
+    if(first_entry == last_entry)
+    {
+        return;
+    }
+
+    // Names being sorted, the prefix shared by the first and the last one is shared by the whole range.
+    const char* first_name = entries[first_entry].name;
+    const char* last_name = entries[last_entry - 1].name;
+    size_t shared_length = depth;
+
+    while(first_name[shared_length] != '\0' && first_name[shared_length] == last_name[shared_length])
+    {
+        shared_length++;
+    }
+
+    trie_node->label_length = shared_length - depth;
+
+    // A name ending here comes first, as a prefix sorts before the names it is a prefix of.
+    if(first_name[shared_length] == '\0')
+    {
+        trie_node->long_entry   = entries[first_entry].long_entry;
+        trie_node->option_index = entries[first_entry].option_index;
+        first_entry++;
+    }
+
+    for(int i = first_entry; i < last_entry; i++)
+    {
+        if(i == first_entry || entries[i].name[shared_length] != entries[i - 1].name[shared_length])
+        {
+            trie_node->child_number++;
+        }
+    }
+
+    *node_number += trie_node->child_number;
+
+    uint32_t child = trie_node->first_child;
+    int group_start = first_entry;
+
+    for(int i = first_entry + 1; i <= last_entry; i++)
+    {
+        if(i == last_entry || entries[i].name[shared_length] != entries[group_start].name[shared_length])
+        {
+            FillLongNameTrieNode(entries, group_start, i, shared_length, child++, node_number);
+            group_start = i;
+        }
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Looks a long name (or a prefix of it) up in the long name trie, in O(length):
+///        each byte is compared once, and children are binary searched by their first
+///        byte. The trie must have been built (GetLongNameTrie).
+/// @param opt_long Long name, not necessarily NUL-terminated.
+/// @param opt_long_length Long name length.
+/// @return Match found: exact, unique prefix, ambiguous prefix, or none at all.
+/////////////////////////////////////////////////////////////////////////////////////////
+PRIV_OPT_TRIE_MATCH FindLongNameTrie(const char* opt_long, size_t opt_long_length)
+{
+    PRIV_OPT_TRIE_MATCH match = {GET_OPT_TRIE_MATCH_NONE, GET_OPT_TRIE_ROOT, 0};
+    uint32_t node = GET_OPT_TRIE_ROOT;
+
+    while(true)
+    {
+        PRIV_OPT_TRIE_NODE* trie_node = &long_name_trie[node];
+        size_t label_index = 0;
+
+        while(  label_index < trie_node->label_length               &&
+                match.matched_length < opt_long_length              &&
+                trie_node->label[label_index] == opt_long[match.matched_length])
+        {
+            label_index++;
+            match.matched_length++;
+        }
+
+        // Names below a label matched partway are still the closest ones.
+        match.node = node;
+
+        if(match.matched_length == opt_long_length)
+        {
+            if(label_index == trie_node->label_length && trie_node->long_entry >= 0)
+            {
+                match.match_type = GET_OPT_TRIE_MATCH_EXACT;
+            }
+            else if(trie_node->leaf_number > 0)
+            {
+                match.match_type = (trie_node->leaf_number == 1 ? GET_OPT_TRIE_MATCH_PREFIX : GET_OPT_TRIE_MATCH_AMBIGUOUS);
+            }
+
+            return match;
+        }
+
+        if(label_index < trie_node->label_length)
+        {
+            return match;
+        }
+
+        // Binary search over children, by the first byte of their label.
+        unsigned char next_byte = opt_long[match.matched_length];
+        uint32_t low = trie_node->first_child;
+        uint32_t high = trie_node->first_child + trie_node->child_number;
+
+        while(low < high)
+        {
+            uint32_t middle = low + (high - low) / 2;
+
+            if((unsigned char)long_name_trie[middle].label[0] < next_byte)
+            {
+                low = middle + 1;
+            }
+            else
+            {
+                high = middle;
+            }
+        }
+
+        if(low == trie_node->first_child + trie_node->child_number || (unsigned char)long_name_trie[low].label[0] != next_byte)
+        {
+            return match;
+        }
+
+        node = low;
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+/// @brief Gets the node of the only long name below a node (i.e. matched
+///        by a unique prefix): it is down a chain of single children.
+/// @param node Node with a single long name at or below it.
+/// @return Node where the long name ends.
+//////////////////////////////////////////////////////////////////////////
+uint32_t GetLongNameTrieLeaf(uint32_t node)
+{
+    while(long_name_trie[node].long_entry < 0)
+    {
+        node = long_name_trie[node].first_child;
+    }
+
+    return node;
+}
+
+/////////////////////////////////////////////////////////////////////////////////
+/// @brief Collects the long names at or below a node, in lexicographic order.
+/// @param node Trie node.
+/// @param names Where to store long names.
+/// @param name_max Maximum number of long names to store.
+/// @param name_number Long names stored so far.
+/// @return Long names stored so far, this node's ones included.
+/////////////////////////////////////////////////////////////////////////////////
+int CollectLongNameTrie(uint32_t node, char** names, int name_max, int name_number)
+{
+    PRIV_OPT_TRIE_NODE* trie_node = &long_name_trie[node];
+
+    if(trie_node->long_entry >= 0 && name_number < name_max)
+    {
+        names[name_number++] = (char*)long_options_table[trie_node->long_entry].name;
+    }
+
+    for(uint32_t child = 0; child < trie_node->child_number && name_number < name_max; child++)
+    {
+        name_number = CollectLongNameTrie(trie_node->first_child + child, names, name_max, name_number);
+    }
+
+    return name_number;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Resolves a long name given on the command line (or a control message), which may
+///        be abbreviated as long as only one long name starts with it. Unknown and ambiguous
+///        ones are reported, along with the closest long names.
+/// @param opt_long Long name, not necessarily NUL-terminated.
+/// @param opt_long_length Long name length.
+/// @param token_offset Index of the token within argv (or byte within the message).
+/// @return < 0 if any error happened, trie node where the long name ends otherwise.
+/////////////////////////////////////////////////////////////////////////////////////////////
+int ResolveOptionLong(char* opt_long, size_t opt_long_length, int token_offset)
+{
+    if(GetLongNameTrie() == NULL)
+    {
+        ReportOptError(GET_OPT_ERR_NULL_PTR, -1, -1, '\0', NULL, NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+        return GET_OPT_ERR_NULL_PTR;
+    }
+
+    PRIV_OPT_TRIE_MATCH match = FindLongNameTrie(opt_long, opt_long_length);
+
+    if(match.match_type == GET_OPT_TRIE_MATCH_EXACT || match.match_type == GET_OPT_TRIE_MATCH_PREFIX)
+    {
+        return (int)GetLongNameTrieLeaf(match.node);
+    }
+
+    char reported_long[GET_OPT_SIZE_LONG_MAX + 1];
+    size_t reported_length = (opt_long_length < GET_OPT_SIZE_LONG_MAX ? opt_long_length : GET_OPT_SIZE_LONG_MAX);
+    int code = (match.match_type == GET_OPT_TRIE_MATCH_AMBIGUOUS ? GET_OPT_ERR_AMBIGUOUS_OPTION : GET_OPT_ERR_UNKNOWN_OPTION);
+
+    memcpy(reported_long, opt_long, reported_length);
+    reported_long[reported_length] = '\0';
+    ReportOptError(code, -1, token_offset, '\0', reported_long, NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+
+    // Suggestions only go along with logged errors.
+    if(diag_sink == NULL && match.matched_length > 0)
+    {
+        char* suggestions[GET_OPT_SIZE_SUGGESTION_MAX];
+        int suggestion_number = CollectLongNameTrie(match.node, suggestions, GET_OPT_SIZE_SUGGESTION_MAX, 0);
+
+        for(int i = 0; i < suggestion_number; i++)
+        {
+            SVRTY_LOG_INF(GET_OPT_MSG_DID_YOU_MEAN, suggestions[i]);
+        }
+    }
+
+    return code;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Resolves the long option getopt_long is about to parse, if any, through the long
+///        name trie, so that getopt_long is given a table holding that option only, instead
+///        of comparing the token to every long name. The next option token is found the way
+///        getopt_long does: from optind on, skipping non-options unless argv is not permuted.
+/// @param argc Argument count.
+/// @param argv Argument character string array.
+/// @param permute false if getopt_long stops at the first non-option (POSIXLY_CORRECT).
+/// @param call_opt_long Where to store the long options table getopt_long must be given.
+/// @param long_option_match Table holding the resolved long option (and its terminator).
+/// @return < 0 if any error happened, 0 otherwise.
+/////////////////////////////////////////////////////////////////////////////////////////////
+int ResolveArgvLongOption(int argc, char** argv, bool permute, PRIV_OPT_LONG** call_opt_long, PRIV_OPT_LONG* long_option_match)
+{
+    int arg_index = (optind == 0 ? 1 : optind);
+
+    while(permute && arg_index < argc && !GET_OPT_IS_ARGV_OPTION(argv[arg_index]))
+    {
+        arg_index++;
+    }
+
+    *call_opt_long = long_options_table;
+
+    // Short option clusters and the end of options are left to getopt_long.
+    if( arg_index >= argc                               ||
+        strncmp(argv[arg_index], GET_OPT_ARGV_END, 2)   ||
+        argv[arg_index][2] == '\0'                      )
+    {
+        return GET_OPT_SUCCESS;
+    }
+
+    char* opt_long = argv[arg_index] + 2;
+    int node = ResolveOptionLong(opt_long, strcspn(opt_long, "="), arg_index);
+
+    if(node < 0)
+    {
+        return node;
+    }
+
+    long_option_match[0] = long_options_table[long_name_trie[node].long_entry];
+    memset(&long_option_match[1], 0, sizeof(PRIV_OPT_LONG));
+    *call_opt_long = long_option_match;
+
+    return GET_OPT_SUCCESS;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Completes a long option name, in O(prefix length) plus the names returned.
+/// @param prefix Long name prefix, without dashes.
+/// @param completions Where to store up to completion_max long names.
+/// @param completion_max Maximum number of long names to store.
+/// @return < 0 if any error happened, number of long names starting with prefix otherwise.
+/////////////////////////////////////////////////////////////////////////////////////////////
+int CompleteOptionLong(char* prefix, char** completions, int completion_max)
+{
+    if(prefix == NULL || (completions == NULL && completion_max > 0) || GetLongNameTrie() == NULL)
+    {
+        ReportOptError(GET_OPT_ERR_NULL_PTR, -1, -1, '\0', NULL, NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+        return GET_OPT_ERR_NULL_PTR;
+    }
+
+    PRIV_OPT_TRIE_MATCH match = FindLongNameTrie(prefix, strlen(prefix));
+
+    if(match.match_type == GET_OPT_TRIE_MATCH_NONE)
+    {
+        return 0;
+    }
+
+    CollectLongNameTrie(match.node, completions, completion_max, 0);
+
+    return (int)long_name_trie[match.node].leaf_number;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Gets the long names sharing the longest prefix with a mistyped one.
+/// @param opt_long Long name (up to any '=').
+/// @param suggestions Where to store up to suggestion_max long names.
+/// @param suggestion_max Maximum number of long names to store.
+/// @return < 0 if any error happened, number of suggested long names otherwise.
+/////////////////////////////////////////////////////////////////////////////////////////////
+int SuggestOptionLong(char* opt_long, char** suggestions, int suggestion_max)
+{
+    if(opt_long == NULL || (suggestions == NULL && suggestion_max > 0) || GetLongNameTrie() == NULL)
+    {
+        ReportOptError(GET_OPT_ERR_NULL_PTR, -1, -1, '\0', NULL, NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+        return GET_OPT_ERR_NULL_PTR;
+    }
+
+    PRIV_OPT_TRIE_MATCH match = FindLongNameTrie(opt_long, strcspn(opt_long, "="));
+
+    if(match.match_type == GET_OPT_TRIE_MATCH_EXACT || match.match_type == GET_OPT_TRIE_MATCH_PREFIX)
+    {
+        match.node = GetLongNameTrieLeaf(match.node);
+    }
+    else if(match.matched_length == 0)
+    {
+        return 0;
+    }
+
+    CollectLongNameTrie(match.node, suggestions, suggestion_max, 0);
+
+    return (match.match_type == GET_OPT_TRIE_MATCH_EXACT || match.match_type == GET_OPT_TRIE_MATCH_PREFIX ? 1 : (int)long_name_trie[match.node].leaf_number);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Binds an option to the convert + range check + store routine matching its type
+///        and settings, so that applying a value takes a single indirect call. It must be
+///        called again whenever any of those settings (choices, constraints) changes.
+/// @param priv_opt_def Private option definition.
+////////////////////////////////////////////////////////////////////////////////////////////
+void BindOptionConverter(PRIV_OPT_DEFINITION* priv_opt_def)
+{
+    static const PRIV_OPT_CONVERTER type_converters[GET_OPT_TYPE_MAX + 1] =
+    {
+        [GET_OPT_TYPE_INT]          = ConvertOptInt     ,
+        [GET_OPT_TYPE_CHAR]         = ConvertOptChar    ,
+        [GET_OPT_TYPE_FLOAT]        = ConvertOptFloat   ,
+        [GET_OPT_TYPE_DOUBLE]       = ConvertOptDouble  ,
+        [GET_OPT_TYPE_CHAR_STRING]  = ConvertOptString  ,
+    };
+
+    if(priv_opt_def->pub_opt.opt_needs_arg == GET_OPT_ARG_REQ_NO)
+    {
+        priv_opt_def->opt_convert = ConvertOptBool;
+    }
+    else if(priv_opt_def->opt_choice != NULL)
+    {
+        priv_opt_def->opt_convert = ConvertOptChoice;
+    }
+    else if(priv_opt_def->opt_str_mode != GET_OPT_STR_MODE_COPY)
+    {
+        priv_opt_def->opt_convert = ConvertOptStringRef;
+    }
+    else if(priv_opt_def->opt_str_constraint != NULL)
+    {
+        priv_opt_def->opt_convert = ConvertOptConstrainedString;
+    }
+    else if(GET_OPT_IS_BLOB(priv_opt_def->pub_opt.opt_var_type))
+    {
+        priv_opt_def->opt_convert = ConvertOptBlob;
+    }
+    else if(GET_OPT_IS_CODEC(priv_opt_def->pub_opt.opt_var_type))
+    {
+        priv_opt_def->opt_convert = ConvertOptCodec;
+    }
+    else
+    {
+        priv_opt_def->opt_convert = type_converters[priv_opt_def->pub_opt.opt_var_type];
+    }
+}
+
+//////////////////////////////////////////////////////////////////
+/// @brief Boolean options: set by their mere presence, unless a
+///        value is explicitly given (i.e. config files).
+//////////////////////////////////////////////////////////////////
+int ConvertOptBool(PRIV_OPT_DEFINITION* priv_opt_def, char* arg, OPT_DATA_TYPE* value)
+{
+    (void)priv_opt_def;
+
+    value->integer = (arg == NULL ? 1 : GetOptParseBool(arg));
+
+    return GET_OPT_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////////////
+/// @brief Integer options.
+//////////////////////////////////////////////////////////////////
+int ConvertOptInt(PRIV_OPT_DEFINITION* priv_opt_def, char* arg, OPT_DATA_TYPE* value)
+{
+    int converted = atoi(arg);
+
+    if( converted < priv_opt_def->pub_opt.opt_min_value.integer ||
+        converted > priv_opt_def->pub_opt.opt_max_value.integer )
+    {
+        return GET_OPT_ERR_VAL_OUT_OF_BOUNDS;
+    }
+
+    value->integer = converted;
+
+    return GET_OPT_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////////////
+/// @brief Choice options: converted straight into their index,
+///        which is always within boundaries.
+//////////////////////////////////////////////////////////////////
+int ConvertOptChoice(PRIV_OPT_DEFINITION* priv_opt_def, char* arg, OPT_DATA_TYPE* value)
+{
+    int converted = GetOptChoiceIndex(priv_opt_def->opt_choice, arg);
+
+    if(converted < 0)
+    {
+        return GET_OPT_ERR_UNKNOWN_CHOICE;
+    }
+
+    value->integer = converted;
+
+    return GET_OPT_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////////////
+/// @brief Character options (given as numbers).
+//////////////////////////////////////////////////////////////////
+int ConvertOptChar(PRIV_OPT_DEFINITION* priv_opt_def, char* arg, OPT_DATA_TYPE* value)
+{
+    if(diag_sink == NULL && arg[0] != '\0' && arg[1] != '\0')
+    {
+        SVRTY_LOG_WNG(GET_OPT_MSG_STRING_NOT_CHAR     ,
+                priv_opt_def->pub_opt.opt_char  ,
+                priv_opt_def->pub_opt.opt_long  ,
+                priv_opt_def->pub_opt.opt_detail);
+    }
+
+    char converted = (char)atoi(arg);
+
+    if( converted < priv_opt_def->pub_opt.opt_min_value.character ||
+        converted > priv_opt_def->pub_opt.opt_max_value.character )
+    {
+        return GET_OPT_ERR_VAL_OUT_OF_BOUNDS;
+    }
+
+    value->character = converted;
+
+    return GET_OPT_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////////////
+/// @brief Float options.
+//////////////////////////////////////////////////////////////////
+int ConvertOptFloat(PRIV_OPT_DEFINITION* priv_opt_def, char* arg, OPT_DATA_TYPE* value)
+{
+    float converted = atof(arg);
+
+    if( converted < priv_opt_def->pub_opt.opt_min_value.floating ||
+        converted > priv_opt_def->pub_opt.opt_max_value.floating )
+    {
+        return GET_OPT_ERR_VAL_OUT_OF_BOUNDS;
+    }
+
+    value->floating = converted;
+
+    return GET_OPT_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////////////
+/// @brief Double options.
+//////////////////////////////////////////////////////////////////
+int ConvertOptDouble(PRIV_OPT_DEFINITION* priv_opt_def, char* arg, OPT_DATA_TYPE* value)
+{
+    double converted = strtod(arg, NULL);
+
+    if( converted < priv_opt_def->pub_opt.opt_min_value.doubling ||
+        converted > priv_opt_def->pub_opt.opt_max_value.doubling )
+    {
+        return GET_OPT_ERR_VAL_OUT_OF_BOUNDS;
+    }
+
+    value->doubling = converted;
+
+    return GET_OPT_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////////////
+/// @brief String options: the argument itself is stored.
+//////////////////////////////////////////////////////////////////
+int ConvertOptString(PRIV_OPT_DEFINITION* priv_opt_def, char* arg, OPT_DATA_TYPE* value)
+{
+    int check_value_in_range = CheckValueInRange(   GET_OPT_TYPE_CHAR_STRING                ,
+                                                    priv_opt_def->pub_opt.opt_min_value    ,
+                                                    priv_opt_def->pub_opt.opt_max_value    ,
+                                                    (OPT_DATA_TYPE){.char_string = arg}     );
+
+    if(check_value_in_range < 0)
+    {
+        return check_value_in_range;
+    }
+
+    value->char_string = arg;
+
+    return GET_OPT_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////////////
+/// @brief String options with a string constraint. The value is
+///        compared to its boundaries within the constraint pass,
+///        so it is only read once.
+//////////////////////////////////////////////////////////////////
+int ConvertOptConstrainedString(PRIV_OPT_DEFINITION* priv_opt_def, char* arg, OPT_DATA_TYPE* value)
+{
+    PRIV_OPT_STR_CONSTRAINT* constraint = priv_opt_def->opt_str_constraint;
+    unsigned char* min_value = (unsigned char*)priv_opt_def->pub_opt.opt_min_value.char_string;
+    unsigned char* max_value = (unsigned char*)priv_opt_def->pub_opt.opt_max_value.char_string;
+
+    // Sign of strcmp(arg, boundary), known as soon as both strings differ.
+    int min_order = 0;
+    int max_order = 0;
+    size_t i;
+
+    for(i = 0; arg[i] != '\0'; i++)
+    {
+        unsigned char c = arg[i];
+
+        if( i >= constraint->max_length                                     ||
+            !GET_OPT_BITSET_TEST(constraint->charset, c)                    ||
+            (i < constraint->prefix_length && arg[i] != constraint->prefix[i])  )
+        {
+            return GET_OPT_ERR_STRING_CONSTRAINT;
+        }
+
+        if(i >= PATH_MAX)
+        {
+            return GET_OPT_ERR_VAL_OUT_OF_BOUNDS;
+        }
+
+        if(min_order == 0)
+        {
+            min_order = (c > min_value[i]) - (c < min_value[i]);
+        }
+
+        if(max_order == 0)
+        {
+            max_order = (c > max_value[i]) - (c < max_value[i]);
+        }
+    }
+
+    if(i < constraint->min_length || i < constraint->prefix_length)
+    {
+        return GET_OPT_ERR_STRING_CONSTRAINT;
+    }
+
+    // A value which is a prefix of a boundary sorts before it.
+    min_order = (min_order == 0 ? -(min_value[i] != '\0') : min_order);
+    max_order = (max_order == 0 ? -(max_value[i] != '\0') : max_order);
+
+    // Unbounded strings share max_str, which no value of at most PATH_MAX bytes can exceed.
+    if(min_order < 0 || (max_order > 0 && (char*)max_value != max_str))
+    {
+        return GET_OPT_ERR_VAL_OUT_OF_BOUNDS;
+    }
+
+    value->char_string = arg;
+
+    return GET_OPT_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////////////
+/// @brief Reference strings: only measured as far as their own
+///        maximum length (if any), never copied while staged.
+//////////////////////////////////////////////////////////////////
+int ConvertOptStringRef(PRIV_OPT_DEFINITION* priv_opt_def, char* arg, OPT_DATA_TYPE* value)
+{
+    size_t max_length = priv_opt_def->opt_str_max_length;
+
+    if(max_length != 0 && strnlen(arg, max_length + 1) > max_length)
+    {
+        return GET_OPT_ERR_VAL_OUT_OF_BOUNDS;
+    }
+
+    if(priv_opt_def->opt_str_constraint != NULL)
+    {
+        int check_string_constraint = CheckStringConstraint(priv_opt_def->opt_str_constraint, arg);
+
+        if(check_string_constraint < 0)
+        {
+            return check_string_constraint;
+        }
+    }
+
+    value->char_string = arg;
+
+    return GET_OPT_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////////////
+/// @brief Codec options: parsed into whichever value slot is not
+///        staged, so that a wrong value leaves the staged one as is.
+//////////////////////////////////////////////////////////////////
+int ConvertOptCodec(PRIV_OPT_DEFINITION* priv_opt_def, char* arg, OPT_DATA_TYPE* value)
+{
+    int var_type = priv_opt_def->pub_opt.opt_var_type;
+    size_t value_size = GET_OPT_CODEC_OF(var_type)->value_size;
+    char* converted = priv_opt_def->opt_codec_values;
+
+    if(value->custom == converted)
+    {
+        converted += value_size;
+    }
+
+    if(GET_OPT_CODEC_OF(var_type)->parse(arg, converted) < 0)
+    {
+        return GET_OPT_ERR_CODEC_VALUE;
+    }
+
+    int check_value_in_range = CheckValueInRange(   var_type                                ,
+                                                    priv_opt_def->pub_opt.opt_min_value    ,
+                                                    priv_opt_def->pub_opt.opt_max_value    ,
+                                                    (OPT_DATA_TYPE){.custom = converted}    );
+
+    if(check_value_in_range < 0)
+    {
+        return check_value_in_range;
+    }
+
+    value->custom = converted;
+
+    return GET_OPT_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////
+/// @brief Assign value to the destination variable.
+/// @param priv_opt_def Private option definition, where the target variable is found.
+/// @param src Variable which stores the value to set.
+//////////////////////////////////////////////////////////////////////////////////////
+void AssignValue(PRIV_OPT_DEFINITION* priv_opt_def, OPT_DATA_TYPE src)
+{
+    // Options loaded from a schema file may not be bound to any variable (values are kept in the option store).
+    if(priv_opt_def->pub_opt.opt_dest_var == NULL)
+    {
+        return;
+    }
+
+    switch(priv_opt_def->pub_opt.opt_var_type)
+    {
+        case GET_OPT_TYPE_INT:
+        {
+            // Flag options only own a bit of the word they point to.
+            if(priv_opt_def->opt_flag_mask != 0)
+            {
+                uint64_t* flag_word = (uint64_t*)(priv_opt_def->pub_opt.opt_dest_var);
+                *flag_word = (src.integer == 0 ? (*flag_word & ~priv_opt_def->opt_flag_mask) : (*flag_word | priv_opt_def->opt_flag_mask));
+                break;
+            }
+
+            // If no argument is required with an integer data type option, then it should be a boolean type option.
+            if(priv_opt_def->pub_opt.opt_needs_arg == GET_OPT_ARG_REQ_NO)
+            {
+                *(bool*)(priv_opt_def->pub_opt.opt_dest_var) = (src.integer == 0 ? false : true);
+                break;
+            }
+
+            *(int*)(priv_opt_def->pub_opt.opt_dest_var) = src.integer;
+        }
+        break;
+
+        case GET_OPT_TYPE_CHAR:
+        {
+            *(char*)(priv_opt_def->pub_opt.opt_dest_var) = src.character;
+        }
+        break;
+
+        case GET_OPT_TYPE_FLOAT:
+        {
+            *(float*)(priv_opt_def->pub_opt.opt_dest_var) = src.floating;
+        }
+        break;
+
+        case GET_OPT_TYPE_DOUBLE:
+        {
+            *(double*)(priv_opt_def->pub_opt.opt_dest_var) = src.doubling;
+        }
+        break;
+
+        case GET_OPT_TYPE_CHAR_STRING:
+        {
+            // Reference strings have already been pinned (see PinOptionValue), so they are only pointed to.
+            if(priv_opt_def->opt_str_mode != GET_OPT_STR_MODE_COPY)
+            {
+                *(char**)(priv_opt_def->pub_opt.opt_dest_var) = src.char_string;
+                break;
+            }
+
+            strcpy((char*)(priv_opt_def->pub_opt.opt_dest_var), src.char_string);
+        }
+        break;
+
+        case GET_OPT_TYPE_BLOB_HEX:
+        case GET_OPT_TYPE_BLOB_BASE64:
+        {
+            // Blobs are not copied: destinations point to the decoded bytes.
+            ((GET_OPT_BLOB*)(priv_opt_def->pub_opt.opt_dest_var))->data     = ((PRIV_OPT_BLOB_VALUE*)src.custom)->data;
+            ((GET_OPT_BLOB*)(priv_opt_def->pub_opt.opt_dest_var))->length   = ((PRIV_OPT_BLOB_VALUE*)src.custom)->length;
+        }
+        break;
+
+        default:
+        {
+            if(GET_OPT_IS_CODEC(priv_opt_def->pub_opt.opt_var_type))
+            {
+                memcpy(priv_opt_def->pub_opt.opt_dest_var, src.custom, GET_OPT_CODEC_OF(priv_opt_def->pub_opt.opt_var_type)->value_size);
+            }
+        }
+        break;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Converts, checks and stages a value for an option, regardless of where it came from.
+/// @param option_index Index of the option within private_options.
+/// @param arg Argument to be casted. NULL if none was provided.
+/// @param token_offset Index of the token within argv (byte offset for config files).
+/// @param source Where the value comes from (OPT_VALUE_SOURCE). Higher values take precedence.
+/// @return GET_OPT_ERR_VAL_OUT_OF_BOUNDS if the value is out of bounds, 0 otherwise.
+////////////////////////////////////////////////////////////////////////////////////////////////
+int ApplyOptionValue(int option_index, char* arg, int token_offset, int source)
+{
+    PRIV_OPT_DEFINITION* priv_opt_def = &private_options[option_index];
+
+    // Any source but the default one counts as the option being given, as far as constraints are concerned.
+    GET_OPT_BITSET_SET(seen_options, option_index);
+
+    // Values coming from lower precedence sources are recorded, but not even converted.
+    if(source < GET_OPT_PROV_WINNER(priv_opt_def->opt_provenance))
+    {
+        priv_opt_def->opt_provenance |= GET_OPT_PROV_BIT(source);
+        return GET_OPT_SUCCESS;
+    }
+
+    // Options with optional arguments keep their default value if none has been provided.
+    // The source is still recorded, as the option has been given, and it overrides lower ones.
+    if(arg == NULL && priv_opt_def->pub_opt.opt_needs_arg != GET_OPT_ARG_REQ_NO)
+    {
+        priv_opt_def->opt_value = priv_opt_def->pub_opt.opt_default_value;
+        priv_opt_def->opt_provenance |= GET_OPT_PROV_BIT(source);
+        return GET_OPT_SUCCESS;
+    }
+
+    // The value is only staged if fine. Destinations are only written once every source has been parsed.
+    int convert_option_value = priv_opt_def->opt_convert(priv_opt_def, arg, &priv_opt_def->opt_value);
+
+    if(convert_option_value < 0)
+    {
+        ReportOptErrorFromDef(convert_option_value, option_index, token_offset);
+        return convert_option_value;
+    }
+
+    priv_opt_def->opt_provenance |= GET_OPT_PROV_BIT(source);
+
+    return GET_OPT_SUCCESS;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Makes the staged value of a reference string outlive parsing, right before it is
+///        assigned: it is copied into the options arena at its exact length, unless it is a
+///        view whose storage already does (argv, environment or default value). Config file
+///        values point to mappings which are unmapped once parsing is over.
+/// @param priv_opt_def Private option definition.
+/// @return GET_OPT_ERR_NULL_PTR if the value could not be copied, 0 otherwise.
+/////////////////////////////////////////////////////////////////////////////////////////////
+int PinOptionValue(PRIV_OPT_DEFINITION* priv_opt_def)
+{
+    if( priv_opt_def->opt_str_mode == GET_OPT_STR_MODE_COPY                                 ||
+        (   priv_opt_def->opt_str_mode == GET_OPT_STR_MODE_VIEW                             &&
+            GET_OPT_PROV_WINNER(priv_opt_def->opt_provenance) != GET_OPT_SRC_CONFIG_FILE    ))
+    {
+        return GET_OPT_SUCCESS;
+    }
+
+    size_t value_size = strlen(priv_opt_def->opt_value.char_string) + 1;
+    char* pinned_value = (char*)GetOptArenaAlloc(value_size);
+
+    if(pinned_value == NULL)
+    {
+        return GET_OPT_ERR_NULL_PTR;
+    }
+
+    priv_opt_def->opt_value.char_string = memcpy(pinned_value, priv_opt_def->opt_value.char_string, value_size);
+
+    return GET_OPT_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////////////
+/// @brief Gets the value of a boolean option written as text.
+/// @param arg Argument ("true", "yes", "on", "false", "no", ...).
+/// @return 1 if the argument means true, 0 otherwise.
+//////////////////////////////////////////////////////////////////
+int GetOptParseBool(char* arg)
+{
+    if( strcmp(arg, GET_OPT_BOOL_STR_TRUE   ) == 0 ||
+        strcmp(arg, GET_OPT_BOOL_STR_YES    ) == 0 ||
+        strcmp(arg, GET_OPT_BOOL_STR_ON     ) == 0 )
+    {
+        return 1;
+    }
+
+    if( strcmp(arg, GET_OPT_BOOL_STR_FALSE  ) == 0 ||
+        strcmp(arg, GET_OPT_BOOL_STR_NO     ) == 0 ||
+        strcmp(arg, GET_OPT_BOOL_STR_OFF    ) == 0 )
+    {
+        return 0;
+    }
+
+    return (atoi(arg) != 0);
+}
+
+////////////////////////////////////////////////////////
+/// @brief Parses given options and arguments if needed.
+/// @param argc Argument count.
+/// @param argv Argument character string array.
+/// @return < 0 if any error happened, 0 otherwise.
+////////////////////////////////////////////////////////
+int ParseOptions(int argc, char** argv)
+{
+    // Dispatch tables are kept up to date as options are defined and removed.
+    if(private_options == NULL || short_options_string == NULL)
+    {
+        ReportOptError(GET_OPT_ERR_NULL_PTR, -1, -1, '\0', NULL, NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+        FreeHeapOptData();
+        return GET_OPT_ERR_NULL_PTR;
+    }
+
+    // If a cache file matching the current schema and inputs exists, values are taken from it instead.
+    uint64_t cache_key = GetOptionsCacheKey(argc, argv);
+
+    if(cache_file_path[0] != '\0' && ApplyOptionsCache(cache_key) == GET_OPT_SUCCESS)
+    {
+        ShowOptions();
+        int retain_provenance = RetainOptionsProvenance();
+        return FinishParseOptions(argc, argv, retain_provenance, 1);
+    }
+
+    memset(seen_options, 0, GET_OPT_BITSET_WORDS(option_number) * sizeof(uint64_t));
+
+    // Config files and environment variables are applied before argv, which takes precedence anyway.
+    int apply_config_files = ApplyConfigFiles();
+
+    if(apply_config_files < 0)
+    {
+        FreeHeapOptData();
+        return apply_config_files;
+    }
+
+    int apply_environment_options = ApplyEnvironmentOptions();
+
+    if(apply_environment_options < 0)
+    {
+        FreeHeapOptData();
+        return apply_environment_options;
+    }
+
+    int parse_argv_options = ParseArgvOptions(argc, argv, long_options_table);
+
+    if(parse_argv_options < 0)
+    {
+        FreeHeapOptData();
+        return parse_argv_options;
+    }
+
+    int check_options_constraints = CheckOptionsConstraints();
+
+    if(check_options_constraints < 0)
+    {
+        FreeHeapOptData();
+        return check_options_constraints;
+    }
+
+    // Single merge pass: each destination is written exactly once, with the value coming from the
+    // highest precedence source (staged by ApplyOptionValue), or the default value otherwise.
+    int retain_provenance = RetainOptionsProvenance();
+
+    for(int option_to_set_index = 0; option_to_set_index < option_number; option_to_set_index++)
+    {
+        if(PinOptionValue(&private_options[option_to_set_index]) < 0)
+        {
+            ReportOptError(GET_OPT_ERR_NULL_PTR, -1, -1, '\0', NULL, NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+            FreeHeapOptData();
+            return GET_OPT_ERR_NULL_PTR;
+        }
+
+        AssignValue(&private_options[option_to_set_index], private_options[option_to_set_index].opt_value);
+    }
+
+    if(cache_file_path[0] != '\0')
+    {
+        // A cache that can't be written only means the next start will parse everything again.
+        SaveOptionsCache(cache_key);
+    }
+
+    ShowOptions();
+
+    return FinishParseOptions(argc, argv, retain_provenance, 0);
+}
+
+//////////////////////////////////////////////////////////////////////
+/// @brief Parses options given as a single command line string.
+/// @param cmdline Command line string (tokenized in place).
+/// @return < 0 if any error happened, 0 otherwise.
+//////////////////////////////////////////////////////////////////////
+int ParseOptionsFromString(char* cmdline)
+{
+    if(cmdline == NULL)
+    {
+        ReportOptError(GET_OPT_ERR_NULL_PTR, -1, -1, '\0', NULL, NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+        FreeHeapOptData();
+        return GET_OPT_ERR_NULL_PTR;
+    }
+
+    size_t tokens_size;
+    int token_number = TokenizeOptionsCmdline(cmdline, &tokens_size);
+
+    if(token_number < 0)
+    {
+        FreeHeapOptData();
+        return token_number;
+    }
+
+    return ParseOptionsTokens(cmdline, token_number);
+}
+
+//////////////////////////////////////////////////////////////////////
+/// @brief Parses options given as NUL-terminated arguments laid out
+///        one after another (/proc/<pid>/cmdline).
+/// @param cmdline NUL-separated arguments.
+/// @param cmdline_size Size of cmdline, every terminator included.
+/// @return < 0 if any error happened, 0 otherwise.
+//////////////////////////////////////////////////////////////////////
+int ParseOptionsFromCmdline(char* cmdline, size_t cmdline_size)
+{
+    if(cmdline == NULL && cmdline_size > 0)
+    {
+        ReportOptError(GET_OPT_ERR_NULL_PTR, -1, -1, '\0', NULL, NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+        FreeHeapOptData();
+        return GET_OPT_ERR_NULL_PTR;
+    }
+
+    // Arguments are used in place, so the last one must be terminated within the given size.
+    if(cmdline_size > 0 && cmdline[cmdline_size - 1] != '\0')
+    {
+        ReportOptError(GET_OPT_ERR_CMDLINE_SYNTAX, -1, (int)(cmdline_size - 1), '\0', NULL, NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+        FreeHeapOptData();
+        return GET_OPT_ERR_CMDLINE_SYNTAX;
+    }
+
+    int token_number = 0;
+    char* token = cmdline;
+
+    while(token < cmdline + cmdline_size)
+    {
+        token = (char*)memchr(token, '\0', cmdline + cmdline_size - token) + 1;
+        token_number++;
+    }
+
+    return ParseOptionsTokens(cmdline, token_number);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Tokenizes a command line string in place, as a shell would: tokens are split
+///        by blanks, single quotes keep everything literal, double quotes only let a
+///        backslash escape GET_OPT_CMD_DQ_ESCAPABLE characters, and a backslash escapes
+///        any character otherwise (backslash-newline pairs are removed). Tokens are left
+///        one after another, NUL-terminated, at the beginning of cmdline.
+/// @param cmdline Command line string.
+/// @param tokens_size Size of the resulting tokens, terminators included.
+/// @return GET_OPT_ERR_CMDLINE_SYNTAX if a quote or escape is not terminated, the
+///         number of tokens otherwise.
+////////////////////////////////////////////////////////////////////////////////////////
+int TokenizeOptionsCmdline(char* cmdline, size_t* tokens_size)
+{
+    // Tokens never get longer once quotes and escapes are removed, so they are written behind the read position.
+    char* read = cmdline;
+    char* write = cmdline;
+    int token_number = 0;
+
+    while(*read != '\0')
+    {
+        if(GET_OPT_CMD_IS_BLANK(*read) || (read[0] == GET_OPT_CMD_ESCAPE && read[1] == '\n'))
+        {
+            read += (GET_OPT_CMD_IS_BLANK(*read) ? 1 : 2);
+            continue;
+        }
+
+        while(*read != '\0' && !GET_OPT_CMD_IS_BLANK(*read))
+        {
+            char* syntax_error = NULL;
+
+            if(*read == GET_OPT_CMD_QUOTE_SINGLE)
+            {
+                char* closing_quote = strchr(read + 1, GET_OPT_CMD_QUOTE_SINGLE);
+
+                if(closing_quote == NULL)
+                {
+                    syntax_error = read;
+                }
+                else
+                {
+                    memmove(write, read + 1, closing_quote - read - 1);
+                    write += closing_quote - read - 1;
+                    read = closing_quote + 1;
+                }
+            }
+            else if(*read == GET_OPT_CMD_QUOTE_DOUBLE)
+            {
+                char* opening_quote = read++;
+
+                while(*read != GET_OPT_CMD_QUOTE_DOUBLE && *read != '\0')
+                {
+                    if(read[0] == GET_OPT_CMD_ESCAPE && read[1] != '\0' && strchr(GET_OPT_CMD_DQ_ESCAPABLE, read[1]) != NULL)
+                    {
+                        read++;
+
+                        if(*read == '\n')
+                        {
+                            read++;
+                            continue;
+                        }
+                    }
+
+                    *write++ = *read++;
+                }
+
+                if(*read == '\0')
+                {
+                    syntax_error = opening_quote;
+                }
+                else
+                {
+                    read++;
+                }
+            }
+            else if(*read == GET_OPT_CMD_ESCAPE)
+            {
+                if(read[1] == '\0')
+                {
+                    syntax_error = read;
+                }
+                else
+                {
+                    if(read[1] != '\n')
+                    {
+                        *write++ = read[1];
+                    }
+
+                    read += 2;
+                }
+            }
+            else
+            {
+                *write++ = *read++;
+            }
+
+            if(syntax_error != NULL)
+            {
+                ReportOptError(GET_OPT_ERR_CMDLINE_SYNTAX, -1, (int)(syntax_error - cmdline), '\0', NULL, NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+                return GET_OPT_ERR_CMDLINE_SYNTAX;
+            }
+        }
+
+        // The separator is consumed before its position may be taken by the terminator.
+        if(*read != '\0')
+        {
+            read++;
+        }
+
+        *write++ = '\0';
+        token_number++;
+    }
+
+    *tokens_size = write - cmdline;
+
+    return token_number;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Parses NUL-terminated tokens laid out one after another. Tokens are not copied:
+///        getopt_long only needs an argument vector pointing to them, which is kept in the
+///        options arena, so that it outlives parsing in reload mode.
+/// @param tokens First token.
+/// @param token_number Number of tokens.
+/// @return < 0 if any error happened, 0 otherwise.
+///////////////////////////////////////////////////////////////////////////////////////////
+int ParseOptionsTokens(char* tokens, int token_number)
+{
+    char** token_view = (char**)GetOptArenaAlloc((token_number + 1) * sizeof(char*));
+
+    if(token_view == NULL)
+    {
+        ReportOptError(GET_OPT_ERR_NULL_PTR, -1, -1, '\0', NULL, NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+        FreeHeapOptData();
+        return GET_OPT_ERR_NULL_PTR;
+    }
+
+    char* token = tokens;
+
+    for(int token_index = 0; token_index < token_number; token_index++)
+    {
+        token_view[token_index] = token;
+        token += strlen(token) + 1;
+    }
+
+    token_view[token_number] = NULL;
+
+    return ParseOptions(token_number, token_view);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Publishes the values resolved so far as a snapshot (the retained option store),
+///        then frees private option data, unless reload mode is enabled, in which case the
+///        schema and argv are kept so that options can be parsed again later on.
+/// @param argc Argument count.
+/// @param argv Argument character string array.
+/// @param parse_result Result of parsing so far.
+/// @param snapshot_published 1 if the snapshot has already been published (cache hit).
+/// @return < 0 if any error happened, parse_result otherwise.
+/////////////////////////////////////////////////////////////////////////////////////////
+int FinishParseOptions(int argc, char** argv, int parse_result, int snapshot_published)
+{
+    if(parse_result < 0)
+    {
+        FreeHeapOptData();
+        return parse_result;
+    }
+
+    if(!snapshot_published)
+    {
+        size_t image_size;
+        char* snapshot = BuildOptionsImage(++snapshot_generation, &image_size);
+
+        if(snapshot == NULL)
+        {
+            ReportOptError(GET_OPT_ERR_NULL_PTR, -1, -1, '\0', NULL, NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+            FreeHeapOptData();
+            return GET_OPT_ERR_NULL_PTR;
+        }
+
+        PublishOptionsSnapshot(snapshot);
+    }
+
+    if(!reload_mode)
+    {
+        FreeHeapOptData();
+        return parse_result;
+    }
+
+    retained_argc = argc;
+    retained_argv = argv;
+
+    return parse_result;
+}
+
+////////////////////////////////////////////////////////////////////////////
+/// @brief Stages the values given through argv. Private data is not freed
+///        on error, so that it can be used by both ParseOptions and reloads.
+/// @param argc Argument count.
+/// @param argv Argument character string array.
+/// @param priv_opt_long Long options array (long_options_table).
+/// @return < 0 if any error happened, 0 otherwise.
+////////////////////////////////////////////////////////////////////////////
+int ParseArgvOptions(int argc, char** argv, PRIV_OPT_LONG* priv_opt_long)
+{
+    int current_option;
+    int current_option_index = 0;
+    PRIV_OPT_LONG long_option_match[2];
+    bool permute = (getenv("POSIXLY_CORRECT") == NULL);
+
+    while(true)
+    {
+        // Long options are resolved through the long name trie, so getopt_long is only given the one matched.
+        PRIV_OPT_LONG* call_opt_long = priv_opt_long;
+        int resolve_argv_long_option = (priv_opt_long == long_options_table ? ResolveArgvLongOption(argc, argv, permute, &call_opt_long, long_option_match) : GET_OPT_SUCCESS);
+
+        if(resolve_argv_long_option < 0)
+        {
+            return resolve_argv_long_option;
+        }
+
+        current_option = getopt_long(argc, argv, short_options_string, call_opt_long, &current_option_index);
+
+        if(current_option == -1)
+        {
+            break;
+        }
+
+        switch (current_option)
+        {
+            // Option sets a flag.
+            case 0:
+            {
+                if(verbose_flag == 0)
+                {
+                    SetSeverityLogMask(SVRTY_LOG_MASK_OFF);
+                }
+                else
+                {
+                    SetSeverityLogMask(SVRTY_LOG_MASK_ALL);
+                }
+            }
+            break;
+
+            // Missing option argument.
+            case ':':
+            {
+                ReportOptError(GET_OPT_ERR_NO_ARG_FOUND, -1, optind - 1, optopt, NULL, NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+                return GET_OPT_ERR_NO_ARG_FOUND;
+            }
+            break;
+
+            // Invalid option.
+            case '?':
+            {
+                ReportOptError(GET_OPT_ERR_UNKNOWN_OPTION, -1, optind - 1, optopt, NULL, NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+                return GET_OPT_ERR_UNKNOWN_OPTION;
+            }
+            break;
+
+            default:
+            {
+                // Short and long options both return the option character, which indexes the registry directly.
+                int option_index = short_option_index[(unsigned char)current_option] - 1;
+
+                if(option_index < 0)
+                {
+                    ReportOptError(GET_OPT_ERR_UNKNOWN_OPTION, -1, optind - 1, current_option, NULL, NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+                    return GET_OPT_ERR_UNKNOWN_OPTION;
+                }
+
+                // Boolean options take no argument, so optarg is not meaningful for them.
+                char* current_arg = (private_options[option_index].pub_opt.opt_needs_arg == GET_OPT_ARG_REQ_NO ? NULL : optarg);
+
+                int apply_option_value = ApplyOptionValue(option_index, current_arg, optind - 1, GET_OPT_SRC_ARGV);
+
+                if(apply_option_value < 0)
+                {
+                    return apply_option_value;
+                }
+            }
+            break;
+        }
+    }
+
+    return GET_OPT_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Set choice option definition: its value must be one of the given strings,
+///        and the index of the matching one is stored (i.e. with {"fast", "safe"},
+///        "--mode safe" stores 1). Values that are not choices are reported as errors.
+/// @param opt_char Option character.
+/// @param opt_long Option string.
+/// @param opt_detail Option details.
+/// @param choices Allowed strings.
+/// @param choice_number Number of allowed strings.
+/// @param opt_default_value Index of the default choice.
+/// @param opt_dest_var Address to the variable meant to be set after parsing.
+/// @return < 0 if any error happened, 0 otherwise.
+////////////////////////////////////////////////////////////////////////////////////////
+int SetOptionDefinitionChoice(  char    opt_char            ,
+                                char*   opt_long            ,
+                                char*   opt_detail          ,
+                                char**  choices             ,
+                                int     choice_number       ,
+                                int     opt_default_value   ,
+                                int*    opt_dest_var        )
+{
+    PRIV_OPT_CHOICE* choice = BuildOptionChoice(choices, choice_number);
+
+    if(choice == NULL)
+    {
+        ReportOptError(GET_OPT_ERR_CHOICE_DEF, -1, -1, opt_char, opt_long, opt_detail, GET_OPT_TYPE_INT, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+        return RejectOptionDefinition(GET_OPT_ERR_CHOICE_DEF);
+    }
+
+    // Choices are integer options ranging over choice indices.
+    int set_option_definition = SetOptionDefinition(opt_char                                        ,
+                                                    opt_long                                        ,
+                                                    opt_detail                                      ,
+                                                    GET_OPT_TYPE_INT                                ,
+                                                    GET_OPT_ARG_REQ_REQUIRED                        ,
+                                                    (OPT_DATA_TYPE){.integer = 0}                   ,
+                                                    (OPT_DATA_TYPE){.integer = choice_number - 1}   ,
+                                                    (OPT_DATA_TYPE){.integer = opt_default_value}   ,
+                                                    opt_dest_var                                    );
+
+    if(set_option_definition < 0)
+    {
+        free(choice);
+        return set_option_definition;
+    }
+
+    PRIV_OPT_DEFINITION* priv_opt_def = &private_options[GetOptionIndexFromLong(opt_long, strlen(opt_long))];
+
+    priv_opt_def->opt_choice = choice;
+    BindOptionConverter(priv_opt_def);
+
+    return GET_OPT_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Builds a perfect hash over a choice list: seeds (then table sizes) are tried
+///        until every choice gets a slot of its own, so that looking a value up takes
+///        a single hash and a single string comparison. Everything lives in one block.
+/// @param choices Allowed strings.
+/// @param choice_number Number of allowed strings.
+/// @return Heap-allocated choice table, NULL if the list is wrong.
+////////////////////////////////////////////////////////////////////////////////////////
+PRIV_OPT_CHOICE* BuildOptionChoice(char** choices, int choice_number)
+{
+    if(choices == NULL || choice_number <= 0)
+    {
+        return NULL;
+    }
+
+    size_t strings_size = 0;
+
+    for(int i = 0; i < choice_number; i++)
+    {
+        if(choices[i] == NULL)
+        {
+            return NULL;
+        }
+
+        // Repeated choices could never get slots of their own.
+        for(int j = 0; j < i; j++)
+        {
+            if(strcmp(choices[i], choices[j]) == 0)
+            {
+                return NULL;
+            }
+        }
+
+        strings_size += strlen(choices[i]) + 1;
+    }
+
+    for(uint32_t table_size = 2; table_size <= GET_OPT_SIZE_CHOICE_TABLE_MAX; table_size *= 2)
+    {
+        if(table_size < 2 * (uint32_t)choice_number)
+        {
+            continue;
+        }
+
+        PRIV_OPT_CHOICE* choice = (PRIV_OPT_CHOICE*)calloc(1, sizeof(PRIV_OPT_CHOICE) + table_size * sizeof(int) + choice_number * sizeof(char*) + strings_size);
+
+        if(choice == NULL)
+        {
+            return NULL;
+        }
+
+        choice->choice_number   = choice_number;
+        choice->table_mask      = table_size - 1;
+        choice->table           = (int*)(choice + 1);
+        choice->choices         = (char**)(choice->table + table_size);
+
+        char* strings = (char*)(choice->choices + choice_number);
+
+        for(int i = 0; i < choice_number; i++)
+        {
+            choice->choices[i] = strcpy(strings, choices[i]);
+            strings += strlen(choices[i]) + 1;
+        }
+
+        for(uint32_t seed = 0; seed < GET_OPT_CHOICE_SEED_TRIES; seed++)
+        {
+            int i;
+            memset(choice->table, 0, table_size * sizeof(int));
+
+            for(i = 0; i < choice_number; i++)
+            {
+                uint32_t slot = GetOptHashSeeded(seed, choices[i]) & choice->table_mask;
+
+                if(choice->table[slot] != 0)
+                {
+                    break;
+                }
+
+                choice->table[slot] = i + 1;
+            }
+
+            if(i == choice_number)
+            {
+                choice->hash_seed = seed;
+                return choice;
+            }
+        }
+
+        free(choice);
+    }
+
+    return NULL;
+}
+
+///////////////////////////////////////////////////////////////////
+/// @brief Hashes a string (FNV-1a), starting from a given seed.
+/// @param seed Seed mixed into the initial hash value.
+/// @param string NUL-terminated string.
+/// @return Hash value.
+///////////////////////////////////////////////////////////////////
+uint32_t GetOptHashSeeded(uint32_t seed, char* string)
+{
+    uint32_t hash = GET_OPT_HASH_FNV_OFFSET ^ (seed * GET_OPT_HASH_FNV_PRIME);
+
+    for(int i = 0; string[i] != '\0'; i++)
+    {
+        hash ^= (unsigned char)string[i];
+        hash *= GET_OPT_HASH_FNV_PRIME;
+    }
+
+    return hash;
+}
+
+//////////////////////////////////////////////////////////////////////
+/// @brief Looks a value up among the choices of an option.
+/// @param choice Choice table.
+/// @param arg Value.
+/// @return Index of the matching choice, -1 if the value is unknown.
+//////////////////////////////////////////////////////////////////////
+int GetOptChoiceIndex(PRIV_OPT_CHOICE* choice, char* arg)
+{
+    int slot = choice->table[GetOptHashSeeded(choice->hash_seed, arg) & choice->table_mask];
+
+    if(slot == 0 || strcmp(choice->choices[slot - 1], arg) != 0)
+    {
+        return -1;
+    }
+
+    return slot - 1;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Registers a user-defined option type. Its values are parsed, bounds-checked
+///        (compare) and shown (format) through the codec callbacks. Types are numbered
+///        in registration order, so processes sharing schema files or option stores
+///        must register the same codecs in the same order.
+/// @param codec Codec (copied). parse is mandatory, and value_size must not be 0.
+/// @return < 0 if any error happened, type to define options with otherwise.
+//////////////////////////////////////////////////////////////////////////////////////////
+int RegisterOptionCodec(GET_OPT_CODEC* codec)
+{
+    if(codec == NULL || codec->parse == NULL || codec->value_size == 0 || codec_number == GET_OPT_SIZE_CODEC_MAX)
+    {
+        ReportOptError(GET_OPT_ERR_CODEC_DEF, -1, -1, '\0', NULL, NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+        return GET_OPT_ERR_CODEC_DEF;
+    }
+
+    option_codecs[codec_number] = *codec;
+
+    return GET_OPT_TYPE_CODEC_MIN + codec_number++;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Set network endpoint option definition. Values are parsed without any name lookup
+///        straight into the destination: "1.2.3.4:80" (IPv4), "[::1]:80" (IPv6) or
+///        "unix:/run/app.sock" (Unix domain socket, which has no port to be bounded).
+/// @param opt_char Option character.
+/// @param opt_long Option string.
+/// @param opt_detail Option details.
+/// @param min_port Minimum port.
+/// @param max_port Maximum port.
+/// @param opt_default_value Default endpoint, NULL for none (AF_UNSPEC).
+/// @param opt_dest_var Address to the variable meant to be set after parsing.
+/// @return < 0 if any error happened, 0 otherwise.
+//////////////////////////////////////////////////////////////////////////////////////////////
+int SetOptionDefinitionEndpoint(char                        opt_char            ,
+                                char*                       opt_long            ,
+                                char*                       opt_detail          ,
+                                int                         min_port            ,
+                                int                         max_port            ,
+                                char*                       opt_default_value   ,
+                                struct sockaddr_storage*    opt_dest_var        )
+{
+    // Ports out of range are rejected rather than clamped, since they would never bound anything.
+    if(min_port < 0 || max_port > GET_OPT_ENDPOINT_PORT_MAX || min_port > max_port)
+    {
+        ReportOptError(GET_OPT_ERR_WRONG_BOUNDARIES, -1, -1, opt_char, opt_long, opt_detail, GET_OPT_TYPE_ENDPOINT, (OPT_DATA_TYPE){.integer = min_port}, (OPT_DATA_TYPE){.integer = max_port});
+        return RejectOptionDefinition(GET_OPT_ERR_WRONG_BOUNDARIES);
+    }
+
+    // Boundaries and default value: only the port of the boundaries matters.
+    struct sockaddr_storage* endpoints = (struct sockaddr_storage*)calloc(3, sizeof(struct sockaddr_storage));
+
+    if(endpoints == NULL)
+    {
+        ReportOptError(GET_OPT_ERR_NULL_PTR, -1, -1, '\0', NULL, NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+        return RejectOptionDefinition(GET_OPT_ERR_NULL_PTR);
+    }
+
+    endpoints[0].ss_family = AF_INET;
+    endpoints[1].ss_family = AF_INET;
+    ((struct sockaddr_in*)&endpoints[0])->sin_port = htons(min_port);
+    ((struct sockaddr_in*)&endpoints[1])->sin_port = htons(max_port);
+
+    if(opt_default_value != NULL && ParseOptEndpoint(opt_default_value, &endpoints[2]) < 0)
+    {
+        free(endpoints);
+        ReportOptError(GET_OPT_ERR_CODEC_VALUE, -1, -1, opt_char, opt_long, opt_detail, GET_OPT_TYPE_ENDPOINT, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+        return RejectOptionDefinition(GET_OPT_ERR_CODEC_VALUE);
+    }
+
+    int set_option_definition = SetOptionDefinition(opt_char                                    ,
+                                                    opt_long                                    ,
+                                                    opt_detail                                  ,
+                                                    GET_OPT_TYPE_ENDPOINT                       ,
+                                                    GET_OPT_ARG_REQ_REQUIRED                    ,
+                                                    (OPT_DATA_TYPE){.custom = &endpoints[0]}    ,
+                                                    (OPT_DATA_TYPE){.custom = &endpoints[1]}    ,
+                                                    (OPT_DATA_TYPE){.custom = &endpoints[2]}    ,
+                                                    opt_dest_var                                );
+
+    if(set_option_definition < 0)
+    {
+        free(endpoints);
+        return set_option_definition;
+    }
+
+    private_options[GetOptionIndexFromLong(opt_long, strlen(opt_long))].opt_codec_owned = endpoints;
+
+    return GET_OPT_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Parses a network endpoint ("1.2.3.4:80", "[::1]:80", "unix:/path").
+/// @param arg Endpoint.
+/// @param value Destination (struct sockaddr_storage).
+/// @return GET_OPT_ERR_CODEC_VALUE if the endpoint is not valid, 0 otherwise.
+////////////////////////////////////////////////////////////////////////////////
+int ParseOptEndpoint(char* arg, void* value)
+{
+    struct sockaddr_storage* endpoint = (struct sockaddr_storage*)value;
+    char address[INET6_ADDRSTRLEN];
+
+    memset(endpoint, 0, sizeof(struct sockaddr_storage));
+
+    if(strncmp(arg, GET_OPT_ENDPOINT_UNIX_PREFIX, strlen(GET_OPT_ENDPOINT_UNIX_PREFIX)) == 0)
+    {
+        struct sockaddr_un* unix_endpoint = (struct sockaddr_un*)endpoint;
+        char* path = arg + strlen(GET_OPT_ENDPOINT_UNIX_PREFIX);
+        size_t path_len = strlen(path);
+
+        if(path_len == 0 || path_len >= sizeof(unix_endpoint->sun_path))
+        {
+            return GET_OPT_ERR_CODEC_VALUE;
+        }
+
+        unix_endpoint->sun_family = AF_UNIX;
+        memcpy(unix_endpoint->sun_path, path, path_len + 1);
+
+        return GET_OPT_SUCCESS;
+    }
+
+    // IPv6 addresses are bracketed, as they contain ':' themselves.
+    int family = (arg[0] == '[' ? AF_INET6 : AF_INET);
+    char* address_start = arg + (family == AF_INET6);
+    char* address_end = (family == AF_INET6 ? strchr(address_start, ']') : strrchr(address_start, ':'));
+
+    if( address_end == NULL                                             ||
+        address_end - address_start >= (ptrdiff_t)sizeof(address)      ||
+        (family == AF_INET6 && address_end[1] != ':')                   )
+    {
+        return GET_OPT_ERR_CODEC_VALUE;
+    }
+
+    char* port_start = address_end + (family == AF_INET6 ? 2 : 1);
+    int port = 0;
+
+    for(int i = 0; port_start[i] != '\0'; i++)
+    {
+        if(i == 5 || port_start[i] < '0' || port_start[i] > '9')
+        {
+            return GET_OPT_ERR_CODEC_VALUE;
+        }
+
+        port = 10 * port + (port_start[i] - '0');
+    }
+
+    if(port_start[0] == '\0' || port > GET_OPT_ENDPOINT_PORT_MAX)
+    {
+        return GET_OPT_ERR_CODEC_VALUE;
+    }
+
+    memcpy(address, address_start, address_end - address_start);
+    address[address_end - address_start] = '\0';
+
+    if(family == AF_INET6)
+    {
+        struct sockaddr_in6* ipv6_endpoint = (struct sockaddr_in6*)endpoint;
+        ipv6_endpoint->sin6_family  = AF_INET6;
+        ipv6_endpoint->sin6_port    = htons(port);
+
+        return (inet_pton(AF_INET6, address, &ipv6_endpoint->sin6_addr) == 1 ? GET_OPT_SUCCESS : GET_OPT_ERR_CODEC_VALUE);
+    }
+
+    struct sockaddr_in* ipv4_endpoint = (struct sockaddr_in*)endpoint;
+    ipv4_endpoint->sin_family   = AF_INET;
+    ipv4_endpoint->sin_port     = htons(port);
+
+    return (inet_pton(AF_INET, address, &ipv4_endpoint->sin_addr) == 1 ? GET_OPT_SUCCESS : GET_OPT_ERR_CODEC_VALUE);
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+/// @brief Compares two network endpoints by port, which is what boundaries are
+///        about. Endpoints without a port (Unix sockets) are within any range.
+/// @param value_a First endpoint.
+/// @param value_b Second endpoint.
+/// @return < 0, 0, > 0 if the first port is lower, the same or greater.
+//////////////////////////////////////////////////////////////////////////////////
+int CompareOptEndpoint(void* value_a, void* value_b)
+{
+    int port_a = GetOptEndpointPort((struct sockaddr_storage*)value_a);
+    int port_b = GetOptEndpointPort((struct sockaddr_storage*)value_b);
+
+    if(port_a < 0 || port_b < 0)
+    {
+        return 0;
+    }
+
+    return port_a - port_b;
+}
+
+//////////////////////////////////////////////////////////////////////
+/// @brief Gets the port of a network endpoint.
+/// @param endpoint Endpoint.
+/// @return -1 if the endpoint has no port, port otherwise.
+//////////////////////////////////////////////////////////////////////
+int GetOptEndpointPort(struct sockaddr_storage* endpoint)
+{
+    switch(endpoint->ss_family)
+    {
+        case AF_INET:
+            return ntohs(((struct sockaddr_in*)endpoint)->sin_port);
+
+        case AF_INET6:
+            return ntohs(((struct sockaddr_in6*)endpoint)->sin6_port);
+
+        default:
+        break;
+    }
+
+    return -1;
+}
+
+//////////////////////////////////////////////////////////////////////
+/// @brief Formats a network endpoint the way it is parsed.
+/// @param value Endpoint.
+/// @param buffer Destination buffer.
+/// @param buffer_size Destination buffer size.
+/// @return Formatted endpoint length (as snprintf).
+//////////////////////////////////////////////////////////////////////
+int FormatOptEndpoint(void* value, char* buffer, size_t buffer_size)
+{
+    struct sockaddr_storage* endpoint = (struct sockaddr_storage*)value;
+    char address[INET6_ADDRSTRLEN] = {0};
+
+    switch(endpoint->ss_family)
+    {
+        case AF_INET:
+            inet_ntop(AF_INET, &((struct sockaddr_in*)endpoint)->sin_addr, address, sizeof(address));
+            return snprintf(buffer, buffer_size, "%s:%d", address, GetOptEndpointPort(endpoint));
+
+        case AF_INET6:
+            inet_ntop(AF_INET6, &((struct sockaddr_in6*)endpoint)->sin6_addr, address, sizeof(address));
+            return snprintf(buffer, buffer_size, "[%s]:%d", address, GetOptEndpointPort(endpoint));
+
+        case AF_UNIX:
+            return snprintf(buffer, buffer_size, GET_OPT_ENDPOINT_UNIX_PREFIX "%s", ((struct sockaddr_un*)endpoint)->sun_path);
+
+        default:
+        break;
+    }
+
+    return snprintf(buffer, buffer_size, "-");
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Set binary blob option definition. Values are decoded (hex or base64) at parse time
+///        straight into the options arena, so there is no length ceiling other than the given
+///        maximum, and destinations are only pointed to the decoded bytes.
+/// @param opt_char Option character.
+/// @param opt_long Option string.
+/// @param opt_detail Option details.
+/// @param opt_blob_type GET_OPT_TYPE_BLOB_HEX or GET_OPT_TYPE_BLOB_BASE64.
+/// @param min_length Minimum decoded length (bytes).
+/// @param max_length Maximum decoded length (bytes), 0 for no limit.
+/// @param opt_default_value Default value, encoded as values are. NULL for an empty blob.
+/// @param opt_dest_var Address to the variable meant to be set after parsing.
+/// @return < 0 if any error happened, 0 otherwise.
+//////////////////////////////////////////////////////////////////////////////////////////////
+int SetOptionDefinitionBlob(char            opt_char            ,
+                            char*           opt_long            ,
+                            char*           opt_detail          ,
+                            int             opt_blob_type       ,
+                            size_t          min_length          ,
+                            size_t          max_length          ,
+                            char*           opt_default_value   ,
+                            GET_OPT_BLOB*   opt_dest_var        )
+{
+    if(!GET_OPT_IS_BLOB(opt_blob_type))
+    {
+        ReportOptError(GET_OPT_ERR_UNKNOWN_TYPE, -1, -1, opt_char, opt_long, opt_detail, opt_blob_type, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+        return RejectOptionDefinition(GET_OPT_ERR_UNKNOWN_TYPE);
+    }
+
+    // Boundaries only hold a length. A maximum of 0 leaves the maximum unset.
+    PRIV_OPT_BLOB_VALUE* boundaries = (PRIV_OPT_BLOB_VALUE*)calloc(2, sizeof(PRIV_OPT_BLOB_VALUE));
+
+    if(boundaries == NULL)
+    {
+        ReportOptError(GET_OPT_ERR_NULL_PTR, -1, -1, '\0', NULL, NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+        return RejectOptionDefinition(GET_OPT_ERR_NULL_PTR);
+    }
+
+    boundaries[0].length = min_length;
+    boundaries[1].length = max_length;
+
+    PRIV_OPT_BLOB_VALUE* max_blob = (max_length == 0 ? NULL : &boundaries[1]);
+
+    // The default value ends up pointed to by the destination as well, so it is decoded into the arena.
+    char* default_arg = (opt_default_value == NULL ? "" : opt_default_value);
+    PRIV_OPT_BLOB_VALUE* default_blob = NULL;
+    size_t default_length = 0;
+
+    if(GetOptBlobLength(opt_blob_type, default_arg, strlen(default_arg), &default_length) == GET_OPT_SUCCESS)
+    {
+        default_blob = (PRIV_OPT_BLOB_VALUE*)GetOptArenaAlloc(sizeof(PRIV_OPT_BLOB_VALUE) + default_length);
+    }
+
+    if(default_blob != NULL)
+    {
+        default_blob->length        = default_length;
+        default_blob->data_length   = default_length;
+    }
+
+    if(default_blob == NULL || DecodeOptBlob(opt_blob_type, default_arg, default_blob) < 0)
+    {
+        ReleaseOptArenaAlloc(default_blob);
+        free(boundaries);
+        ReportOptError(GET_OPT_ERR_CODEC_VALUE, -1, -1, opt_char, opt_long, opt_detail, opt_blob_type, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+        return RejectOptionDefinition(GET_OPT_ERR_CODEC_VALUE);
+    }
+
+    int set_option_definition = SetOptionDefinition(opt_char                                    ,
+                                                    opt_long                                    ,
+                                                    opt_detail                                  ,
+                                                    opt_blob_type                               ,
+                                                    GET_OPT_ARG_REQ_REQUIRED                    ,
+                                                    (OPT_DATA_TYPE){.custom = &boundaries[0]}   ,
+                                                    (OPT_DATA_TYPE){.custom = max_blob}         ,
+                                                    (OPT_DATA_TYPE){.custom = default_blob}     ,
+                                                    opt_dest_var                                );
+
+    // Nothing else is allocated from the arena meanwhile, so a rejected default does not stay there.
+    if(set_option_definition < 0)
+    {
+        ReleaseOptArenaAlloc(default_blob);
+        free(boundaries);
+        return set_option_definition;
+    }
+
+    private_options[GetOptionIndexFromLong(opt_long, strlen(opt_long))].opt_codec_owned = boundaries;
+
+    return GET_OPT_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////////////
+/// @brief Blob options: the decoded length is known up front, so
+///        values out of bounds are neither allocated nor decoded.
+//////////////////////////////////////////////////////////////////
+int ConvertOptBlob(PRIV_OPT_DEFINITION* priv_opt_def, char* arg, OPT_DATA_TYPE* value)
+{
+    int blob_type = priv_opt_def->pub_opt.opt_var_type;
+    PRIV_OPT_BLOB_VALUE* min_blob = (PRIV_OPT_BLOB_VALUE*)priv_opt_def->pub_opt.opt_min_value.custom;
+    PRIV_OPT_BLOB_VALUE* max_blob = (PRIV_OPT_BLOB_VALUE*)priv_opt_def->pub_opt.opt_max_value.custom;
+    size_t length;
+
+    if(GetOptBlobLength(blob_type, arg, strlen(arg), &length) < 0)
+    {
+        return GET_OPT_ERR_CODEC_VALUE;
+    }
+
+    if((min_blob != NULL && length < min_blob->length) || (max_blob != NULL && length > max_blob->length))
+    {
+        return GET_OPT_ERR_VAL_OUT_OF_BOUNDS;
+    }
+
+    PRIV_OPT_BLOB_VALUE* blob = (PRIV_OPT_BLOB_VALUE*)GetOptArenaAlloc(sizeof(PRIV_OPT_BLOB_VALUE) + length);
+
+    if(blob == NULL)
+    {
+        return GET_OPT_ERR_NULL_PTR;
+    }
+
+    blob->length        = length;
+    blob->data_length   = length;
+
+    if(DecodeOptBlob(blob_type, arg, blob) < 0)
+    {
+        ReleaseOptArenaAlloc(blob);
+        return GET_OPT_ERR_CODEC_VALUE;
+    }
+
+    value->custom = blob;
+
+    return GET_OPT_SUCCESS;
+}
+
+/////////////////////////////////////////////////////////////////////
+/// @brief Fills the hex and base64 decode tables (both the standard
+///        and the URL-safe base64 alphabets), the first time they are
+///        needed.
+/////////////////////////////////////////////////////////////////////
+void InitOptBlobTables(void)
+{
+    if(hex_decode_table[0] == GET_OPT_BLOB_DIGIT_INVALID)
+    {
+        return;
+    }
+
+    memset(hex_decode_table, GET_OPT_BLOB_DIGIT_INVALID, sizeof(hex_decode_table));
+    memset(base64_decode_table, GET_OPT_BLOB_DIGIT_INVALID, sizeof(base64_decode_table));
+
+    for(int i = 0; i < 10; i++)
+    {
+        hex_decode_table['0' + i]       = i;
+        base64_decode_table['0' + i]    = 52 + i;
+    }
+
+    for(int i = 0; i < 6; i++)
+    {
+        hex_decode_table['a' + i] = 10 + i;
+        hex_decode_table['A' + i] = 10 + i;
+    }
+
+    for(int i = 0; i < 26; i++)
+    {
+        base64_decode_table['A' + i] = i;
+        base64_decode_table['a' + i] = 26 + i;
+    }
+
+    base64_decode_table['+'] = 62;
+    base64_decode_table['-'] = 62;
+    base64_decode_table['/'] = 63;
+    base64_decode_table['_'] = 63;
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+/// @brief Gets the decoded length of a blob value, checking only its length (and
+///        base64 padding, which is optional but must complete the last group).
+/// @param blob_type GET_OPT_TYPE_BLOB_HEX or GET_OPT_TYPE_BLOB_BASE64.
+/// @param arg Encoded value.
+/// @param arg_len Encoded value length.
+/// @param length Where to store the decoded length.
+/// @return GET_OPT_ERR_CODEC_VALUE if no value can have such a length, 0 otherwise.
+////////////////////////////////////////////////////////////////////////////////////
+int GetOptBlobLength(int blob_type, char* arg, size_t arg_len, size_t* length)
+{
+    if(blob_type == GET_OPT_TYPE_BLOB_HEX)
+    {
+        if(arg_len % 2 != 0)
+        {
+            return GET_OPT_ERR_CODEC_VALUE;
+        }
+
+        *length = arg_len / 2;
+
+        return GET_OPT_SUCCESS;
+    }
+
+    if(arg_len % 4 == 0 && arg_len > 0 && arg[arg_len - 1] == GET_OPT_BLOB_BASE64_PAD)
+    {
+        arg_len -= (arg[arg_len - 2] == GET_OPT_BLOB_BASE64_PAD ? 2 : 1);
+    }
+
+    if(arg_len % 4 == 1)
+    {
+        return GET_OPT_ERR_CODEC_VALUE;
+    }
+
+    *length = (arg_len / 4) * 3 + (arg_len % 4 == 0 ? 0 : arg_len % 4 - 1);
+
+    return GET_OPT_SUCCESS;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Decodes a blob value, whose length has been given by GetOptBlobLength. Digits
+///        are looked up in 256-entry tables and their validity is accumulated instead of
+///        being branched on, so that each loop only branches on its own end.
+/// @param blob_type GET_OPT_TYPE_BLOB_HEX or GET_OPT_TYPE_BLOB_BASE64.
+/// @param arg Encoded value.
+/// @param blob Destination, with its length already set.
+/// @return GET_OPT_ERR_CODEC_VALUE if any character is out of the alphabet, 0 otherwise.
+/////////////////////////////////////////////////////////////////////////////////////////
+int DecodeOptBlob(int blob_type, char* arg, PRIV_OPT_BLOB_VALUE* blob)
+{
+    const uint8_t* digits = (const uint8_t*)arg;
+    uint8_t* data = blob->data;
+    uint8_t invalid = 0;
+
+    InitOptBlobTables();
+
+    if(blob_type == GET_OPT_TYPE_BLOB_HEX)
+    {
+        for(size_t i = 0; i < blob->length; i++)
+        {
+            uint8_t high    = hex_decode_table[digits[2 * i]    ];
+            uint8_t low     = hex_decode_table[digits[2 * i + 1]];
+
+            invalid |= high | low;
+            data[i] = (uint8_t)((high << 4) | low);
+        }
+
+        return (invalid == GET_OPT_BLOB_DIGIT_INVALID ? GET_OPT_ERR_CODEC_VALUE : GET_OPT_SUCCESS);
+    }
+
+    // Whole groups: 4 characters into 3 bytes.
+    for(size_t group_number = blob->length / 3; group_number > 0; group_number--, digits += 4, data += 3)
+    {
+        uint8_t sextet_0 = base64_decode_table[digits[0]];
+        uint8_t sextet_1 = base64_decode_table[digits[1]];
+        uint8_t sextet_2 = base64_decode_table[digits[2]];
+        uint8_t sextet_3 = base64_decode_table[digits[3]];
+        uint32_t group = ((uint32_t)sextet_0 << 18) | ((uint32_t)sextet_1 << 12) | ((uint32_t)sextet_2 << 6) | sextet_3;
+
+        invalid |= sextet_0 | sextet_1 | sextet_2 | sextet_3;
+        data[0] = (uint8_t)(group >> 16);
+        data[1] = (uint8_t)(group >> 8);
+        data[2] = (uint8_t)group;
+    }
+
+    // Last group: 2 or 3 characters into 1 or 2 bytes.
+    size_t tail_length = blob->length % 3;
+
+    if(tail_length > 0)
+    {
+        uint8_t sextet_0 = base64_decode_table[digits[0]];
+        uint8_t sextet_1 = base64_decode_table[digits[1]];
+        uint8_t sextet_2 = (tail_length == 2 ? base64_decode_table[digits[2]] : 0);
+        uint32_t group = ((uint32_t)sextet_0 << 18) | ((uint32_t)sextet_1 << 12) | ((uint32_t)sextet_2 << 6);
+
+        invalid |= sextet_0 | sextet_1 | sextet_2;
+        data[0] = (uint8_t)(group >> 16);
+
+        if(tail_length == 2)
+        {
+            data[1] = (uint8_t)(group >> 8);
+        }
+    }
+
+    return (invalid == GET_OPT_BLOB_DIGIT_INVALID ? GET_OPT_ERR_CODEC_VALUE : GET_OPT_SUCCESS);
+}
+
+//////////////////////////////////////////////////////////////////////
+/// @brief Compares two blobs by length, which is what boundaries are
+///        about.
+/// @param value_a First blob.
+/// @param value_b Second blob.
+/// @return < 0, 0, > 0 if the first blob is shorter, as long or longer.
+//////////////////////////////////////////////////////////////////////
+int CompareOptBlob(void* value_a, void* value_b)
+{
+    size_t length_a = ((PRIV_OPT_BLOB_VALUE*)value_a)->length;
+    size_t length_b = ((PRIV_OPT_BLOB_VALUE*)value_b)->length;
+
+    return (length_a > length_b) - (length_a < length_b);
+}
+
+//////////////////////////////////////////////////////////////////////
+/// @brief Formats a blob by its length only, as blobs are often keys.
+/// @param value Blob.
+/// @param buffer Destination buffer.
+/// @param buffer_size Destination buffer size.
+/// @return Formatted blob length (as snprintf).
+//////////////////////////////////////////////////////////////////////
+int FormatOptBlob(void* value, char* buffer, size_t buffer_size)
+{
+    return snprintf(buffer, buffer_size, GET_OPT_MSG_LENGTH_BYTES, ((PRIV_OPT_BLOB_VALUE*)value)->length);
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+/// @brief Gets the size of a codec value in its binary form, which is fixed for
+///        each codec but blobs (length-prefixed).
+/// @param var_type Option (codec) type.
+/// @param value Value.
+/// @return Value size.
+//////////////////////////////////////////////////////////////////////////////////
+size_t GetOptCodecValueSize(int var_type, void* value)
+{
+    if(GET_OPT_IS_BLOB(var_type))
+    {
+        return sizeof(PRIV_OPT_BLOB_VALUE) + ((PRIV_OPT_BLOB_VALUE*)value)->data_length;
+    }
+
+    return GET_OPT_CODEC_OF(var_type)->value_size;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Allocates memory from the options arena: 8-byte aligned bump allocations out
+///        of chunks which double in size (up to GET_OPT_SIZE_ARENA_CHUNK_MAX, or whatever
+///        a single allocation needs). Nothing is freed but the whole arena at once, or
+///        the last allocation (see ReleaseOptArenaAlloc).
+/// @param size Allocation size.
+/// @return NULL if it could not be allocated, allocation address otherwise.
+/////////////////////////////////////////////////////////////////////////////////////////
+void* GetOptArenaAlloc(size_t size)
+{
+    size_t offset = (options_arena == NULL ? 0 : GET_OPT_ARENA_ALIGN(options_arena->used));
+
+    // Chunk sizes are multiples of the alignment, so offset never goes past the chunk end.
+    if(options_arena == NULL || options_arena->size - offset < size)
+    {
+        if(size > SIZE_MAX - sizeof(PRIV_OPT_ARENA_CHUNK) - sizeof(uint64_t))
+        {
+            return NULL;
+        }
+
+        // Oversized allocations get a chunk of their own, which leaves the doubling sequence as it is.
+        size_t next_chunk_size = (arena_chunk_size == 0 ? GET_OPT_SIZE_ARENA_CHUNK_MIN : arena_chunk_size);
+
+        if(arena_chunk_size != 0 && arena_chunk_size < GET_OPT_SIZE_ARENA_CHUNK_MAX)
+        {
+            next_chunk_size = 2 * arena_chunk_size;
+        }
+
+        size_t chunk_size = (next_chunk_size < size ? GET_OPT_ARENA_ALIGN(size) : next_chunk_size);
+
+        PRIV_OPT_ARENA_CHUNK* chunk = (PRIV_OPT_ARENA_CHUNK*)malloc(sizeof(PRIV_OPT_ARENA_CHUNK) + chunk_size);
+
+        if(chunk == NULL)
+        {
+            return NULL;
+        }
+
+        if(chunk_size == next_chunk_size)
+        {
+            arena_chunk_size = chunk_size;
+        }
+
+        chunk->next = options_arena;
+        chunk->size = chunk_size;
+        chunk->used = 0;
+        options_arena = chunk;
+        offset = 0;
+    }
+
+    options_arena->used = offset + size;
+
+    return options_arena->data + offset;
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+/// @brief Gives the last allocation made from the options arena back to it, i.e.
+///        when whatever was allocated for turns out not to be needed. Anything but
+///        the last allocation is left as it is.
+/// @param allocation Allocation address, as returned by GetOptArenaAlloc.
+////////////////////////////////////////////////////////////////////////////////////
+void ReleaseOptArenaAlloc(void* allocation)
+{
+    if( options_arena != NULL && allocation != NULL                 &&
+        (char*)allocation >= options_arena->data                    &&
+        (char*)allocation <  options_arena->data + options_arena->used)
+    {
+        options_arena->used = (char*)allocation - options_arena->data;
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Frees the options arena, where blob values and reference strings are stored.
+///        Destinations pointing to it are no longer valid afterwards.
+//////////////////////////////////////////////////////////////////////////////////////////
+void FreeOptionsArena(void)
+{
+    while(options_arena != NULL)
+    {
+        PRIV_OPT_ARENA_CHUNK* next = options_arena->next;
+        free(options_arena);
+        options_arena = next;
+    }
+
+    arena_chunk_size = 0;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Sets a string constraint on an already defined string option: length bounds,
+///        allowed characters and required prefix, all of them checked in a single pass
+///        over each value. The default value must meet the constraint as well.
+/// @param opt_long Option string.
+/// @param min_length Minimum value length.
+/// @param max_length Maximum value length, 0 for PATH_MAX (no limit for reference strings).
+/// @param charset Allowed characters, where "a-z" stands for a whole range. NULL for any.
+/// @param prefix Prefix every value must start with. NULL for none.
+/// @return < 0 if any error happened, 0 otherwise.
+/////////////////////////////////////////////////////////////////////////////////////////////
+int SetOptionStringConstraint(  char*   opt_long    ,
+                                size_t  min_length  ,
+                                size_t  max_length  ,
+                                char*   charset     ,
+                                char*   prefix      )
+{
+    int option_index = (opt_long == NULL ? -1 : GetOptionIndexFromLong(opt_long, strlen(opt_long)));
+
+    if(option_index < 0)
+    {
+        ReportOptError(GET_OPT_ERR_UNKNOWN_OPTION, -1, -1, '\0', opt_long, NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+        return GET_OPT_ERR_UNKNOWN_OPTION;
+    }
+
+    PRIV_OPT_DEFINITION* priv_opt_def = &private_options[option_index];
+    size_t prefix_length = (prefix == NULL ? 0 : strlen(prefix));
+
+    // Reference strings have no PATH_MAX ceiling: only their own maximum length, if any.
+    if(max_length == 0)
+    {
+        max_length = (priv_opt_def->opt_str_mode == GET_OPT_STR_MODE_COPY ? PATH_MAX : priv_opt_def->opt_str_max_length);
+        max_length = (max_length == 0 ? SIZE_MAX : max_length);
+    }
+
+    if( priv_opt_def->pub_opt.opt_var_type != GET_OPT_TYPE_CHAR_STRING  ||
+        min_length > max_length                                         ||
+        prefix_length > max_length                                      )
+    {
+        ReportOptErrorFromDef(GET_OPT_ERR_STRING_CONSTRAINT_DEF, option_index, -1);
+        return GET_OPT_ERR_STRING_CONSTRAINT_DEF;
+    }
+
+    PRIV_OPT_STR_CONSTRAINT* constraint = (PRIV_OPT_STR_CONSTRAINT*)calloc(1, sizeof(PRIV_OPT_STR_CONSTRAINT) + prefix_length + 1);
+
+    if(constraint == NULL)
+    {
+        ReportOptError(GET_OPT_ERR_NULL_PTR, -1, -1, '\0', NULL, NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+        return GET_OPT_ERR_NULL_PTR;
+    }
+
+    constraint->min_length      = min_length;
+    constraint->max_length      = max_length;
+    constraint->prefix_length   = prefix_length;
+    constraint->prefix          = (char*)(constraint + 1);
+
+    if(prefix != NULL)
+    {
+        memcpy(constraint->prefix, prefix, prefix_length);
+    }
+
+    CompileOptCharset(charset, constraint->charset);
+
+    if(CheckStringConstraint(constraint, priv_opt_def->pub_opt.opt_default_value.char_string) < 0)
+    {
+        free(constraint);
+        ReportOptErrorFromDef(GET_OPT_ERR_STRING_CONSTRAINT_DEF, option_index, -1);
+        return GET_OPT_ERR_STRING_CONSTRAINT_DEF;
+    }
+
+    free(priv_opt_def->opt_str_constraint);
+    priv_opt_def->opt_str_constraint = constraint;
+    BindOptionConverter(priv_opt_def);
+
+    return GET_OPT_SUCCESS;
+}
+
+///////////////////////////////////////////////////////////////////////////////////
+/// @brief Compiles a character list into a 256-bit mask. "a-z" stands for a whole
+///        range, a '-' at either end of the list for itself.
+/// @param charset Allowed characters, NULL for any.
+/// @param charset_mask Destination mask (GET_OPT_SIZE_CHARSET_WORDS words).
+///////////////////////////////////////////////////////////////////////////////////
+void CompileOptCharset(char* charset, uint64_t* charset_mask)
+{
+    if(charset == NULL)
+    {
+        memset(charset_mask, UCHAR_MAX, GET_OPT_SIZE_CHARSET_WORDS * sizeof(uint64_t));
+        return;
+    }
+
+    memset(charset_mask, 0, GET_OPT_SIZE_CHARSET_WORDS * sizeof(uint64_t));
+
+    for(size_t i = 0; charset[i] != '\0'; i++)
+    {
+        unsigned char first = charset[i];
+        unsigned char last = first;
+
+        if(charset[i + 1] == '-' && charset[i + 2] != '\0')
+        {
+            last = charset[i + 2];
+            i += 2;
+        }
+
+        for(int c = first; c <= last; c++)
+        {
+            GET_OPT_BITSET_SET(charset_mask, c);
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////////////////
+/// @brief Checks a value against a string constraint. Length, characters and prefix
+///        are all checked within the same pass, which stops as soon as any fails.
+/// @param constraint String constraint.
+/// @param arg Value.
+/// @return GET_OPT_ERR_STRING_CONSTRAINT if the value does not meet it, 0 otherwise.
+//////////////////////////////////////////////////////////////////////////////////////
+int CheckStringConstraint(PRIV_OPT_STR_CONSTRAINT* constraint, char* arg)
+{
+    size_t i;
+
+    for(i = 0; arg[i] != '\0'; i++)
+    {
+        unsigned char c = arg[i];
+
+        if( i >= constraint->max_length                                     ||
+            !GET_OPT_BITSET_TEST(constraint->charset, c)                    ||
+            (i < constraint->prefix_length && arg[i] != constraint->prefix[i])  )
+        {
+            return GET_OPT_ERR_STRING_CONSTRAINT;
+        }
+    }
+
+    if(i < constraint->min_length || i < constraint->prefix_length)
+    {
+        return GET_OPT_ERR_STRING_CONSTRAINT;
+    }
+
+    return GET_OPT_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////
+/// @brief Sets the flag set boolean options defined by SetOptionDefinitionFlag are
+///        packed into, one bit each, so that 512 flags fit within a cache line.
+/// @param flag_set Caller-provided array, GET_OPT_FLAG_WORDS(flag_number) words long.
+/// @param flag_number Number of flags (bits) the array can hold.
+/// @return < 0 if any error happened (i.e. flags already defined do not fit within
+///         the new set), 0 otherwise. Setting the same set again keeps their bits.
+//////////////////////////////////////////////////////////////////////////////////////
+int SetOptionsFlagSet(uint64_t* flag_set, int flag_number)
+{
+    uint64_t* new_used_flag_bits = (flag_set == NULL || flag_number <= 0 ? NULL : (uint64_t*)calloc(GET_OPT_BITSET_WORDS(flag_number), sizeof(uint64_t)));
+
+    if(new_used_flag_bits == NULL)
+    {
+        ReportOptError(GET_OPT_ERR_NULL_PTR, -1, -1, '\0', NULL, NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+        return GET_OPT_ERR_NULL_PTR;
+    }
+
+    // Flags defined so far keep their bits, so they must fit within the new set (i.e. the same one again).
+    for(int i = 0; i < option_number; i++)
+    {
+        PRIV_OPT_DEFINITION* priv_opt_def = &private_options[i];
+
+        if(GET_OPT_IS_REMOVED(priv_opt_def) || priv_opt_def->opt_flag_mask == 0)
+        {
+            continue;
+        }
+
+        uint64_t* flag_word = (uint64_t*)priv_opt_def->pub_opt.opt_dest_var;
+        int flag_bit = flag_number;
+
+        if(flag_word >= flag_set && flag_word < flag_set + GET_OPT_BITSET_WORDS(flag_number))
+        {
+            flag_bit = (flag_word - flag_set) * 64 + __builtin_ctzll(priv_opt_def->opt_flag_mask);
+        }
+
+        if(flag_bit >= flag_number)
+        {
+            free(new_used_flag_bits);
+            ReportOptErrorFromDef(GET_OPT_ERR_FLAG_SET, i, -1);
+            return GET_OPT_ERR_FLAG_SET;
+        }
+
+        GET_OPT_BITSET_SET(new_used_flag_bits, flag_bit);
+    }
+
+    free(used_flag_bits);
+    used_flag_bits = new_used_flag_bits;
+    options_flag_set = flag_set;
+    flag_set_size = flag_number;
+
+    return GET_OPT_SUCCESS;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+/// @brief Sets a boolean option definition whose destination is the lowest free
+///        bit of the flag set. Bits of removed (or rolled back) flags are free again.
+///        Test it with GET_OPT_FLAG_TEST(flag_set, bit).
+/// @param opt_char Option character.
+/// @param opt_long Option string.
+/// @param opt_detail Option details.
+/// @param opt_default_value Option default value.
+/// @return < 0 if any error happened, bit of the flag within the flag set otherwise.
+/////////////////////////////////////////////////////////////////////////////////////
+int SetOptionDefinitionFlag(char opt_char, char* opt_long, char* opt_detail, bool opt_default_value)
+{
+    int flag_bit = flag_set_size;
+
+    for(int word = 0; options_flag_set != NULL && word < GET_OPT_BITSET_WORDS(flag_set_size); word++)
+    {
+        if(~used_flag_bits[word] != 0)
+        {
+            flag_bit = word * 64 + __builtin_ctzll(~used_flag_bits[word]);
+            break;
+        }
+    }
+
+    if(flag_bit >= flag_set_size)
+    {
+        ReportOptError(GET_OPT_ERR_FLAG_SET, -1, -1, opt_char, opt_long, opt_detail, GET_OPT_TYPE_INT, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+        return RejectOptionDefinition(GET_OPT_ERR_FLAG_SET);
+    }
+
+    // Defined as any other boolean option, pointing to the word the flag lives in.
+    int set_option_definition = SetOptionDefinitionBool(opt_char, opt_long, opt_detail, opt_default_value, &options_flag_set[flag_bit / 64]);
+
+    if(set_option_definition < 0)
+    {
+        return set_option_definition;
+    }
+
+    private_options[GetOptionIndexFromLong(opt_long, strlen(opt_long))].opt_flag_mask = (1ULL << (flag_bit % 64));
+    GET_OPT_BITSET_SET(used_flag_bits, flag_bit);
+
+    return flag_bit;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+/// @brief Gets the bit of a flag option within the current flag set.
+/// @param priv_opt_def Private option definition.
+/// @return -1 if not a flag of the current flag set, flag bit otherwise.
+/////////////////////////////////////////////////////////////////////////////
+int GetOptFlagBit(PRIV_OPT_DEFINITION* priv_opt_def)
+{
+    uint64_t* flag_word = (uint64_t*)priv_opt_def->pub_opt.opt_dest_var;
+
+    if( priv_opt_def->opt_flag_mask == 0                                        ||
+        options_flag_set == NULL                                                ||
+        flag_word < options_flag_set                                            ||
+        flag_word >= options_flag_set + GET_OPT_BITSET_WORDS(flag_set_size)     )
+    {
+        return -1;
+    }
+
+    return (flag_word - options_flag_set) * 64 + __builtin_ctzll(priv_opt_def->opt_flag_mask);
+}
+
+//////////////////////////////////////////////////////////////////////
+/// @brief Gives the bit of a flag option back to the flag set, so
+///        that the next flag defined takes it.
+/// @param priv_opt_def Private option definition.
+//////////////////////////////////////////////////////////////////////
+void ReleaseOptFlagBit(PRIV_OPT_DEFINITION* priv_opt_def)
+{
+    int flag_bit = GetOptFlagBit(priv_opt_def);
+
+    if(flag_bit >= 0)
+    {
+        GET_OPT_BITSET_CLEAR(used_flag_bits, flag_bit);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////
+/// @brief Writes a C header with the bit of every flag option, plus test and set
+///        macros for each one (i.e. with "APP_" as prefix, --fast-path gets
+///        APP_FAST_PATH_BIT, APP_FAST_PATH(flag_set) and APP_SET_FAST_PATH(flag_set)).
+/// @param header_path Header file path.
+/// @param macro_prefix Prefix for every macro name.
+/// @return < 0 if any error happened (i.e. two flags get the same macro name, as
+///         --fast-path and --fast_path do), 0 otherwise.
+///////////////////////////////////////////////////////////////////////////////////////
+int WriteOptionsFlagHeader(char* header_path, char* macro_prefix)
+{
+    int check_macro_names = CheckOptFlagMacroNames();
+
+    if(check_macro_names < 0)
+    {
+        return check_macro_names;
+    }
+
+    FILE* header_file = (header_path == NULL || macro_prefix == NULL ? NULL : fopen(header_path, "w"));
+
+    if(header_file == NULL)
+    {
+        ReportOptError(GET_OPT_ERR_FLAG_HEADER, -1, -1, '\0', NULL, NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+        return GET_OPT_ERR_FLAG_HEADER;
+    }
+
+    fprintf(header_file, "// Generated by WriteOptionsFlagHeader, do not edit.\n\n");
+    fprintf(header_file, "#ifndef %sFLAG_SET_H\n#define %sFLAG_SET_H\n\n", macro_prefix, macro_prefix);
+    fprintf(header_file, "#include \"GetOptions_api.h\"\n\n");
+    // The flag set must reach up to the word of the highest bit in use.
+    int flag_words = GET_OPT_BITSET_WORDS(flag_set_size);
+
+    while(flag_words > 0 && used_flag_bits[flag_words - 1] == 0)
+    {
+        flag_words--;
+    }
+
+    fprintf(header_file, "#define %sFLAG_WORDS %d\n\n", macro_prefix, flag_words);
+
+    for(int i = 0; i < option_number; i++)
+    {
+        PRIV_OPT_DEFINITION* priv_opt_def = &private_options[i];
+
+        int flag_bit = GetOptFlagBit(priv_opt_def);
+
+        if(GET_OPT_IS_REMOVED(priv_opt_def) || flag_bit < 0)
+        {
+            continue;
+        }
+
+        char macro_name[GET_OPT_SIZE_LONG_MAX + 1];
+        GetOptFlagMacroName((char*)priv_opt_def->pub_opt.opt_long, macro_name);
+
+        fprintf(header_file, "#define %s%s_BIT %d\n", macro_prefix, macro_name, flag_bit);
+        fprintf(header_file, "#define %s%s(flag_set) GET_OPT_FLAG_TEST(flag_set, %d)\n", macro_prefix, macro_name, flag_bit);
+        fprintf(header_file, "#define %sSET_%s(flag_set) GET_OPT_FLAG_SET(flag_set, %d)\n\n", macro_prefix, macro_name, flag_bit);
+    }
+
+    fprintf(header_file, "#endif\n");
+
+    if(fclose(header_file) != 0)
+    {
+        ReportOptError(GET_OPT_ERR_FLAG_HEADER, -1, -1, '\0', NULL, NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+        return GET_OPT_ERR_FLAG_HEADER;
+    }
+
+    return GET_OPT_SUCCESS;
+}
+
+/////////////////////////////////////////////////////////////////////////////////
+/// @brief Turns an option long name into a macro name (--fast-path -> FAST_PATH).
+///        Characters not allowed in C identifiers become '_'.
+/// @param opt_long Option string.
+/// @param macro_name Where to write the macro name (GET_OPT_SIZE_LONG_MAX + 1).
+/////////////////////////////////////////////////////////////////////////////////
+void GetOptFlagMacroName(char* opt_long, char* macro_name)
+{
+    int i;
+
+    for(i = 0; opt_long[i] != '\0' && i < GET_OPT_SIZE_LONG_MAX; i++)
+    {
+        macro_name[i] = (isalnum((unsigned char)opt_long[i]) ? toupper((unsigned char)opt_long[i]) : '_');
+    }
+
+    macro_name[i] = '\0';
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+/// @brief Checks that no macro name is generated twice for the flag header (i.e.
+///        --fast-path and --fast_path, or --x-bit and the _BIT macro of --x).
+/// @return < 0 if any name collides, 0 otherwise.
+////////////////////////////////////////////////////////////////////////////////////
+int CheckOptFlagMacroNames(void)
+{
+    // Three macros per flag, plus FLAG_WORDS and the include guard.
+    PRIV_OPT_FLAG_MACRO* macros = (PRIV_OPT_FLAG_MACRO*)malloc((3 * option_number + 2) * sizeof(PRIV_OPT_FLAG_MACRO));
+
+    if(macros == NULL)
+    {
+        ReportOptError(GET_OPT_ERR_NULL_PTR, -1, -1, '\0', NULL, NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+        return GET_OPT_ERR_NULL_PTR;
+    }
+
+    int macro_number = 0;
+
+    snprintf(macros[macro_number].name, sizeof(macros[macro_number].name), "FLAG_WORDS");
+    macros[macro_number++].option_index = -1;
+    snprintf(macros[macro_number].name, sizeof(macros[macro_number].name), "FLAG_SET_H");
+    macros[macro_number++].option_index = -1;
+
+    for(int i = 0; i < option_number; i++)
+    {
+        PRIV_OPT_DEFINITION* priv_opt_def = &private_options[i];
+
+        if(GET_OPT_IS_REMOVED(priv_opt_def) || GetOptFlagBit(priv_opt_def) < 0)
+        {
+            continue;
+        }
+
+        char macro_name[GET_OPT_SIZE_LONG_MAX + 1];
+        GetOptFlagMacroName((char*)priv_opt_def->pub_opt.opt_long, macro_name);
+
+        snprintf(macros[macro_number].name, sizeof(macros[macro_number].name), "%s_BIT", macro_name);
+        macros[macro_number++].option_index = i;
+        snprintf(macros[macro_number].name, sizeof(macros[macro_number].name), "%s", macro_name);
+        macros[macro_number++].option_index = i;
+        snprintf(macros[macro_number].name, sizeof(macros[macro_number].name), "SET_%s", macro_name);
+        macros[macro_number++].option_index = i;
+    }
+
+    qsort(macros, macro_number, sizeof(PRIV_OPT_FLAG_MACRO), CompareOptFlagMacros);
+
+    for(int i = 1; i < macro_number; i++)
+    {
+        if(strcmp(macros[i - 1].name, macros[i].name) == 0)
+        {
+            // Fixed names sort first among equal ones, so the latter is always a flag.
+            ReportOptErrorFromDef(GET_OPT_ERR_FLAG_MACRO, macros[i].option_index, -1);
+            free(macros);
+            return GET_OPT_ERR_FLAG_MACRO;
+        }
+    }
+
+    free(macros);
+
+    return GET_OPT_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////////
+/// @brief Sorts flag macros by name, fixed names first.
+/// @param macro_a First macro (PRIV_OPT_FLAG_MACRO).
+/// @param macro_b Second macro (PRIV_OPT_FLAG_MACRO).
+/// @return qsort comparison result.
+//////////////////////////////////////////////////////////////
+int CompareOptFlagMacros(const void* macro_a, const void* macro_b)
+{
+    const PRIV_OPT_FLAG_MACRO* first  = (const PRIV_OPT_FLAG_MACRO*)macro_a;
+    const PRIV_OPT_FLAG_MACRO* second = (const PRIV_OPT_FLAG_MACRO*)macro_b;
+
+    int compare_names = strcmp(first->name, second->name);
+
+    return (compare_names != 0 ? compare_names : first->option_index - second->option_index);
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Attaches a constraint to a group of already defined options (i.e. exactly one
+///        of --input or --stdin). Constraints are checked once every source has been
+///        parsed, before any destination variable is written.
+/// @param constraint_type Constraint type (OPT_CONSTRAINT_TYPE).
+/// @param opt_longs Long names of the options in the group.
+/// @param opt_long_number Number of options in the group.
+/// @return < 0 if the constraint is wrong or any option is unknown, 0 otherwise.
+//////////////////////////////////////////////////////////////////////////////////////////
+int SetOptionsConstraint(int constraint_type, char** opt_longs, int opt_long_number)
+{
+    if( constraint_type < GET_OPT_CONSTRAINT_MIN                                    ||
+        constraint_type > GET_OPT_CONSTRAINT_MAX                                    ||
+        opt_longs == NULL                                                           ||
+        opt_long_number < (constraint_type == GET_OPT_CONSTRAINT_DEPENDENT ? 2 : 1) )
+    {
+        ReportOptError(GET_OPT_ERR_CONSTRAINT_DEF, -1, -1, '\0', NULL, NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+        return GET_OPT_ERR_CONSTRAINT_DEF;
+    }
+
+    for(int i = 0; i < opt_long_number; i++)
+    {
+        if(opt_longs[i] == NULL || GetOptionIndexFromLong(opt_longs[i], strlen(opt_longs[i])) < 0)
+        {
+            ReportOptError(GET_OPT_ERR_UNKNOWN_OPTION, -1, -1, '\0', opt_longs[i], NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+            return GET_OPT_ERR_UNKNOWN_OPTION;
+        }
+    }
+
+    PRIV_OPT_CONSTRAINT* new_constraints = (PRIV_OPT_CONSTRAINT*)realloc(options_constraints, (constraint_number + 1) * sizeof(PRIV_OPT_CONSTRAINT));
+
+    if(new_constraints == NULL)
+    {
+        ReportOptError(GET_OPT_ERR_NULL_PTR, -1, -1, '\0', NULL, NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+        return GET_OPT_ERR_NULL_PTR;
+    }
+
+    options_constraints = new_constraints;
+
+    PRIV_OPT_CONSTRAINT* constraint = &options_constraints[constraint_number];
+
+    // Names are zero-padded, so that they can be hashed as a whole into the cache key.
+    constraint->opt_longs = calloc(opt_long_number, sizeof(constraint->opt_longs[0]));
+
+    if(constraint->opt_longs == NULL)
+    {
+        ReportOptError(GET_OPT_ERR_NULL_PTR, -1, -1, '\0', NULL, NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+        return GET_OPT_ERR_NULL_PTR;
+    }
+
+    for(int i = 0; i < opt_long_number; i++)
+    {
+        strncpy(constraint->opt_longs[i], opt_longs[i], GET_OPT_SIZE_LONG_MAX);
+    }
+
+    constraint->constraint_type = constraint_type;
+    constraint->opt_long_number = opt_long_number;
+    constraint->trigger_index   = -1;
+
+    constraint_number++;
+    constraint_mask_words = 0;
+
+    return GET_OPT_SUCCESS;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Compiles constraints into one bitmask over option indices each, so that they
+///        can be checked with a few word operations. Masks are kept until the registry
+///        changes (options defined, removed or moved).
+/// @return < 0 if any option in a constraint is no longer defined, 0 otherwise.
+///////////////////////////////////////////////////////////////////////////////////////////
+int CompileOptionsConstraints(void)
+{
+    int mask_words = GET_OPT_BITSET_WORDS(option_number);
+    uint64_t* new_masks = (uint64_t*)calloc(constraint_number * mask_words, sizeof(uint64_t));
+
+    if(new_masks == NULL)
+    {
+        ReportOptError(GET_OPT_ERR_NULL_PTR, -1, -1, '\0', NULL, NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+        return GET_OPT_ERR_NULL_PTR;
+    }
+
+    for(int i = 0; i < constraint_number; i++)
+    {
+        PRIV_OPT_CONSTRAINT* constraint = &options_constraints[i];
+
+        for(int j = 0; j < constraint->opt_long_number; j++)
+        {
+            int option_index = GetOptionIndexFromLong(constraint->opt_longs[j], strlen(constraint->opt_longs[j]));
+
+            if(option_index < 0)
+            {
+                free(new_masks);
+                ReportOptError(GET_OPT_ERR_UNKNOWN_OPTION, -1, -1, '\0', constraint->opt_longs[j], NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+                return GET_OPT_ERR_UNKNOWN_OPTION;
+            }
+
+            // The option others depend on is kept apart from the mask.
+            if(constraint->constraint_type == GET_OPT_CONSTRAINT_DEPENDENT && j == 0)
+            {
+                constraint->trigger_index = option_index;
+                continue;
+            }
+
+            GET_OPT_BITSET_SET(new_masks + i * mask_words, option_index);
+        }
+    }
+
+    free(constraint_masks);
+    constraint_masks = new_masks;
+    constraint_mask_words = mask_words;
+
+    return GET_OPT_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Checks every constraint against the options given through any source so far
+///        (seen_options), word by word, however many options there are.
+/// @return < 0 if any constraint is not met, 0 otherwise.
+////////////////////////////////////////////////////////////////////////////////////////////
+int CheckOptionsConstraints(void)
+{
+    if(constraint_number == 0)
+    {
+        return GET_OPT_SUCCESS;
+    }
+
+    if(constraint_mask_words == 0)
+    {
+        int compile_options_constraints = CompileOptionsConstraints();
+
+        if(compile_options_constraints < 0)
+        {
+            return compile_options_constraints;
+        }
+    }
+
+    for(int i = 0; i < constraint_number; i++)
+    {
+        PRIV_OPT_CONSTRAINT* constraint = &options_constraints[i];
+        uint64_t* mask = constraint_masks + i * constraint_mask_words;
+        int given_number = 0;
+        uint64_t missing = 0;
+
+        for(int word = 0; word < constraint_mask_words; word++)
+        {
+            given_number += __builtin_popcountll(seen_options[word] & mask[word]);
+            missing |= (mask[word] & ~seen_options[word]);
+        }
+
+        int code = GET_OPT_SUCCESS;
+
+        switch(constraint->constraint_type)
+        {
+            case GET_OPT_CONSTRAINT_REQUIRED:
+                code = (missing != 0 ? GET_OPT_ERR_REQUIRED_OPTION : GET_OPT_SUCCESS);
+            break;
+
+            case GET_OPT_CONSTRAINT_EXCLUSIVE:
+                code = (given_number > 1 ? GET_OPT_ERR_EXCLUSIVE_OPTIONS : GET_OPT_SUCCESS);
+            break;
+
+            case GET_OPT_CONSTRAINT_ONE_OF:
+                code = (given_number > 1 ? GET_OPT_ERR_EXCLUSIVE_OPTIONS : (given_number == 0 ? GET_OPT_ERR_REQUIRED_OPTION : GET_OPT_SUCCESS));
+            break;
+
+            case GET_OPT_CONSTRAINT_DEPENDENT:
+                code = (missing != 0 && GET_OPT_BITSET_TEST(seen_options, constraint->trigger_index) ? GET_OPT_ERR_DEPENDENT_OPTION : GET_OPT_SUCCESS);
+            break;
+
+            default:
+            break;
+        }
+
+        if(code < 0)
+        {
+            // Exclusive groups blame the second option given, other ones the first option missing.
+            int offender = (code == GET_OPT_ERR_EXCLUSIVE_OPTIONS ? GetOptConstraintOffender(mask, 1, 1) : GetOptConstraintOffender(mask, 0, 0));
+            ReportOptErrorFromDef(code, offender, -1);
+            return code;
+        }
+    }
+
+    return GET_OPT_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+/// @brief Finds the option to be blamed for a constraint not being met. Only used
+///        once a constraint has failed, so a plain scan is fine.
+/// @param mask Constraint mask.
+/// @param given 1 to look for options given, 0 to look for missing ones.
+/// @param nth How many matching options to skip.
+/// @return Index of the option, -1 if none.
+////////////////////////////////////////////////////////////////////////////////////
+int GetOptConstraintOffender(uint64_t* mask, int given, int nth)
+{
+    for(int i = 0; i < option_number; i++)
+    {
+        if(GET_OPT_BITSET_TEST(mask, i) && GET_OPT_BITSET_TEST(seen_options, i) == (uint64_t)given && nth-- == 0)
+        {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+//////////////////////////////////////////
+/// @brief Frees every option constraint.
+//////////////////////////////////////////
+void FreeOptionsConstraints(void)
+{
+    for(int i = 0; i < constraint_number; i++)
+    {
+        free(options_constraints[i].opt_longs);
+    }
+
+    free(options_constraints);
+    options_constraints = NULL;
+    constraint_number = 0;
+
+    free(constraint_masks);
+    constraint_masks = NULL;
+    constraint_mask_words = 0;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Keeps the provenance of each option, so that it can be queried once parsing
+///        is over (and private option data freed). The previous table (if any) is freed.
+/// @return GET_OPT_ERR_NULL_PTR if the table could not be allocated, 0 otherwise.
+/////////////////////////////////////////////////////////////////////////////////////////
+int RetainOptionsProvenance(void)
+{
+    free(retained_provenance);
+    retained_provenance = (PRIV_OPT_PROVENANCE*)calloc(option_number, sizeof(PRIV_OPT_PROVENANCE));
+    retained_provenance_number = 0;
+
+    if(retained_provenance == NULL)
+    {
+        ReportOptError(GET_OPT_ERR_NULL_PTR, -1, -1, '\0', NULL, NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+        return GET_OPT_ERR_NULL_PTR;
+    }
+
+    for(int i = 0; i < option_number; i++)
+    {
+        retained_provenance[i].opt_dest_var     = private_options[i].pub_opt.opt_dest_var;
+        retained_provenance[i].opt_provenance   = private_options[i].opt_provenance;
+    }
+
+    retained_provenance_number = option_number;
+
+    return GET_OPT_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Gets the sources that provided a value for an option during the last parsing.
+/// @param opt_dest_var Address of the option's destination variable.
+/// @return Bitmask with bit (1 << OPT_VALUE_SOURCE) set for each source that provided
+///         a value (the default one is always set), GET_OPT_ERR_UNKNOWN_OPTION if unknown.
+////////////////////////////////////////////////////////////////////////////////////////////
+int GetOptionProvenance(void* opt_dest_var)
+{
+    for(int i = 0; i < retained_provenance_number; i++)
+    {
+        if(retained_provenance[i].opt_dest_var == opt_dest_var)
+        {
+            return retained_provenance[i].opt_provenance;
+        }
+    }
+
+    return GET_OPT_ERR_UNKNOWN_OPTION;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Gets the source the value of an option came from during the last parsing.
+/// @param opt_dest_var Address of the option's destination variable.
+/// @return OPT_VALUE_SOURCE the value came from, GET_OPT_ERR_UNKNOWN_OPTION if unknown.
+//////////////////////////////////////////////////////////////////////////////////////////
+int GetOptionSource(void* opt_dest_var)
+{
+    int provenance = GetOptionProvenance(opt_dest_var);
+
+    if(provenance < 0)
+    {
+        return provenance;
+    }
+
+    return GET_OPT_PROV_WINNER(provenance);
+}
+
+//////////////////////////////////////////////////////////////////////////////////////
+/// @brief Sets the file in which resolved option values are cached across restarts.
+///        If the schema, argv, bound environment variables and config files (size and
+///        modification time) are the same as when the cache was written, ParseOptions
+///        takes the values straight from it, skipping every conversion and check.
+/// @param cache_file Path to the cache file. NULL disables caching.
+/// @return GET_OPT_ERR_LONG_LENGTH_EXCEEDED if the path is too long, 0 otherwise.
+//////////////////////////////////////////////////////////////////////////////////////
+int SetOptionsCacheFile(char* cache_file)
+{
+    if(cache_file == NULL)
+    {
+        cache_file_path[0] = '\0';
+        return GET_OPT_SUCCESS;
+    }
+
+    if(strlen(cache_file) > PATH_MAX)
+    {
+        ReportOptError(GET_OPT_ERR_LONG_LENGTH_EXCEEDED, -1, -1, '\0', NULL, NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+        return GET_OPT_ERR_LONG_LENGTH_EXCEEDED;
+    }
+
+    strcpy(cache_file_path, cache_file);
+
+    return GET_OPT_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////
+/// @brief Hashes a chunk of memory (64-bit FNV-1a).
+/// @param hash Hash computed so far.
+/// @param data Data to be hashed.
+/// @param data_size Data size.
+/// @return Updated hash value.
+//////////////////////////////////////////////////////////
+uint64_t GetOptHash64(uint64_t hash, void* data, size_t data_size)
+{
+    for(size_t i = 0; i < data_size; i++)
+    {
+        hash ^= ((unsigned char*)data)[i];
+        hash *= GET_OPT_HASH64_FNV_PRIME;
+    }
+
+    return hash;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Hashes an option value, taking only the bytes meaningful for its type.
+/// @param hash Hash computed so far.
+/// @param var_type Option variable type.
+/// @param value Value to be hashed.
+/// @return Updated hash value.
+////////////////////////////////////////////////////////////////////////////////
+uint64_t GetOptHashValue(uint64_t hash, int var_type, OPT_DATA_TYPE value)
+{
+    switch(var_type)
+    {
+        case GET_OPT_TYPE_INT:
+            return GetOptHash64(hash, &value.integer, sizeof(value.integer));
+
+        case GET_OPT_TYPE_CHAR:
+            return GetOptHash64(hash, &value.character, sizeof(value.character));
+
+        case GET_OPT_TYPE_FLOAT:
+            return GetOptHash64(hash, &value.floating, sizeof(value.floating));
+
+        case GET_OPT_TYPE_DOUBLE:
+            return GetOptHash64(hash, &value.doubling, sizeof(value.doubling));
+
+        case GET_OPT_TYPE_CHAR_STRING:
+            return GetOptHash64(hash, value.char_string, strlen(value.char_string) + 1);
+
+        default:
+        {
+            if(GET_OPT_IS_CODEC(var_type) && value.custom != NULL)
+            {
+                return GetOptHash64(hash, value.custom, GetOptCodecValueSize(var_type, value.custom));
+            }
+        }
+        break;
+    }
+
+    return hash;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Computes the key a cache file must match: option schema, argv, environment
+///        variables bound to options and config file identities (device, inode, size, mtime).
+/// @param argc Argument count.
+/// @param argv Argument character string array.
+/// @return Cache key.
+//////////////////////////////////////////////////////////////////////////////////////////////
+uint64_t GetOptionsCacheKey(int argc, char** argv)
+{
+    uint64_t hash = GET_OPT_HASH64_FNV_OFFSET;
+
+    if(cache_file_path[0] == '\0')
+    {
+        return hash;
+    }
+
+    for(int i = 0; i < option_number; i++)
+    {
+        PUB_OPT_DEFINITION* pub_opt = &private_options[i].pub_opt;
+
+        hash = GetOptHash64(hash, &pub_opt->opt_char, sizeof(pub_opt->opt_char));
+        hash = GetOptHash64(hash, pub_opt->opt_long, strlen((char*)pub_opt->opt_long) + 1);
+        hash = GetOptHash64(hash, &pub_opt->opt_var_type, sizeof(pub_opt->opt_var_type));
+        hash = GetOptHash64(hash, &pub_opt->opt_needs_arg, sizeof(pub_opt->opt_needs_arg));
+        hash = GetOptHashValue(hash, pub_opt->opt_var_type, pub_opt->opt_min_value);
+        hash = GetOptHashValue(hash, pub_opt->opt_var_type, pub_opt->opt_max_value);
+        hash = GetOptHashValue(hash, pub_opt->opt_var_type, pub_opt->opt_default_value);
+        hash = GetOptHash64(hash, &private_options[i].opt_str_mode, sizeof(private_options[i].opt_str_mode));
+        hash = GetOptHash64(hash, &private_options[i].opt_str_max_length, sizeof(private_options[i].opt_str_max_length));
+
+        for(int j = 0; private_options[i].opt_choice != NULL && j < private_options[i].opt_choice->choice_number; j++)
+        {
+            hash = GetOptHash64(hash, private_options[i].opt_choice->choices[j], strlen(private_options[i].opt_choice->choices[j]) + 1);
+        }
+
+        PRIV_OPT_STR_CONSTRAINT* str_constraint = private_options[i].opt_str_constraint;
+
+        if(str_constraint != NULL)
+        {
+            hash = GetOptHash64(hash, str_constraint, offsetof(PRIV_OPT_STR_CONSTRAINT, prefix));
+            hash = GetOptHash64(hash, str_constraint->prefix, str_constraint->prefix_length);
+        }
+    }
+
+    // A cache hit skips constraint checks, so values are only reused if constraints are the same.
+    for(int i = 0; i < constraint_number; i++)
+    {
+        hash = GetOptHash64(hash, &options_constraints[i].constraint_type, sizeof(options_constraints[i].constraint_type));
+        hash = GetOptHash64(hash, options_constraints[i].opt_longs, options_constraints[i].opt_long_number * sizeof(options_constraints[i].opt_longs[0]));
+    }
+
+    for(int i = 0; i < argc; i++)
+    {
+        hash = GetOptHash64(hash, argv[i], strlen(argv[i]) + 1);
+    }
+
+    int prefix_len = strlen(env_prefix);
+
+    for(int env_num = 0; prefix_len > 0 && environ[env_num] != NULL; env_num++)
+    {
+        if(strncmp(environ[env_num], env_prefix, prefix_len) == 0)
+        {
+            hash = GetOptHash64(hash, environ[env_num], strlen(environ[env_num]) + 1);
+        }
+    }
+
+    for(int i = 0; i < config_map_number; i++)
+    {
+        hash = GetOptHash64(hash, &config_maps[i].file_dev  , sizeof(config_maps[i].file_dev  ));
+        hash = GetOptHash64(hash, &config_maps[i].file_ino  , sizeof(config_maps[i].file_ino  ));
+        hash = GetOptHash64(hash, &config_maps[i].file_size , sizeof(config_maps[i].file_size ));
+        hash = GetOptHash64(hash, &config_maps[i].file_mtime, sizeof(config_maps[i].file_mtime));
+    }
+
+    return hash;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Maps the cache file and, if its key matches, assigns the cached values straight to
+///        the destination variables. Anything unexpected makes the caller fall back to parsing.
+/// @param cache_key Key the cache file must match.
+/// @return < 0 if the cache is missing or does not match, 0 if values have been assigned.
+///////////////////////////////////////////////////////////////////////////////////////////////
+int ApplyOptionsCache(uint64_t cache_key)
+{
+    int cache_fd = open(cache_file_path, O_RDONLY);
+    struct stat cache_stat;
+
+    if(cache_fd < 0)
+    {
+        return GET_OPT_ERR_CACHE_MISS;
+    }
+
+    if(fstat(cache_fd, &cache_stat) < 0 || (size_t)cache_stat.st_size < sizeof(PRIV_OPT_IMG_HEADER))
+    {
+        close(cache_fd);
+        return GET_OPT_ERR_CACHE_MISS;
+    }
+
+    size_t cache_size = cache_stat.st_size;
+    char* cache_buffer = mmap(NULL, cache_size, PROT_READ, MAP_PRIVATE, cache_fd, 0);
+    close(cache_fd);
+
+    if(cache_buffer == MAP_FAILED)
+    {
+        return GET_OPT_ERR_CACHE_MISS;
+    }
+
+    int check_options_image = CheckOptionsImage(cache_buffer, cache_size, cache_key);
+
+    if(check_options_image < 0)
+    {
+        munmap(cache_buffer, cache_size);
+        return check_options_image;
+    }
+
+    // Snapshots share the cache layout, so the option store is just a copy of it.
+    char* snapshot = (char*)malloc(cache_size);
+
+    if(snapshot == NULL)
+    {
+        munmap(cache_buffer, cache_size);
+        return GET_OPT_ERR_CACHE_MISS;
+    }
+
+    memcpy(snapshot, cache_buffer, cache_size);
+    munmap(cache_buffer, cache_size);
+
+    PRIV_OPT_IMG_HEADER* header = (PRIV_OPT_IMG_HEADER*)snapshot;
+    PRIV_OPT_IMG_RECORD* records = GET_OPT_IMG_RECORDS(snapshot);
+
+    for(int i = 0; i < option_number; i++)
+    {
+        OPT_DATA_TYPE cached_value = GetOptImageValue(&records[i], GET_OPT_IMG_POOL(snapshot));
+
+        // Blobs and reference strings must outlive the option store, as parsed ones do, so they go to the arena.
+        if(GET_OPT_IS_BLOB(records[i].var_type) || private_options[i].opt_str_mode != GET_OPT_STR_MODE_COPY)
+        {
+            size_t value_size = (GET_OPT_IS_BLOB(records[i].var_type) ? GetOptCodecValueSize(records[i].var_type, cached_value.custom) : strlen(cached_value.char_string) + 1);
+            void* arena_value = GetOptArenaAlloc(value_size);
+
+            if(arena_value == NULL)
+            {
+                free(snapshot);
+                return GET_OPT_ERR_CACHE_MISS;
+            }
+
+            cached_value.custom = memcpy(arena_value, cached_value.custom, value_size);
+        }
+
+        private_options[i].opt_provenance = records[i].provenance;
+        AssignValue(&private_options[i], cached_value);
+    }
+
+    verbose_flag = header->verbose_flag;
+    SetSeverityLogMask(verbose_flag == 0 ? SVRTY_LOG_MASK_OFF : SVRTY_LOG_MASK_ALL);
+    optind = header->next_arg_index;
+
+    header->key = ++snapshot_generation;
+    PublishOptionsSnapshot(snapshot);
+
+    return GET_OPT_SUCCESS;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Checks whether an options image (i.e. a cache file) is consistent with the
+///        current schema and with a given key.
+/// @param image Image start.
+/// @param image_size Image size.
+/// @param key Key the image must match.
+/// @return GET_OPT_ERR_CACHE_MISS if the image does not match, 0 otherwise.
+/////////////////////////////////////////////////////////////////////////////////////////
+int CheckOptionsImage(char* image, size_t image_size, uint64_t key)
+{
+    PRIV_OPT_IMG_HEADER* header = (PRIV_OPT_IMG_HEADER*)image;
+
+    if( CheckOptionsImageLayout(image, image_size) < 0      ||
+        header->key             != key                      ||
+        header->option_number   != (uint32_t)option_number  )
+    {
+        return GET_OPT_ERR_CACHE_MISS;
+    }
+
+    PRIV_OPT_IMG_RECORD* records = GET_OPT_IMG_RECORDS(image);
+    char* string_pool = GET_OPT_IMG_POOL(image);
+
+    for(int i = 0; i < option_number; i++)
+    {
+        if( records[i].var_type != private_options[i].pub_opt.opt_var_type ||
+            strcmp(string_pool + records[i].name_offset, (char*)private_options[i].pub_opt.opt_long) != 0)
+        {
+            return GET_OPT_ERR_CACHE_MISS;
+        }
+    }
+
+    return GET_OPT_SUCCESS;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+/// @brief Checks whether an options image is self-consistent, so that it can be
+///        read safely: sections fit in the image, every string offset points to a
+///        NUL-terminated string within the pool, and index slots point to records.
+/// @param image Image start.
+/// @param image_size Image size.
+/// @return GET_OPT_ERR_CACHE_MISS if the image is not consistent, 0 otherwise.
+/////////////////////////////////////////////////////////////////////////////////////
+int CheckOptionsImageLayout(char* image, size_t image_size)
+{
+    PRIV_OPT_IMG_HEADER* header = (PRIV_OPT_IMG_HEADER*)image;
+
+    if( image_size < sizeof(PRIV_OPT_IMG_HEADER)                ||
+        header->magic       != GET_OPT_IMG_MAGIC                ||
+        header->version     != GET_OPT_IMG_VERSION              ||
+        header->image_size  != image_size                       ||
+        header->index_size  == 0                                ||
+        (header->index_size & (header->index_size - 1)) != 0    ||
+        header->index_size  <= header->option_number            ||
+        (size_t)(GET_OPT_IMG_POOL(image) - image) > image_size  )
+    {
+        return GET_OPT_ERR_CACHE_MISS;
+    }
+
+    PRIV_OPT_IMG_RECORD* records = GET_OPT_IMG_RECORDS(image);
+    char* string_pool = GET_OPT_IMG_POOL(image);
+    size_t pool_size = image + image_size - string_pool;
+
+    for(uint32_t i = 0; i < header->option_number; i++)
+    {
+        if( CheckOptImageString(string_pool, pool_size, records[i].name_offset  ) < 0 ||
+            CheckOptImageString(string_pool, pool_size, records[i].detail_offset) < 0 )
+        {
+            return GET_OPT_ERR_CACHE_MISS;
+        }
+
+        // Removed records are checked as well, as codec types index the codec tables below.
+        if(CheckValidDataType(records[i].var_type) < 0 || (records[i].opt_char != '\0' && records[i].str_mode > GET_OPT_STR_MODE_MAX))
+        {
+            return GET_OPT_ERR_CACHE_MISS;
+        }
+
+        if( GET_OPT_IS_CODEC(records[i].var_type) &&
+            (   CheckOptImageBytes(string_pool, pool_size, records[i].value.str_offset        , records[i].var_type, false) < 0 ||
+                CheckOptImageBytes(string_pool, pool_size, records[i].min_value.str_offset    , records[i].var_type, true ) < 0 ||
+                CheckOptImageBytes(string_pool, pool_size, records[i].max_value.str_offset    , records[i].var_type, true ) < 0 ||
+                CheckOptImageBytes(string_pool, pool_size, records[i].default_value.str_offset, records[i].var_type, false) < 0 ))
+        {
+            return GET_OPT_ERR_CACHE_MISS;
+        }
+
+        if( records[i].var_type == GET_OPT_TYPE_CHAR_STRING &&
+            (   CheckOptImageString(string_pool, pool_size, records[i].value.str_offset        ) < 0 ||
+                CheckOptImageString(string_pool, pool_size, records[i].min_value.str_offset    ) < 0 ||
+                CheckOptImageString(string_pool, pool_size, records[i].max_value.str_offset    ) < 0 ||
+                CheckOptImageString(string_pool, pool_size, records[i].default_value.str_offset) < 0 ))
+        {
+            return GET_OPT_ERR_CACHE_MISS;
+        }
+    }
+
+    uint32_t* long_index = GET_OPT_IMG_INDEX(image);
+
+    for(uint32_t i = 0; i < header->index_size; i++)
+    {
+        if(long_index[i] > header->option_number)
+        {
+            return GET_OPT_ERR_CACHE_MISS;
+        }
+    }
+
+    return GET_OPT_SUCCESS;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+/// @brief Checks that an offset points to a NUL-terminated string within
+///        an image string pool.
+/// @param string_pool Image string pool.
+/// @param pool_size String pool size.
+/// @param string_offset Offset to be checked.
+/// @return GET_OPT_ERR_CACHE_MISS if not, 0 otherwise.
+/////////////////////////////////////////////////////////////////////////////
+int CheckOptImageString(char* string_pool, size_t pool_size, uint32_t string_offset)
+{
+    if(string_offset >= pool_size || memchr(string_pool + string_offset, '\0', pool_size - string_offset) == NULL)
+    {
+        return GET_OPT_ERR_CACHE_MISS;
+    }
+
+    return GET_OPT_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Checks that an offset points to a whole codec value within an image
+///        string pool.
+/// @param string_pool Image string pool.
+/// @param pool_size String pool size.
+/// @param bytes_offset Offset to be checked.
+/// @param var_type Option (codec) type.
+/// @param may_be_unset Whether the value may be missing (boundaries).
+/// @return GET_OPT_ERR_CACHE_MISS if not, 0 otherwise.
+//////////////////////////////////////////////////////////////////////////////
+int CheckOptImageBytes(char* string_pool, size_t pool_size, uint32_t bytes_offset, int var_type, bool may_be_unset)
+{
+    if(bytes_offset == GET_OPT_IMG_NO_VALUE)
+    {
+        return (may_be_unset ? GET_OPT_SUCCESS : GET_OPT_ERR_CACHE_MISS);
+    }
+
+    // Blob lengths can only be read once their length prefix is known to be within the pool.
+    size_t value_size = (GET_OPT_IS_BLOB(var_type) ? sizeof(PRIV_OPT_BLOB_VALUE) : GET_OPT_CODEC_OF(var_type)->value_size);
+
+    if(bytes_offset > pool_size || pool_size - bytes_offset < value_size)
+    {
+        return GET_OPT_ERR_CACHE_MISS;
+    }
+
+    // Blob values (unlike boundaries, which may be unset) hold every byte of their length.
+    if(GET_OPT_IS_BLOB(var_type))
+    {
+        PRIV_OPT_BLOB_VALUE* blob = (PRIV_OPT_BLOB_VALUE*)(string_pool + bytes_offset);
+
+        if(pool_size - bytes_offset - value_size < blob->data_length || (!may_be_unset && blob->data_length != blob->length))
+        {
+            return GET_OPT_ERR_CACHE_MISS;
+        }
+    }
+
+    return GET_OPT_SUCCESS;
+}
+
+/////////////////////////////////////////////////////////////////////
+/// @brief Gets the value stored in an options image record.
+/// @param record Image record.
+/// @param string_pool Image string pool.
+/// @return Value (strings point to the string pool).
+/////////////////////////////////////////////////////////////////////
+OPT_DATA_TYPE GetOptImageValue(PRIV_OPT_IMG_RECORD* record, char* string_pool)
+{
+    return GetOptImageTypedValue(record->var_type, &record->value, string_pool);
+}
+
+///////////////////////////////////////////////////////////////////////////
+/// @brief Gets a value stored in an options image (either the option
+///        value itself or one of its boundaries).
+/// @param var_type Option variable type.
+/// @param img_value Image value.
+/// @param string_pool Image string pool.
+/// @return Value (strings point to the string pool).
+///////////////////////////////////////////////////////////////////////////
+OPT_DATA_TYPE GetOptImageTypedValue(int var_type, PRIV_OPT_IMG_VALUE* img_value, char* string_pool)
+{
+    OPT_DATA_TYPE value = {0};
+
+    switch(var_type)
+    {
+        case GET_OPT_TYPE_INT:
+            value.integer = img_value->integer;
+        break;
+
+        case GET_OPT_TYPE_CHAR:
+            value.character = img_value->character;
+        break;
+
+        case GET_OPT_TYPE_FLOAT:
+            value.floating = img_value->floating;
+        break;
+
+        case GET_OPT_TYPE_DOUBLE:
+            value.doubling = img_value->doubling;
+        break;
+
+        case GET_OPT_TYPE_CHAR_STRING:
+            value.char_string = string_pool + img_value->str_offset;
+        break;
+
+        default:
+        {
+            if(GET_OPT_IS_CODEC(var_type) && img_value->str_offset != GET_OPT_IMG_NO_VALUE)
+            {
+                value.custom = string_pool + img_value->str_offset;
+            }
+        }
+        break;
+    }
+
+    return value;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Stores a value in an options image. Strings are copied to the string pool, except
+///        for the unbounded string sentinels, which are copied only once per image.
+/// @param builder Image being built.
+/// @param var_type Option variable type.
+/// @param value Value to be stored.
+/// @param img_value Where to store the value.
+/////////////////////////////////////////////////////////////////////////////////////////////
+void PutOptImageValue(PRIV_OPT_IMG_BUILDER* builder, int var_type, OPT_DATA_TYPE value, PRIV_OPT_IMG_VALUE* img_value)
+{
+    switch(var_type)
+    {
+        case GET_OPT_TYPE_INT:
+            img_value->integer = value.integer;
+        break;
+
+        case GET_OPT_TYPE_CHAR:
+            img_value->character = value.character;
+        break;
+
+        case GET_OPT_TYPE_FLOAT:
+            img_value->floating = value.floating;
+        break;
+
+        case GET_OPT_TYPE_DOUBLE:
+            img_value->doubling = value.doubling;
+        break;
+
+        case GET_OPT_TYPE_CHAR_STRING:
+            img_value->str_offset = PutOptImageString(builder, value.char_string);
+        break;
+
+        default:
+        {
+            if(GET_OPT_IS_CODEC(var_type))
+            {
+                img_value->str_offset = (value.custom == NULL ? GET_OPT_IMG_NO_VALUE : PutOptImageBytes(builder, value.custom, GetOptCodecValueSize(var_type, value.custom)));
+            }
+        }
+        break;
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Copies a string to an image string pool. If builder has no pool yet, only the
+///        pool size is computed, so that the same code can be used to size the image.
+/// @param builder Image being built (or sized).
+/// @param string String to be copied.
+/// @return Offset of the string within the pool.
+/////////////////////////////////////////////////////////////////////////////////////////
+uint32_t PutOptImageString(PRIV_OPT_IMG_BUILDER* builder, char* string)
+{
+    // Unbounded strings (SetOptionDefinitionStringNL) share a PATH_MAX long maximum.
+    if(string == max_str && builder->max_str_offset != UINT32_MAX)
+    {
+        return builder->max_str_offset;
+    }
+
+    uint32_t string_offset = builder->pool_offset;
+    int string_len = strlen(string);
+
+    if(builder->string_pool != NULL)
+    {
+        memcpy(builder->string_pool + string_offset, string, string_len + 1);
+    }
+
+    if(string == max_str)
+    {
+        builder->max_str_offset = string_offset;
+    }
+
+    builder->pool_offset += string_len + 1;
+
+    return string_offset;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+/// @brief Copies a codec value to an image string pool, aligned so that codecs can
+///        work on it in place. Sizes the pool only if builder has no pool yet.
+/// @param builder Image being built (or sized).
+/// @param bytes Value to be copied.
+/// @param byte_number Value size.
+/// @return Offset of the value within the pool.
+/////////////////////////////////////////////////////////////////////////////////////
+uint32_t PutOptImageBytes(PRIV_OPT_IMG_BUILDER* builder, void* bytes, size_t byte_number)
+{
+    uint32_t bytes_offset = (builder->pool_offset + sizeof(uint64_t) - 1) & ~(uint32_t)(sizeof(uint64_t) - 1);
+
+    if(builder->string_pool != NULL)
+    {
+        memcpy(builder->string_pool + bytes_offset, bytes, byte_number);
+    }
+
+    builder->pool_offset = bytes_offset + byte_number;
+
+    return bytes_offset;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Builds a position-independent image of the option schema and resolved values:
+///        a header, one fixed-size record per option, a long name hash index and a string
+///        pool. Strings are referenced by offsets, so the image can be mapped anywhere.
+/// @param key Key to be stored in the image header.
+/// @param image_size Where to store the image size.
+/// @return Heap-allocated image, NULL if it could not be allocated.
+///////////////////////////////////////////////////////////////////////////////////////////
+char* BuildOptionsImage(uint64_t key, size_t* image_size)
+{
+    // Same sizing rule as the registry long name index: at most half full.
+    uint32_t index_size = GET_OPT_SIZE_LONG_INDEX_MIN;
+
+    while(index_size < 2 * (uint32_t)option_number)
+    {
+        index_size *= 2;
+    }
+
+    // The first pass only sizes the string pool, the second one fills it in.
+    PRIV_OPT_IMG_RECORD size_record;
+    PRIV_OPT_IMG_BUILDER builder = {NULL, 0, UINT32_MAX};
+    char* image = NULL;
+
+    for(int pass = 0; pass < 2; pass++)
+    {
+        PRIV_OPT_IMG_RECORD* records = (image == NULL ? NULL : GET_OPT_IMG_RECORDS(image));
+        uint32_t* long_index = (image == NULL ? NULL : GET_OPT_IMG_INDEX(image));
+
+        for(int i = 0; i < option_number; i++)
+        {
+            PRIV_OPT_DEFINITION* priv_opt_def = &private_options[i];
+            PRIV_OPT_IMG_RECORD* record = (records == NULL ? &size_record : &records[i]);
+            int var_type = priv_opt_def->pub_opt.opt_var_type;
+
+            record->name_offset     = PutOptImageString(&builder, (char*)priv_opt_def->pub_opt.opt_long);
+            record->detail_offset   = PutOptImageString(&builder, (char*)priv_opt_def->pub_opt.opt_detail);
+            record->var_type        = var_type;
+            record->needs_arg       = priv_opt_def->pub_opt.opt_needs_arg;
+            record->opt_char        = priv_opt_def->pub_opt.opt_char;
+            record->provenance      = priv_opt_def->opt_provenance;
+            record->str_mode        = priv_opt_def->opt_str_mode;
+            record->str_max_length  = priv_opt_def->opt_str_max_length;
+
+            PutOptImageValue(&builder, var_type, priv_opt_def->opt_value                , &record->value        );
+            PutOptImageValue(&builder, var_type, priv_opt_def->pub_opt.opt_min_value    , &record->min_value    );
+            PutOptImageValue(&builder, var_type, priv_opt_def->pub_opt.opt_max_value    , &record->max_value    );
+            PutOptImageValue(&builder, var_type, priv_opt_def->pub_opt.opt_default_value, &record->default_value);
+
+            if(long_index == NULL || GET_OPT_IS_REMOVED(priv_opt_def))
+            {
+                continue;
+            }
+
+            uint32_t slot = GetOptHashLong((char*)priv_opt_def->pub_opt.opt_long, strlen((char*)priv_opt_def->pub_opt.opt_long)) & (index_size - 1);
+
+            while(long_index[slot] != 0)
+            {
+                slot = (slot + 1) & (index_size - 1);
+            }
+
+            long_index[slot] = i + 1;
+        }
+
+        if(image != NULL)
+        {
+            break;
+        }
+
+        *image_size = sizeof(PRIV_OPT_IMG_HEADER) + option_number * sizeof(PRIV_OPT_IMG_RECORD) + index_size * sizeof(uint32_t) + builder.pool_offset;
+        image = (char*)calloc(1, *image_size);
+
+        if(image == NULL)
+        {
+            return NULL;
+        }
+
+        PRIV_OPT_IMG_HEADER* header = (PRIV_OPT_IMG_HEADER*)image;
+
+        header->magic           = GET_OPT_IMG_MAGIC     ;
+        header->version         = GET_OPT_IMG_VERSION   ;
+        header->key             = key                   ;
+        header->option_number   = option_number         ;
+        header->index_size      = index_size            ;
+        header->image_size      = *image_size           ;
+        header->verbose_flag    = verbose_flag          ;
+        header->next_arg_index  = optind                ;
+
+        builder.string_pool     = GET_OPT_IMG_POOL(image);
+        builder.pool_offset     = 0;
+        builder.max_str_offset  = UINT32_MAX;
+    }
+
+    return image;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Writes the resolved option values to the cache file. The file is written
+///        under a temporary name first, then renamed, so readers never see partial data.
+/// @param cache_key Key the values have been resolved for.
+/// @return GET_OPT_ERR_CACHE_WRITE if the cache could not be written, 0 otherwise.
+/////////////////////////////////////////////////////////////////////////////////////////
+int SaveOptionsCache(uint64_t cache_key)
+{
+    size_t image_size;
+    char* image = BuildOptionsImage(cache_key, &image_size);
+
+    if(image == NULL)
+    {
+        return GET_OPT_ERR_CACHE_WRITE;
+    }
+
+    int save_result = WriteOptionsImageFile(cache_file_path, image, image_size);
+
+    free(image);
+
+    if(save_result < 0)
+    {
+        GET_OPT_LOG_DBG("FILE: %s\tFUNCTION: %s\tLINE: %d\tCACHE FILE: %s", __FILE__, __func__, __LINE__, cache_file_path);
+    }
+
+    return save_result;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Writes an options image to a file. The file is written under a temporary
+///        name first, then renamed, so readers never see partial data.
+/// @param file_path Target file path.
+/// @param image Image to be written.
+/// @param image_size Image size.
+/// @return GET_OPT_ERR_CACHE_WRITE if the file could not be written, 0 otherwise.
+/////////////////////////////////////////////////////////////////////////////////////////
+int WriteOptionsImageFile(char* file_path, char* image, size_t image_size)
+{
+    char tmp_path[PATH_MAX + sizeof(GET_OPT_CACHE_TMP_SUFFIX)];
+    snprintf(tmp_path, sizeof(tmp_path), "%s%s", file_path, GET_OPT_CACHE_TMP_SUFFIX);
+
+    int image_fd = open(tmp_path, O_WRONLY | O_CREAT | O_TRUNC, GET_OPT_CACHE_FILE_MODE);
+
+    if(image_fd < 0)
+    {
+        return GET_OPT_ERR_CACHE_WRITE;
+    }
+
+    int write_result = GET_OPT_SUCCESS;
+    size_t written = 0;
+
+    while(written < image_size)
+    {
+        ssize_t written_now = write(image_fd, image + written, image_size - written);
+
+        if(written_now <= 0)
+        {
+            write_result = GET_OPT_ERR_CACHE_WRITE;
+            break;
+        }
+
+        written += written_now;
+    }
+
+    close(image_fd);
+
+    if(write_result == GET_OPT_SUCCESS && rename(tmp_path, file_path) < 0)
+    {
+        write_result = GET_OPT_ERR_CACHE_WRITE;
+    }
+
+    if(write_result < 0)
+    {
+        unlink(tmp_path);
+    }
+
+    return write_result;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief Computes the checksum of an options image, as stored in its header
+///        key by schema files (the key itself is hashed as 0).
+/// @param image Image start.
+/// @param image_size Image size.
+/// @return Image checksum.
+///////////////////////////////////////////////////////////////////////////////
+uint64_t GetOptionsImageChecksum(char* image, size_t image_size)
+{
+    PRIV_OPT_IMG_HEADER header = *(PRIV_OPT_IMG_HEADER*)image;
+    header.key = 0;
+
+    uint64_t checksum = GetOptHash64(GET_OPT_HASH64_FNV_OFFSET, &header, sizeof(header));
+
+    return GetOptHash64(checksum, image + sizeof(PRIV_OPT_IMG_HEADER), image_size - sizeof(PRIV_OPT_IMG_HEADER));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Writes the options defined so far to a binary schema file: versioned header
+///        with a checksum, one record per option, a precomputed long name hash index and
+///        a string pool. LoadOptionsSchema loads it back without any per-option checks.
+/// @param schema_file_path Path to the schema file.
+/// @return < 0 if any error happened, 0 otherwise.
+////////////////////////////////////////////////////////////////////////////////////////////
+int SaveOptionsSchema(char* schema_file_path)
+{
+    if(schema_file_path == NULL || private_options == NULL)
+    {
+        ReportOptError(GET_OPT_ERR_NULL_PTR, -1, -1, '\0', NULL, NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+        return GET_OPT_ERR_NULL_PTR;
+    }
+
+    size_t image_size;
+    char* image = BuildOptionsImage(0, &image_size);
+
+    if(image == NULL)
+    {
+        ReportOptError(GET_OPT_ERR_NULL_PTR, -1, -1, '\0', NULL, NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+        return GET_OPT_ERR_NULL_PTR;
+    }
+
+    PRIV_OPT_IMG_HEADER* header = (PRIV_OPT_IMG_HEADER*)image;
+
+    header->magic           = GET_OPT_SCHEMA_MAGIC;
+    header->verbose_flag    = 0;
+    header->next_arg_index  = 0;
+    header->key             = GetOptionsImageChecksum(image, image_size);
+
+    int write_result = WriteOptionsImageFile(schema_file_path, image, image_size);
+
+    free(image);
+
+    if(write_result < 0)
+    {
+        ReportOptError(GET_OPT_ERR_SCHEMA_FILE, -1, -1, '\0', NULL, NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+        return GET_OPT_ERR_SCHEMA_FILE;
+    }
+
+    return GET_OPT_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Loads the option schema from a binary schema file (SaveOptionsSchema). The file is
+///        mapped and only its header checksum is validated: records are trusted, the hash
+///        index is adopted as is, and string boundaries and defaults point to the mapping.
+///        Loaded options are not bound to any variable (see BindOptionDestination), values
+///        can be read through the option store getters anyway.
+/// @param schema_file_path Path to the schema file.
+/// @return < 0 if any error happened, 0 otherwise.
+//////////////////////////////////////////////////////////////////////////////////////////////
+int LoadOptionsSchema(char* schema_file_path)
+{
+    // The schema is frozen as a whole, so it can only be loaded into an empty registry.
+    if(schema_file_path == NULL || private_options != NULL || schema_map.map_addr != NULL)
+    {
+        ReportOptError(GET_OPT_ERR_SCHEMA_FILE, -1, -1, '\0', NULL, NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+        return GET_OPT_ERR_SCHEMA_FILE;
+    }
+
+    int schema_fd = open(schema_file_path, O_RDONLY);
+    struct stat schema_stat;
+    char* image = MAP_FAILED;
+
+    if(schema_fd >= 0 && fstat(schema_fd, &schema_stat) == 0 && (size_t)schema_stat.st_size >= sizeof(PRIV_OPT_IMG_HEADER))
+    {
+        image = mmap(NULL, schema_stat.st_size, PROT_READ, MAP_PRIVATE, schema_fd, 0);
+    }
+
+    if(schema_fd >= 0)
+    {
+        close(schema_fd);
+    }
+
+    if(image == MAP_FAILED)
+    {
+        ReportOptError(GET_OPT_ERR_SCHEMA_FILE, -1, -1, '\0', NULL, NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+        return GET_OPT_ERR_SCHEMA_FILE;
+    }
+
+    size_t image_size = schema_stat.st_size;
+    PRIV_OPT_IMG_HEADER* header = (PRIV_OPT_IMG_HEADER*)image;
+
+    if( header->magic       != GET_OPT_SCHEMA_MAGIC ||
+        header->version     != GET_OPT_IMG_VERSION  ||
+        header->image_size  != image_size           ||
+        header->key         != GetOptionsImageChecksum(image, image_size))
+    {
+        munmap(image, image_size);
+        ReportOptError(GET_OPT_ERR_SCHEMA_FILE, -1, -1, '\0', NULL, NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+        return GET_OPT_ERR_SCHEMA_FILE;
+    }
+
+    long_name_index = (int*)malloc(header->index_size * sizeof(int));
+
+    if(ReserveOptionDefinitions(header->option_number) < 0 || long_name_index == NULL)
+    {
+        munmap(image, image_size);
+        ReportOptError(GET_OPT_ERR_NULL_PTR, -1, -1, '\0', NULL, NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+        FreeHeapOptData();
+        return GET_OPT_ERR_NULL_PTR;
+    }
+
+    InitOptMaxString();
+
+    PRIV_OPT_IMG_RECORD* records = GET_OPT_IMG_RECORDS(image);
+    uint32_t* image_index = GET_OPT_IMG_INDEX(image);
+    char* string_pool = GET_OPT_IMG_POOL(image);
+
+    // The image index uses the same hash and slot encoding (index + 1) as the registry one.
+    for(uint32_t i = 0; i < header->index_size; i++)
+    {
+        long_name_index[i] = image_index[i];
+        long_name_index_used += (image_index[i] != 0);
+    }
+
+    long_name_index_size = header->index_size;
+    option_number = header->option_number;
+
+    for(int i = 0; i < option_number; i++)
+    {
+        PRIV_OPT_DEFINITION* priv_opt_def = &private_options[i];
+        int var_type = records[i].var_type;
+
+        memset(priv_opt_def, 0, sizeof(PRIV_OPT_DEFINITION));
+
+        // Options removed before the schema was saved keep being tombstones.
+        if(records[i].opt_char == '\0')
+        {
+            free_option_slots[removed_option_number++] = i;
+            continue;
+        }
+
+        priv_opt_def->pub_opt.opt_char = records[i].opt_char;
+        strncpy((char*)priv_opt_def->pub_opt.opt_long  , string_pool + records[i].name_offset  , GET_OPT_SIZE_LONG_MAX  );
+        strncpy((char*)priv_opt_def->pub_opt.opt_detail, string_pool + records[i].detail_offset, GET_OPT_SIZE_DETAIL_MAX);
+
+        priv_opt_def->pub_opt.opt_var_type      = var_type;
+        priv_opt_def->pub_opt.opt_needs_arg     = records[i].needs_arg;
+        priv_opt_def->pub_opt.opt_min_value     = GetOptImageTypedValue(var_type, &records[i].min_value    , string_pool);
+        priv_opt_def->pub_opt.opt_max_value     = GetOptImageTypedValue(var_type, &records[i].max_value    , string_pool);
+        priv_opt_def->pub_opt.opt_default_value = GetOptImageTypedValue(var_type, &records[i].default_value, string_pool);
+        priv_opt_def->pub_opt.opt_dest_var      = NULL;
+
+        // Unbounded strings keep sharing the very same maximum, as summaries tell them apart by it.
+        if( var_type == GET_OPT_TYPE_CHAR_STRING && records[i].str_mode == GET_OPT_STR_MODE_COPY &&
+            strcmp(priv_opt_def->pub_opt.opt_max_value.char_string, max_str) == 0                   )
+        {
+            priv_opt_def->pub_opt.opt_max_value.char_string = max_str;
+        }
+
+        priv_opt_def->opt_value             = priv_opt_def->pub_opt.opt_default_value;
+        priv_opt_def->opt_provenance        = GET_OPT_PROV_BIT(GET_OPT_SRC_DEFAULT);
+        priv_opt_def->opt_str_mode          = records[i].str_mode;
+        priv_opt_def->opt_str_max_length    = records[i].str_max_length;
+
+        BindOptionConverter(priv_opt_def);
+
+        bool out_of_memory = false;
+
+        if(GET_OPT_IS_BLOB(var_type))
+        {
+            // Blob defaults end up pointed to by destinations, so they are not left within the schema mapping.
+            size_t default_size = GetOptCodecValueSize(var_type, priv_opt_def->opt_value.custom);
+            void* default_blob = GetOptArenaAlloc(default_size);
+
+            if(default_blob != NULL)
+            {
+                memcpy(default_blob, priv_opt_def->opt_value.custom, default_size);
+                priv_opt_def->pub_opt.opt_default_value.custom = default_blob;
+                priv_opt_def->opt_value.custom = default_blob;
+            }
+
+            out_of_memory = (default_blob == NULL);
+        }
+        else if(priv_opt_def->opt_str_mode != GET_OPT_STR_MODE_COPY)
+        {
+            // Same goes for reference string defaults, which views point to as they are.
+            size_t default_size = strlen(priv_opt_def->opt_value.char_string) + 1;
+            char* default_string = (char*)GetOptArenaAlloc(default_size);
+
+            if(default_string != NULL)
+            {
+                memcpy(default_string, priv_opt_def->opt_value.char_string, default_size);
+                priv_opt_def->pub_opt.opt_default_value.char_string = default_string;
+                priv_opt_def->opt_value.char_string = default_string;
+            }
+
+            out_of_memory = (default_string == NULL);
+        }
+        else if(GET_OPT_IS_CODEC(var_type))
+        {
+            priv_opt_def->opt_codec_values = (char*)calloc(2, GET_OPT_CODEC_OF(var_type)->value_size);
+            out_of_memory = (priv_opt_def->opt_codec_values == NULL);
+        }
+
+        if(out_of_memory || AddOptionDispatch(i) < 0)
+        {
+            munmap(image, image_size);
+            ReportOptError(GET_OPT_ERR_NULL_PTR, -1, -1, '\0', NULL, NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+            FreeHeapOptData();
+            return GET_OPT_ERR_NULL_PTR;
+        }
+    }
+
+    schema_map.map_addr = image;
+    schema_map.map_size = image_size;
+
+    return GET_OPT_SUCCESS;
+}
+
+/////////////////////////////////////////////////////////////////////////////////
+/// @brief Binds an already defined option (i.e. loaded from a schema file) to a
+///        destination variable, which is set once options are parsed.
+/// @param opt_long Option long name.
+/// @param opt_dest_var Destination variable address.
+/// @return < 0 if any error happened, 0 otherwise.
+/////////////////////////////////////////////////////////////////////////////////
+int BindOptionDestination(char* opt_long, void* opt_dest_var)
+{
+    if(opt_long == NULL || opt_dest_var == NULL || private_options == NULL)
+    {
+        ReportOptError(GET_OPT_ERR_NULL_PTR, -1, -1, '\0', NULL, NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+        return GET_OPT_ERR_NULL_PTR;
+    }
+
+    int option_index = GetOptionIndexFromLong(opt_long, strlen(opt_long));
+
+    if(option_index < 0)
+    {
+        ReportOptError(GET_OPT_ERR_UNKNOWN_OPTION, -1, -1, '\0', opt_long, NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+        return GET_OPT_ERR_UNKNOWN_OPTION;
+    }
+
+    private_options[option_index].pub_opt.opt_dest_var = opt_dest_var;
+
+    return GET_OPT_SUCCESS;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Enables or disables reload mode. In reload mode, ParseOptions keeps the option
+///        schema and publishes resolved values as an immutable snapshot, so that options
+///        can be parsed again later on (ReloadOptions) without restarting.
+/// @param enable 0 to disable reload mode, anything else to enable it.
+///////////////////////////////////////////////////////////////////////////////////////////
+void SetOptionsReloadMode(int enable)
+{
+    reload_mode = (enable != 0);
+}
+
+//////////////////////////////////////////////////////////////////////////////////////
+/// @brief Requests options to be reloaded. Async-signal-safe: it only sets a flag, so
+///        it can be installed as a SIGHUP handler (i.e. signal(SIGHUP, ...)).
+/// @param signum Signal number (unused).
+//////////////////////////////////////////////////////////////////////////////////////
+void RequestOptionsReload(int signum)
+{
+    (void)signum;
+    reload_requested = 1;
+}
+
+///////////////////////////////////////////////////////////////////////////////////
+/// @brief Reloads options if a reload has been requested (RequestOptionsReload).
+///        Meant to be polled from the service main loop, never from the handler.
+/// @return < 0 if any error happened, number of changed options otherwise.
+///////////////////////////////////////////////////////////////////////////////////
+int PollOptionsReload(void)
+{
+    if(!reload_requested)
+    {
+        return 0;
+    }
+
+    reload_requested = 0;
+
+    return ReloadOptions();
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Parses config files, environment variables and argv again into a new snapshot,
+///        compares it to the current one and publishes it with a single atomic pointer swap.
+///        Destination variables of changed options are updated as well. The current snapshot
+///        is kept if anything goes wrong. Must not be called by more than one thread at once.
+/// @return < 0 if any error happened, number of changed options otherwise.
+//////////////////////////////////////////////////////////////////////////////////////////////
+int ReloadOptions(void)
+{
+    char* old_snapshot = atomic_load(&current_snapshot);
+
+    if(!reload_mode || private_options == NULL || old_snapshot == NULL)
+    {
+        ReportOptError(GET_OPT_ERR_RELOAD_MODE, -1, -1, '\0', NULL, NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+        return GET_OPT_ERR_RELOAD_MODE;
+    }
+
+    // Start over from default values, then stage every source again, just as ParseOptions does.
+    for(int i = 0; i < option_number; i++)
+    {
+        private_options[i].opt_value        = private_options[i].pub_opt.opt_default_value;
+        private_options[i].opt_provenance   = GET_OPT_PROV_BIT(GET_OPT_SRC_DEFAULT);
+    }
+
+    memset(seen_options, 0, GET_OPT_BITSET_WORDS(option_number) * sizeof(uint64_t));
+
+    int remap_config_files = RemapConfigFiles();
+
+    if(remap_config_files < 0)
+    {
+        ReportOptError(remap_config_files, -1, -1, '\0', NULL, NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+        return remap_config_files;
+    }
+
+    int apply_config_files = ApplyConfigFiles();
+
+    if(apply_config_files < 0)
+    {
+        return apply_config_files;
+    }
+
+    int apply_environment_options = ApplyEnvironmentOptions();
+
+    if(apply_environment_options < 0)
+    {
+        return apply_environment_options;
+    }
+
+    // Setting optind to 0 makes getopt reinitialize itself, so argv can be scanned once more.
+    optind = 0;
+
+    int parse_argv_options = ParseArgvOptions(retained_argc, retained_argv, long_options_table);
+
+    if(parse_argv_options < 0)
+    {
+        return parse_argv_options;
+    }
+
+    int check_options_constraints = CheckOptionsConstraints();
+
+    if(check_options_constraints < 0)
+    {
+        return check_options_constraints;
+    }
+
+    size_t image_size;
+    char* new_snapshot = BuildOptionsImage(++snapshot_generation, &image_size);
+
+    if(new_snapshot == NULL)
+    {
+        ReportOptError(GET_OPT_ERR_NULL_PTR, -1, -1, '\0', NULL, NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+        return GET_OPT_ERR_NULL_PTR;
+    }
+
+    int changed_options = 0;
+
+    uint32_t old_option_number = ((PRIV_OPT_IMG_HEADER*)old_snapshot)->option_number;
+
+    for(int i = 0; i < option_number; i++)
+    {
+        // Options defined since the last snapshot count as changed, removed ones are just left out.
+        if(GET_OPT_IS_REMOVED(&private_options[i]))
+        {
+            continue;
+        }
+
+        if((uint32_t)i >= old_option_number || CompareOptionsImageRecord(old_snapshot, new_snapshot, i) != 0)
+        {
+            // Unchanged reference strings keep pointing to what they were pinned to, so only changed ones grow the arena.
+            if(PinOptionValue(&private_options[i]) < 0)
+            {
+                free(new_snapshot);
+                ReportOptError(GET_OPT_ERR_NULL_PTR, -1, -1, '\0', NULL, NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+                return GET_OPT_ERR_NULL_PTR;
+            }
+
+            AssignValue(&private_options[i], private_options[i].opt_value);
+            SVRTY_LOG_INF(GET_OPT_MSG_OPTION_RELOADED, private_options[i].pub_opt.opt_char, (char*)private_options[i].pub_opt.opt_long);
+            changed_options++;
+        }
+    }
+
+    PublishOptionsSnapshot(new_snapshot);
+
+    int retain_provenance = RetainOptionsProvenance();
+
+    return (retain_provenance < 0 ? retain_provenance : changed_options);
+}
+
+//////////////////////////////////////////////////////////////////////////////////////
+/// @brief Maps every loaded config file again, so that reloads see current contents.
+///        Mappings are replaced one by one, only once the new one is in place.
+/// @return GET_OPT_ERR_CONFIG_FILE if any file could not be mapped, 0 otherwise.
+//////////////////////////////////////////////////////////////////////////////////////
+int RemapConfigFiles(void)
+{
+    for(int i = 0; i < config_map_number; i++)
+    {
+        PRIV_CONFIG_MAP config_map;
+
+        int map_config_file = MapConfigFile(config_maps[i].file_path, &config_map);
+
+        if(map_config_file < 0)
+        {
+            return map_config_file;
+        }
+
+        munmap(config_maps[i].map_addr, config_maps[i].map_size);
+        config_map.file_path = config_maps[i].file_path;
+        config_maps[i] = config_map;
+    }
+
+    return GET_OPT_SUCCESS;
+}
+
+///////////////////////////////////////////////////////////////////////////
+/// @brief Compares the value of an option within two options images.
+/// @param image_a First image.
+/// @param image_b Second image.
+/// @param option_index Index of the option within both images.
+/// @return 0 if both values are the same, anything else otherwise.
+///////////////////////////////////////////////////////////////////////////
+int CompareOptionsImageRecord(char* image_a, char* image_b, int option_index)
+{
+    PRIV_OPT_IMG_RECORD* records_a = GET_OPT_IMG_RECORDS(image_a);
+    PRIV_OPT_IMG_RECORD* records_b = GET_OPT_IMG_RECORDS(image_b);
+    OPT_DATA_TYPE value_a = GetOptImageValue(&records_a[option_index], GET_OPT_IMG_POOL(image_a));
+    OPT_DATA_TYPE value_b = GetOptImageValue(&records_b[option_index], GET_OPT_IMG_POOL(image_b));
+
+    return CompareOptValue(records_a[option_index].var_type, value_a, value_b);
+}
+
+//////////////////////////////////////////////////////////////////
+/// @brief Compares two values of the same option type.
+/// @param var_type Option type.
+/// @param value_a First value.
+/// @param value_b Second value.
+/// @return != 0 if values are different, 0 otherwise.
+//////////////////////////////////////////////////////////////////
+int CompareOptValue(int var_type, OPT_DATA_TYPE value_a, OPT_DATA_TYPE value_b)
+{
+    switch(var_type)
+    {
+        case GET_OPT_TYPE_INT:
+            return (value_a.integer != value_b.integer);
+
+        case GET_OPT_TYPE_CHAR:
+            return (value_a.character != value_b.character);
+
+        case GET_OPT_TYPE_FLOAT:
+            return (value_a.floating != value_b.floating);
+
+        case GET_OPT_TYPE_DOUBLE:
+            return (value_a.doubling != value_b.doubling);
+
+        case GET_OPT_TYPE_CHAR_STRING:
+            return strcmp(value_a.char_string, value_b.char_string);
+
+        default:
+        {
+            if(GET_OPT_IS_CODEC(var_type))
+            {
+                // Unset codec values (boundaries) are only equal to each other.
+                if(value_a.custom == NULL || value_b.custom == NULL)
+                    return (value_a.custom != value_b.custom);
+
+                size_t value_size = GetOptCodecValueSize(var_type, value_a.custom);
+
+                if(value_size != GetOptCodecValueSize(var_type, value_b.custom))
+                    return 1;
+
+                return memcmp(value_a.custom, value_b.custom, value_size);
+            }
+        }
+        break;
+    }
+
+    return 0;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Publishes a snapshot with a single atomic pointer swap. The previous one is
+///        retired with the epoch readers must have moved past before it can be freed.
+/// @param snapshot Snapshot to be published (heap-allocated options image).
+/////////////////////////////////////////////////////////////////////////////////////////
+void PublishOptionsSnapshot(char* snapshot)
+{
+    char* old_snapshot = atomic_exchange(&current_snapshot, snapshot);
+
+    if(old_snapshot == NULL)
+    {
+        return;
+    }
+
+    // Readers announcing this epoch (or a later one) are guaranteed to load the new snapshot.
+    unsigned long retire_epoch = atomic_fetch_add(&global_epoch, 1) + 1;
+
+    PRIV_OPT_RETIRED* new_retired_snapshots = (PRIV_OPT_RETIRED*)realloc(retired_snapshots, (retired_snapshot_number + 1) * sizeof(PRIV_OPT_RETIRED));
+
+    if(new_retired_snapshots == NULL)
+    {
+        // Leaking a snapshot is preferable to freeing one a reader may still be using.
+        GET_OPT_LOG_DBG(GET_OPT_MSG_NULL_PTR);
+        return;
+    }
+
+    retired_snapshots = new_retired_snapshots;
+    retired_snapshots[retired_snapshot_number].snapshot     = old_snapshot;
+    retired_snapshots[retired_snapshot_number].retire_epoch = retire_epoch;
+    retired_snapshot_number++;
+
+    ReclaimOptionsSnapshots();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Frees retired snapshots no reader can be using anymore, that is, the ones
+///        retired before the oldest epoch announced by readers within a read section.
+////////////////////////////////////////////////////////////////////////////////////////
+void ReclaimOptionsSnapshots(void)
+{
+    unsigned long oldest_reader_epoch = ULONG_MAX;
+
+    for(int i = 0; i < GET_OPT_SIZE_READER_SLOTS; i++)
+    {
+        unsigned long reader_epoch = atomic_load(&reader_epochs[i]);
+
+        if(reader_epoch != 0 && reader_epoch < oldest_reader_epoch)
+        {
+            oldest_reader_epoch = reader_epoch;
+        }
+    }
+
+    int kept_snapshots = 0;
+
+    for(int i = 0; i < retired_snapshot_number; i++)
+    {
+        if(retired_snapshots[i].retire_epoch <= oldest_reader_epoch)
+        {
+            FreeOptionsSnapshot(retired_snapshots[i].snapshot);
+        }
+        else
+        {
+            retired_snapshots[kept_snapshots++] = retired_snapshots[i];
+        }
+    }
+
+    retired_snapshot_number = kept_snapshots;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Enters a read section: the snapshot loaded within it (see AcquireOptionsSnapshot)
+///        is not freed until the section is left. Read sections can be nested.
+/// @return GET_OPT_ERR_READER_SLOTS if too many threads are reading at once, 0 otherwise.
+//////////////////////////////////////////////////////////////////////////////////////////
+int OptionsReadLock(void)
+{
+    if(reader_nesting++ > 0)
+    {
+        return GET_OPT_SUCCESS;
+    }
+
+    // Each thread claims a slot the first time it reads, then keeps it until ReleaseOptionsReader.
+    for(int i = 0; reader_slot < 0 && i < GET_OPT_SIZE_READER_SLOTS; i++)
+    {
+        int slot_free = 0;
+
+        if(atomic_compare_exchange_strong(&reader_slots_used[i], &slot_free, 1))
+        {
+            reader_slot = i;
+        }
+    }
+
+    if(reader_slot < 0)
+    {
+        reader_nesting--;
+        ReportOptError(GET_OPT_ERR_READER_SLOTS, -1, -1, '\0', NULL, NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+        return GET_OPT_ERR_READER_SLOTS;
+    }
+
+    // Announce the epoch before loading the snapshot pointer (both sequentially consistent).
+    atomic_store(&reader_epochs[reader_slot], atomic_load(&global_epoch));
+
+    return GET_OPT_SUCCESS;
+}
+
+//////////////////////////////////////////////
+/// @brief Leaves a read section (quiescence).
+//////////////////////////////////////////////
+void OptionsReadUnlock(void)
+{
+    if(reader_nesting <= 0 || --reader_nesting > 0)
+    {
+        return;
+    }
+
+    atomic_store(&reader_epochs[reader_slot], 0);
+}
+
+/////////////////////////////////////////////////////////////////////////////////
+/// @brief Releases the reader slot claimed by the calling thread. Meant to be
+///        called by reader threads before exiting.
+/////////////////////////////////////////////////////////////////////////////////
+void ReleaseOptionsReader(void)
+{
+    if(reader_slot < 0)
+    {
+        return;
+    }
+
+    reader_nesting = 0;
+    atomic_store(&reader_epochs[reader_slot], 0);
+    atomic_store(&reader_slots_used[reader_slot], 0);
+    reader_slot = -1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Gets the current snapshot. Must be called within a read section.
+/// @return Current snapshot, NULL if none has been published.
+////////////////////////////////////////////////////////////////////////////////
+char* AcquireOptionsSnapshot(void)
+{
+    return atomic_load(&current_snapshot);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Copies the current value of an option (from the published snapshot) into value.
+///        Blobs and reference strings point into the snapshot, which a reload may free
+///        as soon as the read section is left, so they are only read within the caller's.
+/// @param opt_long Option long name.
+/// @param value Where to copy the value to. Same type as the option destination variable.
+/// @return GET_OPT_ERR_READ_SECTION if the value points into the snapshot and the caller
+///         is not within a read section, < 0 if any other error happened, 0 otherwise.
+///////////////////////////////////////////////////////////////////////////////////////////
+int ReadOptionValue(char* opt_long, void* value)
+{
+    if(value == NULL)
+    {
+        return GET_OPT_ERR_NULL_PTR;
+    }
+
+    bool caller_read_section = (reader_nesting > 0);
+    int options_read_lock = OptionsReadLock();
+
+    if(options_read_lock < 0)
+    {
+        return options_read_lock;
+    }
+
+    int opt_handle = GetOptHandle(opt_long);
+
+    if(opt_handle < 0)
+    {
+        OptionsReadUnlock();
+        return opt_handle;
+    }
+
+    char* snapshot = AcquireOptionsSnapshot();
+    PRIV_OPT_IMG_RECORD* record = &GET_OPT_IMG_RECORDS(snapshot)[opt_handle];
+
+    if(!caller_read_section && (GET_OPT_IS_BLOB(record->var_type) || (record->var_type == GET_OPT_TYPE_CHAR_STRING && record->str_mode != GET_OPT_STR_MODE_COPY)))
+    {
+        OptionsReadUnlock();
+        ReportOptError(GET_OPT_ERR_READ_SECTION, -1, -1, '\0', opt_long, NULL, record->var_type, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+        return GET_OPT_ERR_READ_SECTION;
+    }
+
+    // Same layout as destination variables (bool for boolean options).
+    PRIV_OPT_DEFINITION value_def = {0};
+    value_def.pub_opt.opt_var_type  = record->var_type;
+    value_def.pub_opt.opt_needs_arg = record->needs_arg;
+    value_def.pub_opt.opt_dest_var  = value;
+    value_def.opt_flag_mask         = 0;
+    value_def.opt_str_mode          = record->str_mode;
+    AssignValue(&value_def, GetOptImageValue(record, GET_OPT_IMG_POOL(snapshot)));
+
+    OptionsReadUnlock();
+
+    return GET_OPT_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Looks up an option long name within an options image hash index.
+/// @param image Options image.
+/// @param opt_long Option long name.
+/// @return GET_OPT_ERR_UNKNOWN_OPTION if not found, option index within the image otherwise.
+//////////////////////////////////////////////////////////////////////////////////////////
+int GetOptImageIndex(char* image, char* opt_long)
+{
+    PRIV_OPT_IMG_HEADER* header = (PRIV_OPT_IMG_HEADER*)image;
+    PRIV_OPT_IMG_RECORD* records = GET_OPT_IMG_RECORDS(image);
+    uint32_t* long_index = GET_OPT_IMG_INDEX(image);
+    char* string_pool = GET_OPT_IMG_POOL(image);
+    uint32_t slot = GetOptHashLong(opt_long, strlen(opt_long)) & (header->index_size - 1);
+
+    while(long_index[slot] != 0)
+    {
+        if(strcmp(string_pool + records[long_index[slot] - 1].name_offset, opt_long) == 0)
+        {
+            return long_index[slot] - 1;
+        }
+
+        slot = (slot + 1) & (header->index_size - 1);
+    }
+
+    return GET_OPT_ERR_UNKNOWN_OPTION;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Gets the handle of an option within the option store. Handles stay valid
+///        across reloads, so they are meant to be resolved once and kept.
+/// @param opt_long Option long name.
+/// @return < 0 if the option is not found or no option store exists, handle otherwise.
+/////////////////////////////////////////////////////////////////////////////////////////
+int GetOptHandle(char* opt_long)
+{
+    if(opt_long == NULL)
+    {
+        return GET_OPT_ERR_NULL_PTR;
+    }
+
+    int options_read_lock = OptionsReadLock();
+
+    if(options_read_lock < 0)
+    {
+        return options_read_lock;
+    }
+
+    char* snapshot = AcquireOptionsSnapshot();
+    int opt_handle = (snapshot == NULL ? GET_OPT_ERR_NO_OPT_STORE : GetOptImageIndex(snapshot, opt_long));
+
+    OptionsReadUnlock();
+
+    return opt_handle;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+/// @brief Gets the current value of an option from the option store, in O(1) and
+///        without locking (only a read section is entered). Strings, blobs and codec
+///        values point into the snapshot, which a reload may free as soon as the read
+///        section is left, so in reload mode they are only read within the caller's.
+/// @param opt_handle Option handle (see GetOptHandle).
+/// @param var_type Expected variable type.
+/// @return Option value, zeroed if the handle or type do not match, or if the value
+///         points into the snapshot and the caller is not within a read section.
+/////////////////////////////////////////////////////////////////////////////////////
+OPT_DATA_TYPE GetOptStoreValue(int opt_handle, int var_type)
+{
+    OPT_DATA_TYPE value = {0};
+    bool caller_read_section = (reader_nesting > 0);
+
+    if(OptionsReadLock() < 0)
+    {
+        return value;
+    }
+
+    char* snapshot = AcquireOptionsSnapshot();
+
+    if( snapshot != NULL                                                            &&
+        opt_handle >= 0                                                             &&
+        (uint32_t)opt_handle < ((PRIV_OPT_IMG_HEADER*)snapshot)->option_number      &&
+        GET_OPT_IMG_RECORDS(snapshot)[opt_handle].var_type == var_type              )
+    {
+        PRIV_OPT_IMG_RECORD* record = &GET_OPT_IMG_RECORDS(snapshot)[opt_handle];
+
+        if(reload_mode && !caller_read_section && (var_type == GET_OPT_TYPE_CHAR_STRING || GET_OPT_IS_CODEC(var_type)))
+        {
+            // Reported before leaving the read section, since the long name lives in the snapshot as well.
+            ReportOptError(GET_OPT_ERR_READ_SECTION, -1, -1, '\0', GET_OPT_IMG_POOL(snapshot) + record->name_offset, NULL, var_type, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+            OptionsReadUnlock();
+            return value;
+        }
+
+        value = GetOptImageValue(record, GET_OPT_IMG_POOL(snapshot));
+    }
+
+    OptionsReadUnlock();
+
+    return value;
+}
+
+int GetOptInt(int opt_handle)
+{
+    return GetOptStoreValue(opt_handle, GET_OPT_TYPE_INT).integer;
+}
+
+bool GetOptBool(int opt_handle)
+{
+    return (GetOptStoreValue(opt_handle, GET_OPT_TYPE_INT).integer != 0);
+}
+
+char GetOptChar(int opt_handle)
+{
+    return GetOptStoreValue(opt_handle, GET_OPT_TYPE_CHAR).character;
+}
+
+float GetOptFloat(int opt_handle)
+{
+    return GetOptStoreValue(opt_handle, GET_OPT_TYPE_FLOAT).floating;
+}
+
+double GetOptDouble(int opt_handle)
+{
+    return GetOptStoreValue(opt_handle, GET_OPT_TYPE_DOUBLE).doubling;
+}
+
+char* GetOptString(int opt_handle)
+{
+    return GetOptStoreValue(opt_handle, GET_OPT_TYPE_CHAR_STRING).char_string;
+}
+
+void* GetOptCodecValue(int opt_handle, int opt_codec_type)
+{
+    return (GET_OPT_IS_CODEC(opt_codec_type) ? GetOptStoreValue(opt_handle, opt_codec_type).custom : NULL);
+}
+
+struct sockaddr_storage* GetOptEndpoint(int opt_handle)
+{
+    return (struct sockaddr_storage*)GetOptCodecValue(opt_handle, GET_OPT_TYPE_ENDPOINT);
+}
+
+GET_OPT_BLOB GetOptBlob(int opt_handle)
+{
+    PRIV_OPT_BLOB_VALUE* blob = (PRIV_OPT_BLOB_VALUE*)GetOptStoreValue(opt_handle, GET_OPT_TYPE_BLOB_HEX).custom;
+
+    if(blob == NULL)
+    {
+        blob = (PRIV_OPT_BLOB_VALUE*)GetOptStoreValue(opt_handle, GET_OPT_TYPE_BLOB_BASE64).custom;
+    }
+
+    return (blob == NULL ? (GET_OPT_BLOB){0} : (GET_OPT_BLOB){blob->data, blob->length});
+}
+
+//////////////////////////////////////////////////////////////////////////////////////
+/// @brief Frees the option store (every snapshot). No reader may be within a read
+///        section when this is called.
+//////////////////////////////////////////////////////////////////////////////////////
+void FreeOptionsStore(void)
+{
+    FreeOptionsSnapshot(atomic_exchange(&current_snapshot, NULL));
+
+    for(int i = 0; i < retired_snapshot_number; i++)
+    {
+        FreeOptionsSnapshot(retired_snapshots[i].snapshot);
+    }
+
+    free(retired_snapshots);
+    retired_snapshots = NULL;
+    retired_snapshot_number = 0;
+
+    free(shared_images);
+    shared_images = NULL;
+    shared_image_number = 0;
+
+    // Handles are no longer valid, so removals made while the store was published can be compacted.
+    CompactSparseOptionDefinitions();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Frees a snapshot, either heap-allocated or attached shared memory.
+/// @param snapshot Snapshot to be freed. Nothing is done if NULL.
+////////////////////////////////////////////////////////////////////////////////
+void FreeOptionsSnapshot(char* snapshot)
+{
+    if(snapshot == NULL)
+    {
+        return;
+    }
+
+    for(int i = 0; i < shared_image_number; i++)
+    {
+        if(shared_images[i] == snapshot)
+        {
+            munmap(snapshot, ((PRIV_OPT_IMG_HEADER*)snapshot)->image_size);
+            shared_images[i] = shared_images[--shared_image_number];
+            return;
+        }
+    }
+
+    free(snapshot);
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Prepares the export of the option store: every JSON key (,"long":) is escaped
+///        once, here, within a single allocation, so that exports only copy them.
+/// @param opt_export Export to be initialized.
+/// @return < 0 if any error happened, 0 otherwise.
+//////////////////////////////////////////////////////////////////////////////////////////
+int InitOptionsExport(GET_OPT_EXPORT* opt_export)
+{
+    if(opt_export == NULL)
+    {
+        ReportOptError(GET_OPT_ERR_NULL_PTR, -1, -1, '\0', NULL, NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+        return GET_OPT_ERR_NULL_PTR;
+    }
+
+    int options_read_lock = OptionsReadLock();
+
+    if(options_read_lock < 0)
+    {
+        return options_read_lock;
+    }
+
+    char* snapshot = AcquireOptionsSnapshot();
+
+    if(snapshot == NULL)
+    {
+        OptionsReadUnlock();
+        ReportOptError(GET_OPT_ERR_NO_OPT_STORE, -1, -1, '\0', NULL, NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+        return GET_OPT_ERR_NO_OPT_STORE;
+    }
+
+    int snapshot_option_number = ((PRIV_OPT_IMG_HEADER*)snapshot)->option_number;
+    PRIV_OPT_IMG_RECORD* records = GET_OPT_IMG_RECORDS(snapshot);
+    char* string_pool = GET_OPT_IMG_POOL(snapshot);
+
+    // The first pass only sizes the keys, the second one escapes them.
+    PRIV_OPT_EXPORT_WRITER writer = {NULL, SIZE_MAX, 0};
+    uint32_t* key_offsets = NULL;
+
+    for(int pass = 0; pass < 2; pass++)
+    {
+        for(int i = 0; i < snapshot_option_number; i++)
+        {
+            char* opt_long = string_pool + records[i].name_offset;
+
+            if(key_offsets != NULL)
+            {
+                key_offsets[i] = writer.length;
+            }
+
+            // Removed options get an empty key, and are skipped.
+            if(records[i].opt_char == '\0')
+            {
+                continue;
+            }
+
+            PutOptExportBytes(&writer, ",", (writer.length > 0));
+            PutOptJsonString(&writer, opt_long, strlen(opt_long));
+            PutOptExportBytes(&writer, ":", 1);
+        }
+
+        if(key_offsets != NULL)
+        {
+            key_offsets[snapshot_option_number] = writer.length;
+            break;
+        }
+
+        key_offsets = (uint32_t*)malloc((snapshot_option_number + 1) * sizeof(uint32_t) + writer.length);
+
+        if(key_offsets == NULL)
+        {
+            OptionsReadUnlock();
+            ReportOptError(GET_OPT_ERR_NULL_PTR, -1, -1, '\0', NULL, NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+            return GET_OPT_ERR_NULL_PTR;
+        }
+
+        writer.buffer = (char*)(key_offsets + snapshot_option_number + 1);
+        writer.buffer_size = writer.length;
+        writer.length = 0;
+    }
+
+    OptionsReadUnlock();
+
+    opt_export->option_number   = snapshot_option_number;
+    opt_export->key_offsets     = key_offsets;
+    opt_export->keys            = writer.buffer;
+
+    return GET_OPT_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Writes the current option values as compact JSON, in a single pass over the
+///        current snapshot. Keys are copied as they were escaped by InitOptionsExport.
+/// @param opt_export Export initialized by InitOptionsExport.
+/// @param buffer Destination buffer.
+/// @param buffer_size Destination buffer size.
+/// @return < 0 if any error happened, JSON length otherwise (NUL-terminated).
+//////////////////////////////////////////////////////////////////////////////////////////
+int ExportOptionsJson(GET_OPT_EXPORT* opt_export, char* buffer, size_t buffer_size)
+{
+    if(opt_export == NULL || opt_export->key_offsets == NULL || buffer == NULL)
+    {
+        ReportOptError(GET_OPT_ERR_NULL_PTR, -1, -1, '\0', NULL, NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+        return GET_OPT_ERR_NULL_PTR;
+    }
+
+    int options_read_lock = OptionsReadLock();
+
+    if(options_read_lock < 0)
+    {
+        return options_read_lock;
+    }
+
+    char* snapshot = AcquireOptionsSnapshot();
+
+    // Keys only match stores with the same schema (i.e. not a different one attached since).
+    if(snapshot == NULL || ((PRIV_OPT_IMG_HEADER*)snapshot)->option_number != (uint32_t)opt_export->option_number)
+    {
+        OptionsReadUnlock();
+        ReportOptError(GET_OPT_ERR_NO_OPT_STORE, -1, -1, '\0', NULL, NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+        return GET_OPT_ERR_NO_OPT_STORE;
+    }
+
+    PRIV_OPT_IMG_RECORD* records = GET_OPT_IMG_RECORDS(snapshot);
+    char* string_pool = GET_OPT_IMG_POOL(snapshot);
+    uint32_t* key_offsets = opt_export->key_offsets;
+
+    // One byte is kept for the terminating NUL.
+    PRIV_OPT_EXPORT_WRITER writer = {buffer, buffer_size - (buffer_size > 0), 0};
+    bool fits = PutOptExportBytes(&writer, "{", 1);
+
+    for(int i = 0; fits && i < opt_export->option_number; i++)
+    {
+        if(records[i].opt_char == '\0')
+        {
+            continue;
+        }
+
+        fits = (PutOptExportBytes(&writer, opt_export->keys + key_offsets[i], key_offsets[i + 1] - key_offsets[i])  &&
+                PutOptJsonValue(&writer, &records[i], GetOptImageValue(&records[i], string_pool))                   );
+    }
+
+    fits = (fits && PutOptExportBytes(&writer, "}", 1));
+
+    OptionsReadUnlock();
+
+    if(!fits)
+    {
+        ReportOptError(GET_OPT_ERR_EXPORT_SIZE, -1, (int)writer.length, '\0', NULL, NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+        return GET_OPT_ERR_EXPORT_SIZE;
+    }
+
+    buffer[writer.length] = '\0';
+
+    return (int)writer.length;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Writes the current option values as a fixed-layout binary record, in a single
+///        pass: slots are filled in order, while string and codec bytes are appended
+///        right after them.
+/// @param opt_export Export initialized by InitOptionsExport.
+/// @param buffer Destination buffer, 8-byte aligned.
+/// @param buffer_size Destination buffer size.
+/// @return < 0 if any error happened, record size otherwise.
+//////////////////////////////////////////////////////////////////////////////////////////
+int ExportOptionsRecord(GET_OPT_EXPORT* opt_export, char* buffer, size_t buffer_size)
+{
+    if(opt_export == NULL || opt_export->key_offsets == NULL || buffer == NULL)
+    {
+        ReportOptError(GET_OPT_ERR_NULL_PTR, -1, -1, '\0', NULL, NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+        return GET_OPT_ERR_NULL_PTR;
+    }
+
+    size_t slots_end = sizeof(GET_OPT_RECORD_HEADER) + opt_export->option_number * sizeof(GET_OPT_RECORD_SLOT);
+
+    if(buffer_size < slots_end)
+    {
+        ReportOptError(GET_OPT_ERR_EXPORT_SIZE, -1, 0, '\0', NULL, NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+        return GET_OPT_ERR_EXPORT_SIZE;
+    }
+
+    int options_read_lock = OptionsReadLock();
+
+    if(options_read_lock < 0)
+    {
+        return options_read_lock;
+    }
+
+    char* snapshot = AcquireOptionsSnapshot();
+
+    if(snapshot == NULL || ((PRIV_OPT_IMG_HEADER*)snapshot)->option_number != (uint32_t)opt_export->option_number)
+    {
+        OptionsReadUnlock();
+        ReportOptError(GET_OPT_ERR_NO_OPT_STORE, -1, -1, '\0', NULL, NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+        return GET_OPT_ERR_NO_OPT_STORE;
+    }
+
+    PRIV_OPT_IMG_RECORD* records = GET_OPT_IMG_RECORDS(snapshot);
+    char* string_pool = GET_OPT_IMG_POOL(snapshot);
+    GET_OPT_RECORD_HEADER* header = (GET_OPT_RECORD_HEADER*)buffer;
+    GET_OPT_RECORD_SLOT* slots = (GET_OPT_RECORD_SLOT*)(header + 1);
+    PRIV_OPT_EXPORT_WRITER writer = {buffer, buffer_size, slots_end};
+    bool fits = true;
+
+    for(int i = 0; fits && i < opt_export->option_number; i++)
+    {
+        int var_type = records[i].var_type;
+        OPT_DATA_TYPE value = GetOptImageValue(&records[i], string_pool);
+        const char* bytes = NULL;
+        size_t byte_number = 0;
+
+        memset(&slots[i], 0, sizeof(GET_OPT_RECORD_SLOT));
+
+        switch(var_type)
+        {
+            case GET_OPT_TYPE_INT:
+                slots[i].integer = value.integer;
+            break;
+
+            case GET_OPT_TYPE_CHAR:
+                slots[i].integer = value.character;
+            break;
+
+            case GET_OPT_TYPE_FLOAT:
+                slots[i].floating = value.floating;
+            break;
+
+            case GET_OPT_TYPE_DOUBLE:
+                slots[i].doubling = value.doubling;
+            break;
+
+            case GET_OPT_TYPE_CHAR_STRING:
+            {
+                bytes = value.char_string;
+                byte_number = strlen(value.char_string) + 1;
+            }
+            break;
+
+            default:
+            {
+                if(!GET_OPT_IS_CODEC(var_type) || value.custom == NULL)
+                {
+                    slots[i].bytes.offset = GET_OPT_RECORD_NO_VALUE;
+                }
+                else if(GET_OPT_IS_BLOB(var_type))
+                {
+                    bytes = (const char*)((PRIV_OPT_BLOB_VALUE*)value.custom)->data;
+                    byte_number = ((PRIV_OPT_BLOB_VALUE*)value.custom)->length;
+                }
+                else
+                {
+                    bytes = (const char*)value.custom;
+                    byte_number = GetOptCodecValueSize(var_type, value.custom);
+                }
+            }
+            break;
+        }
+
+        if(bytes != NULL)
+        {
+            slots[i].bytes.offset = writer.length;
+            slots[i].bytes.length = byte_number - (var_type == GET_OPT_TYPE_CHAR_STRING);
+            fits = PutOptExportBytes(&writer, bytes, byte_number);
+        }
+    }
+
+    if(fits)
+    {
+        header->magic           = GET_OPT_RECORD_MAGIC;
+        header->version         = GET_OPT_RECORD_VERSION;
+        header->generation      = ((PRIV_OPT_IMG_HEADER*)snapshot)->key;
+        header->option_number   = opt_export->option_number;
+        header->record_size     = writer.length;
+    }
+
+    OptionsReadUnlock();
+
+    if(!fits)
+    {
+        ReportOptError(GET_OPT_ERR_EXPORT_SIZE, -1, (int)writer.length, '\0', NULL, NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+        return GET_OPT_ERR_EXPORT_SIZE;
+    }
+
+    return (int)writer.length;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////
+/// @brief Frees an export initialized by InitOptionsExport.
+/// @param opt_export Export to be freed. Nothing is done if NULL.
+//////////////////////////////////////////////////////////////////////////////////////
+void FreeOptionsExport(GET_OPT_EXPORT* opt_export)
+{
+    if(opt_export == NULL)
+    {
+        return;
+    }
+
+    free(opt_export->key_offsets);
+    opt_export->key_offsets     = NULL;
+    opt_export->keys            = NULL;
+    opt_export->option_number   = 0;
+}
+
+/////////////////////////////////////////////////////////////////////////////////
+/// @brief Appends bytes to an export, unless they do not fit.
+/// @param writer Export being written (or sized, if it has no buffer).
+/// @param bytes Bytes to be appended.
+/// @param byte_number Number of bytes.
+/// @return false if they do not fit, true otherwise.
+/////////////////////////////////////////////////////////////////////////////////
+bool PutOptExportBytes(PRIV_OPT_EXPORT_WRITER* writer, const char* bytes, size_t byte_number)
+{
+    if(byte_number > writer->buffer_size - writer->length)
+    {
+        return false;
+    }
+
+    if(writer->buffer != NULL)
+    {
+        memcpy(writer->buffer + writer->length, bytes, byte_number);
+    }
+
+    writer->length += byte_number;
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////////
+/// @brief Appends a quoted JSON string. Runs of bytes needing no escape are copied
+///        at once, and the few ones needing it are written as \" \\ or \u00XX.
+/// @param writer Export being written.
+/// @param string String (UTF-8 bytes are copied as they are).
+/// @param length String length.
+/// @return false if it does not fit, true otherwise.
+///////////////////////////////////////////////////////////////////////////////////
+bool PutOptJsonString(PRIV_OPT_EXPORT_WRITER* writer, const char* string, size_t length)
+{
+    static const char hex_digits[] = GET_OPT_BLOB_HEX_DIGITS;
+
+    if(!PutOptExportBytes(writer, "\"", 1))
+    {
+        return false;
+    }
+
+    size_t run_start = 0;
+
+    for(size_t i = 0; i < length; i++)
+    {
+        if(!GET_OPT_JSON_NEEDS_ESCAPE(string[i]))
+        {
+            continue;
+        }
+
+        char escape[2] = {'\\', string[i]};
+
+        if(!PutOptExportBytes(writer, string + run_start, i - run_start))
+        {
+            return false;
+        }
+
+        if((unsigned char)string[i] < 0x20)
+        {
+            char code[2] = {hex_digits[(unsigned char)string[i] >> 4], hex_digits[string[i] & 0x0F]};
+
+            if(!PutOptExportBytes(writer, GET_OPT_JSON_ESCAPE_UNICODE, sizeof(GET_OPT_JSON_ESCAPE_UNICODE) - 1) || !PutOptExportBytes(writer, code, 2))
+            {
+                return false;
+            }
+        }
+        else if(!PutOptExportBytes(writer, escape, 2))
+        {
+            return false;
+        }
+
+        run_start = i + 1;
+    }
+
+    return (PutOptExportBytes(writer, string + run_start, length - run_start) && PutOptExportBytes(writer, "\"", 1));
+}
+
+///////////////////////////////////////////////////////////////
+/// @brief Appends an integer, formatted without snprintf.
+/// @param writer Export being written.
+/// @param integer Integer.
+/// @return false if it does not fit, true otherwise.
+///////////////////////////////////////////////////////////////
+bool PutOptJsonInteger(PRIV_OPT_EXPORT_WRITER* writer, int64_t integer)
+{
+    char digits[24];
+    char* digit = digits + sizeof(digits);
+    uint64_t magnitude = (integer < 0 ? 0 - (uint64_t)integer : (uint64_t)integer);
+
+    do
+    {
+        *--digit = '0' + magnitude % 10;
+        magnitude /= 10;
+
+    } while(magnitude > 0);
+
+    if(integer < 0)
+    {
+        *--digit = '-';
+    }
+
+    return PutOptExportBytes(writer, digit, digits + sizeof(digits) - digit);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Appends the shortest decimal reading back as the very same floating point
+///        value. Values with up to GET_OPT_JSON_FRACTION_DIGITS_MAX decimals (most
+///        configuration values) are found by scaling them into an exact integer, and
+///        formatted without snprintf. Any other one falls back to snprintf.
+/// @param writer Export being written.
+/// @param floating Value.
+/// @param single_precision true for float values, so that they read back as floats.
+/// @return false if it does not fit, true otherwise.
+/////////////////////////////////////////////////////////////////////////////////////////
+bool PutOptJsonFloating(PRIV_OPT_EXPORT_WRITER* writer, double floating, bool single_precision)
+{
+    if(!isfinite(floating))
+    {
+        return PutOptExportBytes(writer, GET_OPT_JSON_NULL, sizeof(GET_OPT_JSON_NULL) - 1);
+    }
+
+    double exact_limit = (single_precision ? GET_OPT_JSON_FLOAT_EXACT : GET_OPT_JSON_DOUBLE_EXACT);
+    double scale = 1.0;
+
+    for(int digits = 0; digits <= GET_OPT_JSON_FRACTION_DIGITS_MAX; digits++, scale *= 10.0)
+    {
+        double scaled = floating * scale;
+
+        if(scaled >= exact_limit || scaled <= -exact_limit)
+        {
+            break;
+        }
+
+        // Both scaled and scale are exact, so dividing them rounds as parsing the decimal would.
+        int64_t mantissa = (int64_t)(scaled < 0 ? scaled - 0.5 : scaled + 0.5);
+        bool exact = (single_precision  ? ((float)mantissa / (float)scale == (float)floating)
+                                        : ((double)mantissa / scale == floating)            );
+
+        if(!exact)
+        {
+            continue;
+        }
+
+        uint64_t magnitude = (mantissa < 0 ? 0 - (uint64_t)mantissa : (uint64_t)mantissa);
+        char fraction[GET_OPT_JSON_FRACTION_DIGITS_MAX + 1];
+
+        fraction[0] = '.';
+
+        for(int i = digits; i > 0; i--)
+        {
+            fraction[i] = '0' + magnitude % 10;
+            magnitude /= 10;
+        }
+
+        return ((mantissa >= 0 || PutOptExportBytes(writer, "-", 1))  &&
+                PutOptJsonInteger(writer, (int64_t)magnitude)           &&
+                PutOptExportBytes(writer, fraction, (digits > 0 ? digits + 1 : 0)));
+    }
+
+    char formatted[32];
+    int formatted_length = snprintf(formatted, sizeof(formatted), (single_precision ? GET_OPT_ARGV_FMT_FLOAT : GET_OPT_ARGV_FMT_DOUBLE), floating);
+
+    return PutOptExportBytes(writer, formatted, formatted_length);
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+/// @brief Appends the JSON value of an option taken from the option store.
+/// @param writer Export being written.
+/// @param record Option record.
+/// @param value Option value.
+/// @return false if it does not fit, true otherwise.
+//////////////////////////////////////////////////////////////////////////////////
+bool PutOptJsonValue(PRIV_OPT_EXPORT_WRITER* writer, PRIV_OPT_IMG_RECORD* record, OPT_DATA_TYPE value)
+{
+    int var_type = record->var_type;
+
+    switch(var_type)
+    {
+        case GET_OPT_TYPE_INT:
+        {
+            if(record->needs_arg == GET_OPT_ARG_REQ_NO)
+            {
+                return (value.integer != 0  ? PutOptExportBytes(writer, GET_OPT_JSON_TRUE, sizeof(GET_OPT_JSON_TRUE) - 1)
+                                            : PutOptExportBytes(writer, GET_OPT_JSON_FALSE, sizeof(GET_OPT_JSON_FALSE) - 1));
+            }
+
+            return PutOptJsonInteger(writer, value.integer);
+        }
+
+        case GET_OPT_TYPE_CHAR:
+            return PutOptJsonInteger(writer, value.character);
+
+        case GET_OPT_TYPE_FLOAT:
+            return PutOptJsonFloating(writer, value.floating, true);
+
+        case GET_OPT_TYPE_DOUBLE:
+            return PutOptJsonFloating(writer, value.doubling, false);
+
+        case GET_OPT_TYPE_CHAR_STRING:
+            return PutOptJsonString(writer, value.char_string, strlen(value.char_string));
+
+        default:
+        break;
+    }
+
+    if(!GET_OPT_IS_CODEC(var_type) || value.custom == NULL)
+    {
+        return PutOptExportBytes(writer, GET_OPT_JSON_NULL, sizeof(GET_OPT_JSON_NULL) - 1);
+    }
+
+    // Blob digits need no escape, so they are encoded in place, between the quotes.
+    if(GET_OPT_IS_BLOB(var_type))
+    {
+        PRIV_OPT_BLOB_VALUE* blob = (PRIV_OPT_BLOB_VALUE*)value.custom;
+        size_t encoded_length = EncodeOptBlob(var_type, blob, NULL, 0);
+
+        if(!PutOptExportBytes(writer, "\"", 1) || encoded_length + 1 > writer->buffer_size - writer->length)
+        {
+            return false;
+        }
+
+        EncodeOptBlob(var_type, blob, writer->buffer + writer->length, encoded_length + 1);
+        writer->length += encoded_length;
+
+        return PutOptExportBytes(writer, "\"", 1);
+    }
+
+    char formatted[GET_OPT_SIZE_CODEC_FORMAT_MAX];
+    int formatted_length = FormatOptCodecValue(var_type, value.custom, formatted, sizeof(formatted));
+
+    if(formatted_length < 0)
+    {
+        return PutOptExportBytes(writer, GET_OPT_JSON_NULL, sizeof(GET_OPT_JSON_NULL) - 1);
+    }
+
+    return PutOptJsonString(writer, formatted, ((size_t)formatted_length < sizeof(formatted) ? (size_t)formatted_length : sizeof(formatted) - 1));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Exports the option store (schema and resolved values) to a sealed, read-only
+///        memfd. The layout is position-independent, so processes attaching to it (i.e.
+///        forked workers, AttachOptionsShared) read it in place, with no private copies.
+/// @return < 0 if any error happened, memfd file descriptor otherwise.
+////////////////////////////////////////////////////////////////////////////////////////////
+int ExportOptionsShared(void)
+{
+    int options_read_lock = OptionsReadLock();
+
+    if(options_read_lock < 0)
+    {
+        return options_read_lock;
+    }
+
+    char* snapshot = AcquireOptionsSnapshot();
+
+    if(snapshot == NULL)
+    {
+        OptionsReadUnlock();
+        ReportOptError(GET_OPT_ERR_NO_OPT_STORE, -1, -1, '\0', NULL, NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+        return GET_OPT_ERR_NO_OPT_STORE;
+    }
+
+    size_t image_size = ((PRIV_OPT_IMG_HEADER*)snapshot)->image_size;
+    int shared_fd = memfd_create(GET_OPT_SHARED_MEMFD_NAME, MFD_ALLOW_SEALING);
+    size_t written = 0;
+
+    while(shared_fd >= 0 && written < image_size)
+    {
+        ssize_t write_result = write(shared_fd, snapshot + written, image_size - written);
+
+        if(write_result <= 0)
+        {
+            break;
+        }
+
+        written += write_result;
+    }
+
+    OptionsReadUnlock();
+
+    // Once sealed, no process can modify the image anymore, so attaching to it is safe.
+    if(shared_fd < 0 || written < image_size || fcntl(shared_fd, F_ADD_SEALS, GET_OPT_SHARED_SEALS) < 0)
+    {
+        if(shared_fd >= 0)
+        {
+            close(shared_fd);
+        }
+
+        ReportOptError(GET_OPT_ERR_SHARED_MEM, -1, -1, '\0', NULL, NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+        return GET_OPT_ERR_SHARED_MEM;
+    }
+
+    return shared_fd;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Attaches to an option store exported by ExportOptionsShared, which replaces the
+///        current one. The image is mapped read-only and shared, and only its seals and layout
+///        are checked, so no option is parsed. Values are then read through the usual getters.
+/// @param shared_fd File descriptor returned by ExportOptionsShared (i.e. inherited).
+/// @return < 0 if any error happened, 0 otherwise.
+////////////////////////////////////////////////////////////////////////////////////////////
+int AttachOptionsShared(int shared_fd)
+{
+    struct stat shared_stat;
+
+    // Only fully sealed images are attached, otherwise they could still change while being read.
+    int shared_seals = fcntl(shared_fd, F_GET_SEALS);
+
+    if( shared_seals < 0                                                    ||
+        (shared_seals & GET_OPT_SHARED_SEALS) != GET_OPT_SHARED_SEALS       ||
+        fstat(shared_fd, &shared_stat) < 0                                  ||
+        (size_t)shared_stat.st_size < sizeof(PRIV_OPT_IMG_HEADER)           )
+    {
+        ReportOptError(GET_OPT_ERR_SHARED_MEM, -1, -1, '\0', NULL, NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+        return GET_OPT_ERR_SHARED_MEM;
+    }
+
+    size_t image_size = shared_stat.st_size;
+    char* image = mmap(NULL, image_size, PROT_READ, MAP_SHARED, shared_fd, 0);
+
+    if(image == MAP_FAILED)
+    {
+        ReportOptError(GET_OPT_ERR_SHARED_MEM, -1, -1, '\0', NULL, NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+        return GET_OPT_ERR_SHARED_MEM;
+    }
+
+    char** new_shared_images = NULL;
+
+    if(CheckOptionsImageLayout(image, image_size) < 0 ||
+       (new_shared_images = (char**)realloc(shared_images, (shared_image_number + 1) * sizeof(char*))) == NULL)
+    {
+        munmap(image, image_size);
+        ReportOptError(GET_OPT_ERR_SHARED_MEM, -1, -1, '\0', NULL, NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+        return GET_OPT_ERR_SHARED_MEM;
+    }
+
+    shared_images = new_shared_images;
+    shared_images[shared_image_number++] = image;
+
+    PublishOptionsSnapshot(image);
+
+    return GET_OPT_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////
+/// @brief Leaves reload mode, freeing the option schema and every snapshot. No reader
+///        may be within a read section when this is called.
+//////////////////////////////////////////////////////////////////////////////////////
+void EndOptionsReload(void)
+{
+    FreeOptionsStore();
+
+    retained_argc = 0;
+    retained_argv = NULL;
+    reload_mode = 0;
+
+    FreeHeapOptData();
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Initializes an options stream. Option characters are indexed once, here, so that
+///        every option is found in constant time while parsing control messages.
+/// @param stream Stream state.
+/// @param callback Function called for every event.
+/// @param user_data Passed to callback as is.
+/// @return < 0 if any error happened, 0 otherwise.
+//////////////////////////////////////////////////////////////////////////////////////////////
+int InitOptionsStream(GET_OPT_STREAM* stream, GET_OPT_STREAM_CALLBACK callback, void* user_data)
+{
+    if(stream == NULL || callback == NULL)
+    {
+        ReportOptError(GET_OPT_ERR_NULL_PTR, -1, -1, '\0', NULL, NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+        return GET_OPT_ERR_NULL_PTR;
+    }
+
+    // The schema is only kept (and no longer changes) once options have been parsed in reload mode.
+    if(!reload_mode || private_options == NULL || atomic_load(&current_snapshot) == NULL)
+    {
+        ReportOptError(GET_OPT_ERR_RELOAD_MODE, -1, -1, '\0', NULL, NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+        return GET_OPT_ERR_RELOAD_MODE;
+    }
+
+    stream->callback        = callback;
+    stream->user_data       = user_data;
+    stream->state           = GET_OPT_STREAM_STATE_BLANK;
+    stream->resume_state    = GET_OPT_STREAM_STATE_BLANK;
+    stream->pending_option  = -1;
+    stream->message_result  = GET_OPT_SUCCESS;
+    stream->message_offset  = 0;
+    stream->token_length    = 0;
+
+    for(int opt_char = 0; opt_char <= UCHAR_MAX; opt_char++)
+    {
+        stream->short_index[opt_char] = -1;
+    }
+
+    for(int option_index = 0; option_index < option_number; option_index++)
+    {
+        if(!GET_OPT_IS_REMOVED(&private_options[option_index]))
+        {
+            stream->short_index[(unsigned char)private_options[option_index].pub_opt.opt_char] = option_index;
+        }
+    }
+
+    return GET_OPT_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Feeds an options stream with the next chunk of bytes. Each byte moves the stream
+///        through a shell-like tokenizer (see TokenizeOptionsCmdline); tokens are handled as
+///        soon as they are complete, and only the current one is kept.
+/// @param stream Stream state.
+/// @param chunk Bytes received.
+/// @param chunk_size Number of bytes received.
+/// @return First error found within the chunk, 0 if none.
+//////////////////////////////////////////////////////////////////////////////////////////////
+int FeedOptionsStream(GET_OPT_STREAM* stream, const char* chunk, size_t chunk_size)
+{
+    if(stream == NULL || stream->callback == NULL || (chunk == NULL && chunk_size > 0))
+    {
+        ReportOptError(GET_OPT_ERR_NULL_PTR, -1, -1, '\0', NULL, NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+        return GET_OPT_ERR_NULL_PTR;
+    }
+
+    int chunk_result = GET_OPT_SUCCESS;
+
+    for(size_t byte_index = 0; byte_index < chunk_size; byte_index++)
+    {
+        char byte = chunk[byte_index];
+        int byte_result = GET_OPT_SUCCESS;
+
+        stream->message_offset++;
+
+        switch(stream->state)
+        {
+            case GET_OPT_STREAM_STATE_BLANK:
+            case GET_OPT_STREAM_STATE_TOKEN:
+            {
+                if(GET_OPT_CMD_IS_BLANK(byte))
+                {
+                    if(stream->state == GET_OPT_STREAM_STATE_TOKEN)
+                    {
+                        stream->state = GET_OPT_STREAM_STATE_BLANK;
+                        byte_result = EndOptionsStreamToken(stream);
+                    }
+
+                    // Errors found while ending the last token are reported before the end of the message.
+                    if(byte_result < 0)
+                    {
+                        FailOptionsStream(stream, byte_result);
+                    }
+
+                    if(byte == GET_OPT_STREAM_MSG_END)
+                    {
+                        int end_message = EndOptionsStreamMessage(stream);
+                        byte_result = (byte_result < 0 ? byte_result : end_message);
+                    }
+
+                    chunk_result = (chunk_result < 0 ? chunk_result : byte_result);
+                    continue;
+                }
+
+                if(byte == GET_OPT_CMD_QUOTE_SINGLE)
+                {
+                    stream->state = GET_OPT_STREAM_STATE_QUOTE_SINGLE;
+                }
+                else if(byte == GET_OPT_CMD_QUOTE_DOUBLE)
+                {
+                    stream->state = GET_OPT_STREAM_STATE_QUOTE_DOUBLE;
+                }
+                else if(byte == GET_OPT_CMD_ESCAPE)
+                {
+                    stream->resume_state    = stream->state;
+                    stream->state           = GET_OPT_STREAM_STATE_ESCAPE;
+                }
+                else
+                {
+                    stream->state   = GET_OPT_STREAM_STATE_TOKEN;
+                    byte_result     = PushOptionsStreamByte(stream, byte);
+                }
+            }
+            break;
+
+            case GET_OPT_STREAM_STATE_QUOTE_SINGLE:
+            {
+                if(byte == GET_OPT_CMD_QUOTE_SINGLE)
+                {
+                    stream->state = GET_OPT_STREAM_STATE_TOKEN;
+                }
+                else
+                {
+                    byte_result = PushOptionsStreamByte(stream, byte);
+                }
+            }
+            break;
+
+            case GET_OPT_STREAM_STATE_QUOTE_DOUBLE:
+            {
+                if(byte == GET_OPT_CMD_QUOTE_DOUBLE)
+                {
+                    stream->state = GET_OPT_STREAM_STATE_TOKEN;
+                }
+                else if(byte == GET_OPT_CMD_ESCAPE)
+                {
+                    stream->state = GET_OPT_STREAM_STATE_ESCAPE_DOUBLE;
+                }
+                else
+                {
+                    byte_result = PushOptionsStreamByte(stream, byte);
+                }
+            }
+            break;
+
+            case GET_OPT_STREAM_STATE_ESCAPE_DOUBLE:
+            {
+                stream->state = GET_OPT_STREAM_STATE_QUOTE_DOUBLE;
+
+                // Backslashes are kept within double quotes, unless they escape an escapable character.
+                if(byte == '\0' || strchr(GET_OPT_CMD_DQ_ESCAPABLE, byte) == NULL)
+                {
+                    byte_result = PushOptionsStreamByte(stream, GET_OPT_CMD_ESCAPE);
+                }
+
+                if(byte_result == GET_OPT_SUCCESS && byte != '\n')
+                {
+                    byte_result = PushOptionsStreamByte(stream, byte);
+                }
+            }
+            break;
+
+            case GET_OPT_STREAM_STATE_ESCAPE:
+            {
+                // Backslash-newline pairs are removed altogether, so they do not even start a token.
+                if(byte == '\n')
+                {
+                    stream->state = stream->resume_state;
+                    break;
+                }
+
+                stream->state   = GET_OPT_STREAM_STATE_TOKEN;
+                byte_result     = PushOptionsStreamByte(stream, byte);
+            }
+            break;
+
+            default:
+            {
+                if(byte == GET_OPT_STREAM_MSG_END)
+                {
+                    EndOptionsStreamMessage(stream);
+                }
+            }
+            break;
+        }
+
+        if(byte_result < 0)
+        {
+            FailOptionsStream(stream, byte_result);
+            chunk_result = (chunk_result < 0 ? chunk_result : byte_result);
+        }
+    }
+
+    return chunk_result;
+}
+
+//////////////////////////////////////////////////////////////////////////
+/// @brief Appends a byte to the current token of an options stream.
+/// @param stream Stream state.
+/// @param byte Byte to be appended.
+/// @return GET_OPT_ERR_STREAM_TOKEN if the token is too long, 0 otherwise.
+//////////////////////////////////////////////////////////////////////////
+int PushOptionsStreamByte(GET_OPT_STREAM* stream, char byte)
+{
+    if(stream->token_length == GET_OPT_SIZE_STREAM_TOKEN_MAX)
+    {
+        ReportOptError(GET_OPT_ERR_STREAM_TOKEN, -1, (int)(stream->message_offset - 1), '\0', NULL, NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+        return GET_OPT_ERR_STREAM_TOKEN;
+    }
+
+    stream->token[stream->token_length++] = byte;
+
+    return GET_OPT_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Handles the token an options stream has just completed: the argument of the
+///        option before it, a long option (--name or --name=value), or short options,
+///        which may be grouped (-dv) or followed by their argument (-l3).
+/// @param stream Stream state.
+/// @return < 0 if any error happened, 0 otherwise.
+////////////////////////////////////////////////////////////////////////////////////////
+int EndOptionsStreamToken(GET_OPT_STREAM* stream)
+{
+    char* token = stream->token;
+    size_t token_length = stream->token_length;
+    int token_offset = (int)(stream->message_offset - 1);
+
+    token[token_length] = '\0';
+    stream->token_length = 0;
+
+    if(stream->pending_option >= 0)
+    {
+        int option_index = stream->pending_option;
+        stream->pending_option = -1;
+
+        return EmitOptionsStreamOption(stream, option_index, token);
+    }
+
+    if(token_length > 2 && token[0] == '-' && token[1] == '-')
+    {
+        char* opt_long = token + 2;
+        char* arg = memchr(opt_long, GET_OPT_CFG_ASSIGN, token_length - 2);
+
+        if(arg != NULL)
+        {
+            *arg++ = '\0';
+        }
+
+        int node = ResolveOptionLong(opt_long, strlen(opt_long), token_offset);
+
+        if(node < 0)
+        {
+            return node;
+        }
+
+        // --verbose and --brief only make sense on the command line.
+        if(long_name_trie[node].option_index < 0)
+        {
+            ReportOptError(GET_OPT_ERR_UNKNOWN_OPTION, -1, token_offset, '\0', opt_long, NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+            return GET_OPT_ERR_UNKNOWN_OPTION;
+        }
+
+        return StartOptionsStreamOption(stream, long_name_trie[node].option_index, arg);
+    }
+
+    if(token_length > 1 && token[0] == '-' && token[1] != '-')
+    {
+        for(char* opt_char = token + 1; *opt_char != '\0'; opt_char++)
+        {
+            int option_index = stream->short_index[(unsigned char)*opt_char];
+
+            if(option_index < 0)
+            {
+                ReportOptError(GET_OPT_ERR_UNKNOWN_OPTION, -1, token_offset, *opt_char, NULL, NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+                return GET_OPT_ERR_UNKNOWN_OPTION;
+            }
+
+            if(private_options[option_index].pub_opt.opt_needs_arg != GET_OPT_ARG_REQ_NO)
+            {
+                return StartOptionsStreamOption(stream, option_index, (opt_char[1] == '\0' ? NULL : opt_char + 1));
+            }
+
+            int emit_option = EmitOptionsStreamOption(stream, option_index, NULL);
+
+            if(emit_option < 0)
+            {
+                return emit_option;
+            }
+        }
+
+        return GET_OPT_SUCCESS;
+    }
+
+    // Control messages are made of options only: there are no positional arguments.
+    ReportOptError(GET_OPT_ERR_UNKNOWN_OPTION, -1, token_offset, token[0], NULL, NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+    return GET_OPT_ERR_UNKNOWN_OPTION;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+/// @brief Handles an option found by an options stream. Options requiring an
+///        argument that has not been given yet take the next token as argument.
+/// @param stream Stream state.
+/// @param option_index Index of the option within the registry.
+/// @param arg Argument, NULL if none has been given (yet).
+/// @return < 0 if any error happened, 0 otherwise.
+/////////////////////////////////////////////////////////////////////////////////////
+int StartOptionsStreamOption(GET_OPT_STREAM* stream, int option_index, char* arg)
+{
+    if(arg == NULL && private_options[option_index].pub_opt.opt_needs_arg == GET_OPT_ARG_REQ_REQUIRED)
+    {
+        stream->pending_option = option_index;
+        return GET_OPT_SUCCESS;
+    }
+
+    return EmitOptionsStreamOption(stream, option_index, arg);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Converts an option value found by an options stream through the converter
+///        bound to the option, then emits it. Nothing is staged nor assigned, and blobs
+///        are given back to the arena once emitted, so that it does not grow with every
+///        message.
+/// @param stream Stream state.
+/// @param option_index Index of the option within the registry.
+/// @param arg Argument, NULL if none (boolean options, or optional arguments not given).
+/// @return < 0 if the value is not valid, 0 otherwise.
+/////////////////////////////////////////////////////////////////////////////////////////
+int EmitOptionsStreamOption(GET_OPT_STREAM* stream, int option_index, char* arg)
+{
+    PRIV_OPT_DEFINITION* priv_opt_def = &private_options[option_index];
+
+    // Starting from the staged value makes codecs convert into their other buffer, leaving it untouched.
+    GET_OPT_STREAM_EVENT event =    {
+                                        .event          = GET_OPT_STREAM_EVENT_OPTION               ,
+                                        .code           = GET_OPT_SUCCESS                           ,
+                                        .opt_char       = priv_opt_def->pub_opt.opt_char            ,
+                                        .opt_long       = (const char*)priv_opt_def->pub_opt.opt_long,
+                                        .opt_var_type   = priv_opt_def->pub_opt.opt_var_type        ,
+                                        .value          = priv_opt_def->opt_value                   ,
+                                    };
+
+    // Options with optional arguments get their default value if none has been provided.
+    if(arg == NULL && priv_opt_def->pub_opt.opt_needs_arg != GET_OPT_ARG_REQ_NO)
+    {
+        event.value = priv_opt_def->pub_opt.opt_default_value;
+    }
+    else
+    {
+        int convert_option_value = priv_opt_def->opt_convert(priv_opt_def, arg, &event.value);
+
+        if(convert_option_value < 0)
+        {
+            ReportOptErrorFromDef(convert_option_value, option_index, (int)(stream->message_offset - 1));
+            return convert_option_value;
+        }
+    }
+
+    stream->callback(&event, stream->user_data);
+
+    if(arg != NULL && GET_OPT_IS_BLOB(event.opt_var_type))
+    {
+        ReleaseOptArenaAlloc(event.value.custom);
+    }
+
+    return GET_OPT_SUCCESS;
+}
+
+///////////////////////////////////////////////////////////////////////////
+/// @brief Emits an error event, then skips the rest of the message.
+/// @param stream Stream state.
+/// @param code Error code.
+/// @return The same error code.
+///////////////////////////////////////////////////////////////////////////
+int FailOptionsStream(GET_OPT_STREAM* stream, int code)
+{
+    GET_OPT_STREAM_EVENT event = {.event = GET_OPT_STREAM_EVENT_ERROR, .code = code};
+
+    if(stream->message_result == GET_OPT_SUCCESS)
+    {
+        stream->message_result = code;
+    }
+
+    stream->state           = GET_OPT_STREAM_STATE_SKIP;
+    stream->pending_option  = -1;
+    stream->token_length    = 0;
+
+    stream->callback(&event, stream->user_data);
+
+    return code;
+}
+
+///////////////////////////////////////////////////////////////////////////////////
+/// @brief Ends the current message of an options stream: an option still waiting
+///        for its argument is an error. Emits the end event, then starts over.
+/// @param stream Stream state.
+/// @return GET_OPT_ERR_NO_ARG_FOUND if an argument is missing, 0 otherwise.
+///////////////////////////////////////////////////////////////////////////////////
+int EndOptionsStreamMessage(GET_OPT_STREAM* stream)
+{
+    int end_message = GET_OPT_SUCCESS;
+
+    if(stream->pending_option >= 0)
+    {
+        ReportOptErrorFromDef(GET_OPT_ERR_NO_ARG_FOUND, stream->pending_option, (int)(stream->message_offset - 1));
+        end_message = FailOptionsStream(stream, GET_OPT_ERR_NO_ARG_FOUND);
+    }
+
+    GET_OPT_STREAM_EVENT event = {.event = GET_OPT_STREAM_EVENT_END, .code = stream->message_result};
+
+    stream->state           = GET_OPT_STREAM_STATE_BLANK;
+    stream->pending_option  = -1;
+    stream->message_result  = GET_OPT_SUCCESS;
+    stream->message_offset  = 0;
+    stream->token_length    = 0;
+
+    stream->callback(&event, stream->user_data);
+
+    return end_message;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Builds the command lines of a batch of child processes out of the resolved option
+///        values. Arguments shared by every child are formatted once into a template, which
+///        each child copies but for the options it overrides, and everything (template
+///        included) lives within a single allocation, sized by a first pass over children.
+/// @param program Program name (argv[0]). NULL for the one options were parsed with.
+/// @param argv_mode OPT_ARGV_MODE.
+/// @param overrides override_number entries per child, child after child.
+/// @param override_number Number of overrides per child.
+/// @param child_number Number of children.
+/// @param children Where to store the child_number command lines (released with free()).
+/// @return < 0 if any error happened, 0 otherwise.
+/////////////////////////////////////////////////////////////////////////////////////////////
+int BuildOptionsArgv(   char*               program         ,
+                        int                 argv_mode       ,
+                        GET_OPT_OVERRIDE*   overrides       ,
+                        int                 override_number ,
+                        int                 child_number    ,
+                        GET_OPT_ARGV**      children        )
+{
+    if(children == NULL || child_number < 0 || override_number < 0 || (overrides == NULL && override_number > 0))
+    {
+        ReportOptError(GET_OPT_ERR_NULL_PTR, -1, -1, '\0', NULL, NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+        return GET_OPT_ERR_NULL_PTR;
+    }
+
+    if(argv_mode < GET_OPT_ARGV_MODE_MIN || argv_mode > GET_OPT_ARGV_MODE_MAX)
+    {
+        ReportOptError(GET_OPT_ERR_UNKNOWN_TYPE, -1, -1, '\0', NULL, NULL, argv_mode, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+        return GET_OPT_ERR_UNKNOWN_TYPE;
+    }
+
+    // Resolved values (and choice strings) are only kept along with the schema in reload mode.
+    if(!reload_mode || private_options == NULL || atomic_load(&current_snapshot) == NULL)
+    {
+        ReportOptError(GET_OPT_ERR_RELOAD_MODE, -1, -1, '\0', NULL, NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+        return GET_OPT_ERR_RELOAD_MODE;
+    }
+
+    if(program == NULL)
+    {
+        program = (retained_argc > 0 ? retained_argv[0] : min_str);
+    }
+
+    size_t program_size = strlen(program) + 1;
+    size_t template_size = 0;
+    int template_number = 0;
+
+    for(int option_index = 0; option_index < option_number; option_index++)
+    {
+        PRIV_OPT_DEFINITION* priv_opt_def = &private_options[option_index];
+
+        priv_opt_def->opt_argv_length   = 0;
+        priv_opt_def->opt_argv_child    = -1;
+
+        if(GET_OPT_IS_REMOVED(priv_opt_def) || !IsOptArgvIncluded(priv_opt_def, argv_mode))
+        {
+            continue;
+        }
+
+        int token_length = FormatOptArgvToken(priv_opt_def, NULL, 0);
+
+        if(token_length < 0)
+        {
+            ReportOptErrorFromDef(token_length, option_index, -1);
+            return token_length;
+        }
+
+        priv_opt_def->opt_argv_length = token_length + 1;
+        template_size += priv_opt_def->opt_argv_length;
+        template_number++;
+    }
+
+    // First pass: every child takes the template, but for the options it overrides, plus its overrides.
+    size_t slot_number = 0;
+    size_t string_size = 0;
+
+    for(int child_index = 0; child_index < child_number; child_index++)
+    {
+        GET_OPT_OVERRIDE* child_overrides = overrides + (size_t)child_index * override_number;
+        size_t child_size = program_size + template_size;
+        size_t child_argc = 1 + template_number;
+
+        for(int override_index = 0; override_index < override_number; override_index++)
+        {
+            if(child_overrides[override_index].opt_long == NULL)
+            {
+                continue;
+            }
+
+            char* opt_long = (char*)child_overrides[override_index].opt_long;
+            int option_index = GetOptionIndexFromLong(opt_long, strlen(opt_long));
+
+            if(option_index < 0)
+            {
+                ReportOptError(GET_OPT_ERR_UNKNOWN_OPTION, -1, -1, '\0', opt_long, NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+                return GET_OPT_ERR_UNKNOWN_OPTION;
+            }
+
+            PRIV_OPT_DEFINITION* priv_opt_def = &private_options[option_index];
+
+            if(priv_opt_def->opt_argv_child != child_index)
+            {
+                priv_opt_def->opt_argv_child = child_index;
+                child_size -= priv_opt_def->opt_argv_length;
+                child_argc -= (priv_opt_def->opt_argv_length > 0);
+            }
+
+            int override_length = FormatOptArgvOverride(priv_opt_def, child_overrides[override_index].value, NULL, 0);
+
+            if(override_length < 0)
+            {
+                ReportOptErrorFromDef(override_length, option_index, -1);
+                return override_length;
+            }
+
+            child_size += (override_length > 0 ? override_length + 1 : 0);
+            child_argc += (override_length > 0);
+        }
+
+        slot_number += child_argc + 1;
+        string_size += child_size;
+    }
+
+    GET_OPT_ARGV* child_argvs = (GET_OPT_ARGV*)malloc(  child_number * sizeof(GET_OPT_ARGV) +
+                                                        slot_number * sizeof(char*)         +
+                                                        template_size + string_size         );
+
+    if(child_argvs == NULL)
+    {
+        ReportOptError(GET_OPT_ERR_NULL_PTR, -1, -1, '\0', NULL, NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+        return GET_OPT_ERR_NULL_PTR;
+    }
+
+    char** slots = (char**)(child_argvs + child_number);
+    char* template = (char*)(slots + slot_number);
+    char* strings = template + template_size;
+    char* template_token = template;
+
+    for(int option_index = 0; option_index < option_number; option_index++)
+    {
+        PRIV_OPT_DEFINITION* priv_opt_def = &private_options[option_index];
+
+        if(priv_opt_def->opt_argv_length > 0)
+        {
+            FormatOptArgvToken(priv_opt_def, template_token, priv_opt_def->opt_argv_length);
+            template_token += priv_opt_def->opt_argv_length;
+        }
+
+        priv_opt_def->opt_argv_child = -1;
+    }
+
+    // Second pass: overridden options are marked first, so that the template is copied in a single walk.
+    for(int child_index = 0; child_index < child_number; child_index++)
+    {
+        GET_OPT_OVERRIDE* child_overrides = overrides + (size_t)child_index * override_number;
+        GET_OPT_ARGV* child_argv = &child_argvs[child_index];
+
+        child_argv->argc    = 0;
+        child_argv->argv    = slots;
+        child_argv->cmdline = strings;
+
+        slots[child_argv->argc++] = memcpy(strings, program, program_size);
+        strings += program_size;
+
+        for(int override_index = 0; override_index < override_number; override_index++)
+        {
+            char* opt_long = (char*)child_overrides[override_index].opt_long;
+
+            if(opt_long != NULL)
+            {
+                private_options[GetOptionIndexFromLong(opt_long, strlen(opt_long))].opt_argv_child = child_index;
+            }
+        }
+
+        template_token = template;
+
+        for(int option_index = 0; option_index < option_number; option_index++)
+        {
+            size_t token_size = private_options[option_index].opt_argv_length;
+
+            if(token_size > 0 && private_options[option_index].opt_argv_child != child_index)
+            {
+                slots[child_argv->argc++] = memcpy(strings, template_token, token_size);
+                strings += token_size;
+            }
+
+            template_token += token_size;
+        }
+
+        for(int override_index = 0; override_index < override_number; override_index++)
+        {
+            char* opt_long = (char*)child_overrides[override_index].opt_long;
+
+            if(opt_long == NULL)
+            {
+                continue;
+            }
+
+            PRIV_OPT_DEFINITION* priv_opt_def = &private_options[GetOptionIndexFromLong(opt_long, strlen(opt_long))];
+            int override_length = FormatOptArgvOverride(priv_opt_def, child_overrides[override_index].value, NULL, 0);
+
+            if(override_length > 0)
+            {
+                FormatOptArgvOverride(priv_opt_def, child_overrides[override_index].value, strings, override_length + 1);
+                slots[child_argv->argc++] = strings;
+                strings += override_length + 1;
+            }
+        }
+
+        slots[child_argv->argc] = NULL;
+        slots += child_argv->argc + 1;
+        child_argv->cmdline_size = strings - child_argv->cmdline;
+    }
+
+    *children = child_argvs;
+
     return GET_OPT_SUCCESS;
 }
 
-//////////////////////////////////////////////////////////////////////////////////////////////////////////
-/// @brief Generates short options string based on what's found in private_options.
-/// @return GET_OPT_ERR_NULL_PTR if pointers to private options or short_options_string are uninitialized.
-//////////////////////////////////////////////////////////////////////////////////////////////////////////
-int GenerateShortOptStr(void)
+//////////////////////////////////////////////////////////////////////////////////
+/// @brief Checks whether an option is part of synthesized argvs: boolean options
+///        are only given if true, and unset codec values can not be given at all.
+/// @param priv_opt_def Private option definition.
+/// @param argv_mode OPT_ARGV_MODE.
+/// @return true if the option is given, false otherwise.
+//////////////////////////////////////////////////////////////////////////////////
+bool IsOptArgvIncluded(PRIV_OPT_DEFINITION* priv_opt_def, int argv_mode)
 {
-    if(private_options == NULL)
+    int var_type = priv_opt_def->pub_opt.opt_var_type;
+
+    if( (priv_opt_def->pub_opt.opt_needs_arg == GET_OPT_ARG_REQ_NO && priv_opt_def->opt_value.integer == 0) ||
+        (GET_OPT_IS_CODEC(var_type) && priv_opt_def->opt_value.custom == NULL)                              )
     {
-        SVRTY_LOG_DBG("FILE: %s\tFUNCTION: %s\tLINE: %d", __FILE__, __func__, __LINE__);
-        return GET_OPT_ERR_NULL_PTR;
+        return false;
+    }
+
+    return (argv_mode == GET_OPT_ARGV_MODE_FULL || CompareOptValue(var_type, priv_opt_def->opt_value, priv_opt_def->pub_opt.opt_default_value) != 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Formats the resolved value of an option as a single argument: "--name=value",
+///        or "--name" for boolean options.
+/// @param priv_opt_def Private option definition.
+/// @param buffer Destination buffer, NULL to get the argument length only.
+/// @param buffer_size Destination buffer size.
+/// @return < 0 if the value can not be formatted, argument length (as snprintf) otherwise.
+////////////////////////////////////////////////////////////////////////////////////////
+int FormatOptArgvToken(PRIV_OPT_DEFINITION* priv_opt_def, char* buffer, size_t buffer_size)
+{
+    char* opt_long = (char*)priv_opt_def->pub_opt.opt_long;
+
+    if(priv_opt_def->pub_opt.opt_needs_arg == GET_OPT_ARG_REQ_NO)
+    {
+        return snprintf(buffer, buffer_size, GET_OPT_ARGV_FMT_FLAG, opt_long);
+    }
+
+    int prefix_length = snprintf(buffer, buffer_size, GET_OPT_ARGV_FMT_OPTION, opt_long);
+    int value_length = FormatOptArgvValue(  priv_opt_def                                        ,
+                                            priv_opt_def->opt_value                             ,
+                                            (buffer == NULL ? NULL : buffer + prefix_length)    ,
+                                            (buffer == NULL ? 0 : buffer_size - prefix_length)  );
+
+    return (value_length < 0 ? value_length : prefix_length + value_length);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Formats an option value so that it is parsed back as the very same value.
+/// @param priv_opt_def Private option definition.
+/// @param value Value.
+/// @param buffer Destination buffer, NULL to get the value length only.
+/// @param buffer_size Destination buffer size.
+/// @return GET_OPT_ERR_CODEC_VALUE if the codec can not format values, value length
+///         (as snprintf) otherwise.
+/////////////////////////////////////////////////////////////////////////////////////////
+int FormatOptArgvValue(PRIV_OPT_DEFINITION* priv_opt_def, OPT_DATA_TYPE value, char* buffer, size_t buffer_size)
+{
+    int var_type = priv_opt_def->pub_opt.opt_var_type;
+
+    if(priv_opt_def->opt_choice != NULL)
+    {
+        return snprintf(buffer, buffer_size, "%s", priv_opt_def->opt_choice->choices[value.integer]);
+    }
+
+    switch(var_type)
+    {
+        case GET_OPT_TYPE_INT:
+            return snprintf(buffer, buffer_size, "%d", value.integer);
+
+        case GET_OPT_TYPE_CHAR:
+            return snprintf(buffer, buffer_size, "%d", value.character);
+
+        case GET_OPT_TYPE_FLOAT:
+            return snprintf(buffer, buffer_size, GET_OPT_ARGV_FMT_FLOAT, value.floating);
+
+        case GET_OPT_TYPE_DOUBLE:
+            return snprintf(buffer, buffer_size, GET_OPT_ARGV_FMT_DOUBLE, value.doubling);
+
+        case GET_OPT_TYPE_CHAR_STRING:
+            return snprintf(buffer, buffer_size, "%s", value.char_string);
+
+        default:
+        break;
+    }
+
+    if(GET_OPT_IS_BLOB(var_type))
+    {
+        return EncodeOptBlob(var_type, (PRIV_OPT_BLOB_VALUE*)value.custom, buffer, buffer_size);
+    }
+
+    // Codec formatters are meant for summaries, but are the only way back to text.
+    if(GET_OPT_IS_CODEC(var_type) && GET_OPT_CODEC_OF(var_type)->format != NULL)
+    {
+        return GET_OPT_CODEC_OF(var_type)->format(value.custom, buffer, buffer_size);
+    }
+
+    return GET_OPT_ERR_CODEC_VALUE;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////
+/// @brief Formats an override as a single argument. Values are taken as they are, and
+///        checked by the child parsing them. False boolean options are not given.
+/// @param priv_opt_def Private option definition.
+/// @param value Value as written on the command line, NULL if none.
+/// @param buffer Destination buffer, NULL to get the argument length only.
+/// @param buffer_size Destination buffer size.
+/// @return GET_OPT_ERR_NO_ARG_FOUND if a required value is missing, argument length
+///         (as snprintf, 0 for no argument at all) otherwise.
+//////////////////////////////////////////////////////////////////////////////////////
+int FormatOptArgvOverride(PRIV_OPT_DEFINITION* priv_opt_def, const char* value, char* buffer, size_t buffer_size)
+{
+    char* opt_long = (char*)priv_opt_def->pub_opt.opt_long;
+
+    if(priv_opt_def->pub_opt.opt_needs_arg == GET_OPT_ARG_REQ_NO)
+    {
+        return ((value == NULL || GetOptParseBool((char*)value)) ? snprintf(buffer, buffer_size, GET_OPT_ARGV_FMT_FLAG, opt_long) : 0);
+    }
+
+    if(value == NULL)
+    {
+        return (priv_opt_def->pub_opt.opt_needs_arg == GET_OPT_ARG_REQ_OPTIONAL ? snprintf(buffer, buffer_size, GET_OPT_ARGV_FMT_FLAG, opt_long) : GET_OPT_ERR_NO_ARG_FOUND);
+    }
+
+    return snprintf(buffer, buffer_size, GET_OPT_ARGV_FMT_OVERRIDE, opt_long, value);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Encodes a blob as lower case hex digits, or padded standard base64.
+/// @param blob_type GET_OPT_TYPE_BLOB_HEX or GET_OPT_TYPE_BLOB_BASE64.
+/// @param blob Blob.
+/// @param buffer Destination buffer, NULL to get the encoded length only.
+/// @param buffer_size Destination buffer size.
+/// @return Encoded length. Nothing is written if it does not fit.
+//////////////////////////////////////////////////////////////////////////////
+int EncodeOptBlob(int blob_type, PRIV_OPT_BLOB_VALUE* blob, char* buffer, size_t buffer_size)
+{
+    static const char hex_digits[]      = GET_OPT_BLOB_HEX_DIGITS;
+    static const char base64_digits[]   = GET_OPT_BLOB_BASE64_DIGITS;
+
+    size_t length = blob->length;
+    size_t encoded_length = (blob_type == GET_OPT_TYPE_BLOB_HEX ? 2 * length : 4 * ((length + 2) / 3));
+
+    if(buffer == NULL || buffer_size <= encoded_length)
+    {
+        return (int)encoded_length;
+    }
+
+    char* digit = buffer;
+
+    if(blob_type == GET_OPT_TYPE_BLOB_HEX)
+    {
+        for(size_t i = 0; i < length; i++)
+        {
+            *digit++ = hex_digits[blob->data[i] >> 4];
+            *digit++ = hex_digits[blob->data[i] & 0x0F];
+        }
+    }
+    else
+    {
+        for(size_t i = 0; i < length; i += 3)
+        {
+            uint32_t group = (uint32_t)blob->data[i] << 16;
+            group |= (i + 1 < length ? (uint32_t)blob->data[i + 1] << 8 : 0);
+            group |= (i + 2 < length ? (uint32_t)blob->data[i + 2] : 0);
+
+            *digit++ = base64_digits[(group >> 18) & 0x3F];
+            *digit++ = base64_digits[(group >> 12) & 0x3F];
+            *digit++ = (i + 1 < length ? base64_digits[(group >> 6) & 0x3F] : GET_OPT_BLOB_BASE64_PAD);
+            *digit++ = (i + 2 < length ? base64_digits[group & 0x3F] : GET_OPT_BLOB_BASE64_PAD);
+        }
+    }
+
+    *digit = '\0';
+
+    return (int)encoded_length;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+/// @brief Sets the prefix of the environment variables options fall back to.
+///        For instance, with "APP_" as prefix, --threads is bound to APP_THREADS.
+/// @param prefix Environment variable prefix. NULL or "" disables the binding.
+/// @return GET_OPT_ERR_LONG_LENGTH_EXCEEDED if the prefix is too long, 0 otherwise.
+/////////////////////////////////////////////////////////////////////////////////////
+int SetOptionsEnvPrefix(char* prefix)
+{
+    if(prefix == NULL)
+    {
+        env_prefix[0] = '\0';
+        return GET_OPT_SUCCESS;
+    }
+
+    if(strlen(prefix) > GET_OPT_SIZE_ENV_PREFIX_MAX)
+    {
+        ReportOptError(GET_OPT_ERR_LONG_LENGTH_EXCEEDED, -1, -1, '\0', NULL, NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+        return GET_OPT_ERR_LONG_LENGTH_EXCEEDED;
+    }
+
+    strcpy(env_prefix, prefix);
+
+    return GET_OPT_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+/// @brief Hashes an option long name the way it's written as an environment
+///        variable name: upper case letters, and '_' instead of '-'.
+/// @param name Option string or environment variable name (not NUL-terminated).
+/// @param name_len Name length.
+/// @return Hash value.
+////////////////////////////////////////////////////////////////////////////////////
+uint32_t GetOptHashEnvName(char* name, int name_len)
+{
+    uint32_t hash = GET_OPT_HASH_FNV_OFFSET;
+
+    for(int i = 0; i < name_len; i++)
+    {
+        hash ^= (unsigned char)GET_OPT_ENV_FOLD_CHAR(name[i]);
+        hash *= GET_OPT_HASH_FNV_PRIME;
     }
 
-    char aux_short_options[1 + 3 * option_number + 1];
-    memset(aux_short_options, 0, sizeof(aux_short_options));
-    aux_short_options[0] = ':';
+    return hash;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Applies the values of environment variables bound to options. Options are hashed
+///        by their environment name into a transient index first, then environ is scanned
+///        only once, so the cost is O(options + environ) rather than one getenv per option.
+/// @return < 0 if any value is wrong, 0 otherwise.
+//////////////////////////////////////////////////////////////////////////////////////////////
+int ApplyEnvironmentOptions(void)
+{
+    if(env_prefix[0] == '\0' || option_number == 0)
+    {
+        return GET_OPT_SUCCESS;
+    }
+
+    int env_index_size = GET_OPT_SIZE_LONG_INDEX_MIN;
+    while(env_index_size < 2 * option_number)
+    {
+        env_index_size *= 2;
+    }
+
+    int* env_index = (int*)calloc(env_index_size, sizeof(int));
+
+    if(env_index == NULL)
+    {
+        ReportOptError(GET_OPT_ERR_NULL_PTR, -1, -1, '\0', NULL, NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+        return GET_OPT_ERR_NULL_PTR;
+    }
 
     for(int i = 0; i < option_number; i++)
     {
-        aux_short_options[strlen(aux_short_options)] = private_options[i].pub_opt.opt_char;
+        if(GET_OPT_IS_REMOVED(&private_options[i]))
+        {
+            continue;
+        }
+
+        char* opt_long = (char*)private_options[i].pub_opt.opt_long;
+        uint32_t slot = GetOptHashEnvName(opt_long, strlen(opt_long)) & (env_index_size - 1);
+
+        while(env_index[slot] != 0)
+        {
+            slot = (slot + 1) & (env_index_size - 1);
+        }
+
+        env_index[slot] = i + 1;
+    }
+
+    int prefix_len = strlen(env_prefix);
+    int apply_option_value = GET_OPT_SUCCESS;
+
+    for(int env_num = 0; environ[env_num] != NULL && apply_option_value == GET_OPT_SUCCESS; env_num++)
+    {
+        char* env_name = environ[env_num];
+
+        if(strncmp(env_name, env_prefix, prefix_len) != 0)
+        {
+            continue;
+        }
+
+        env_name += prefix_len;
+        char* env_value = strchr(env_name, '=');
+
+        if(env_value == NULL)
+        {
+            continue;
+        }
 
-        switch (private_options[i].pub_opt.opt_needs_arg)
+        int env_name_len = env_value - env_name;
+        uint32_t slot = GetOptHashEnvName(env_name, env_name_len) & (env_index_size - 1);
+
+        while(env_index[slot] != 0)
         {
-            case GET_OPT_ARG_REQ_REQUIRED:
+            char* candidate = (char*)private_options[env_index[slot] - 1].pub_opt.opt_long;
+            int char_num = 0;
+
+            while(char_num < env_name_len && GET_OPT_ENV_FOLD_CHAR(candidate[char_num]) == env_name[char_num])
             {
-                aux_short_options[strlen(aux_short_options)] = ':';
+                char_num++;
             }
-            break;
 
-            case GET_OPT_ARG_REQ_OPTIONAL:
+            if(char_num == env_name_len && candidate[char_num] == '\0')
             {
-                aux_short_options[strlen(aux_short_options)] = ':';
-                aux_short_options[strlen(aux_short_options)] = ':';
+                apply_option_value = ApplyOptionValue(env_index[slot] - 1, env_value + 1, env_num, GET_OPT_SRC_ENV);
+                break;
             }
-            break; 
 
-            case GET_OPT_ARG_REQ_NO:
-            default:
-            break;
+            slot = (slot + 1) & (env_index_size - 1);
         }
     }
 
-    short_options_string = (char*)calloc(strlen(aux_short_options) + 1, sizeof(char));
-    strcpy(short_options_string, aux_short_options);
+    free(env_index);
+
+    return apply_option_value;
+}
+
+/////////////////////////////////////////////////////////////////
+/// @brief Skips blank characters (new lines excluded).
+/// @param cursor Current position.
+/// @param end End of the buffer.
+/// @return Pointer to the first non-blank character (or end).
+/////////////////////////////////////////////////////////////////
+char* GetOptSkipBlanks(char* cursor, char* end)
+{
+    while(cursor < end && (*cursor == ' ' || *cursor == '\t' || *cursor == '\r'))
+    {
+        cursor++;
+    }
+
+    return cursor;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Looks for the option a config file key refers to, and applies the value found for it.
+/// @param key Option long name (NUL-terminated).
+/// @param value Value (NUL-terminated), NULL if the key has no value.
+/// @param token_offset Byte offset of the key within the file.
+/// @return < 0 if the option is unknown or the value is wrong, 0 otherwise.
+////////////////////////////////////////////////////////////////////////////////////////////////
+int ApplyConfigEntry(char* key, char* value, int token_offset)
+{
+    int option_index = GetOptionIndexFromLong(key, strlen(key));
+
+    if(option_index < 0)
+    {
+        ReportOptError(GET_OPT_ERR_UNKNOWN_OPTION, -1, token_offset, '\0', key, NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+        return GET_OPT_ERR_UNKNOWN_OPTION;
+    }
+
+    if(value == NULL && private_options[option_index].pub_opt.opt_needs_arg == GET_OPT_ARG_REQ_REQUIRED)
+    {
+        ReportOptErrorFromDef(GET_OPT_ERR_NO_ARG_FOUND, option_index, token_offset);
+        return GET_OPT_ERR_NO_ARG_FOUND;
+    }
+
+    return ApplyOptionValue(option_index, value, token_offset, GET_OPT_SRC_CONFIG_FILE);
+}
+
+///////////////////////////////////////////////////////////////////////////////////
+/// @brief Parses a "key = value" config file. Tokens are NUL-terminated in place.
+///        Empty lines and the ones starting with '#' or ';' are ignored.
+///        Keys not followed by any value are only allowed for boolean options.
+/// @param buffer Config file contents. buffer[buffer_size] must be writable.
+/// @param buffer_size Config file size.
+/// @return < 0 if any error happened, 0 otherwise.
+///////////////////////////////////////////////////////////////////////////////////
+int ParseConfigKeyValue(char* buffer, int buffer_size)
+{
+    char* cursor    = buffer;
+    char* end       = buffer + buffer_size;
+
+    while(cursor < end)
+    {
+        char* line_end = memchr(cursor, '\n', end - cursor);
+
+        if(line_end == NULL)
+        {
+            line_end = end;
+        }
+
+        char* key = GetOptSkipBlanks(cursor, line_end);
+        cursor = line_end + 1;
+
+        if(key == line_end || *key == GET_OPT_CFG_COMMENT || *key == GET_OPT_CFG_COMMENT_ALT)
+        {
+            continue;
+        }
+
+        // Keys may be written just as they would be in the command line.
+        if(line_end - key > 2 && key[0] == '-' && key[1] == '-')
+        {
+            key += 2;
+        }
+
+        char* key_end = key;
+        while(key_end < line_end && *key_end != GET_OPT_CFG_ASSIGN && !isspace((unsigned char)*key_end))
+        {
+            key_end++;
+        }
+
+        char* value     = GetOptSkipBlanks(key_end, line_end);
+        char* value_end = line_end;
+
+        if(value == line_end)
+        {
+            value = NULL;
+        }
+        else if(*value != GET_OPT_CFG_ASSIGN)
+        {
+            ReportOptError(GET_OPT_ERR_CONFIG_SYNTAX, -1, key - buffer, '\0', NULL, NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+            return GET_OPT_ERR_CONFIG_SYNTAX;
+        }
+        else
+        {
+            value = GetOptSkipBlanks(value + 1, line_end);
+
+            while(value_end > value && isspace((unsigned char)value_end[-1]))
+            {
+                value_end--;
+            }
+
+            if(value_end - value >= 2 && (*value == '"' || *value == '\'') && value_end[-1] == *value)
+            {
+                value++;
+                value_end--;
+            }
+
+            *value_end = '\0';
+        }
+
+        *key_end = '\0';
+
+        int apply_config_entry = ApplyConfigEntry(key, value, key - buffer);
+
+        if(apply_config_entry < 0)
+        {
+            return apply_config_entry;
+        }
+    }
 
     return GET_OPT_SUCCESS;
 }
 
-//////////////////////////////////////////////////////////////////////////////////
-/// @brief Generates the data needed by the long options parser.
-/// @param priv_opt_long Pointer to the struct array that's meant to be populated.
-/// @return GET_OPT_ERR_NULL_PTR if the pointer is null, 0 otherwise.
-//////////////////////////////////////////////////////////////////////////////////
-int GenerateOptLong(PRIV_OPT_LONG* priv_opt_long)
+//////////////////////////////////////////////////////////////////////////
+/// @brief Decodes predefined XML entities in place (&lt; &gt; &amp; ...).
+/// @param value NUL-terminated attribute value.
+//////////////////////////////////////////////////////////////////////////
+void DecodeXmlEntities(char* value)
 {
-    if(priv_opt_long == NULL)
+    static const char* entities[]   = {"&lt;", "&gt;", "&amp;", "&quot;", "&apos;"};
+    static const char  decoded[]    = {'<'   , '>'   , '&'    , '"'     , '\''    };
+
+    char* read_ptr  = strchr(value, '&');
+    char* write_ptr = read_ptr;
+
+    if(read_ptr == NULL)
     {
-        SVRTY_LOG_DBG("FILE: %s\tFUNCTION: %s\tLINE: %dss", __FILE__, __func__, __LINE__);
-        return GET_OPT_ERR_NULL_PTR;
+        return;
     }
 
-    memcpy(&priv_opt_long[0], &opt_long_verbose, sizeof(PRIV_OPT_LONG));
-    memcpy(&priv_opt_long[1], &opt_long_brief, sizeof(PRIV_OPT_LONG));
+    while(*read_ptr != '\0')
+    {
+        bool entity_found = false;
+
+        if(*read_ptr == '&')
+        {
+            for(int i = 0; i < (int)sizeof(decoded); i++)
+            {
+                int entity_len = strlen(entities[i]);
+
+                if(strncmp(read_ptr, entities[i], entity_len) == 0)
+                {
+                    *write_ptr++ = decoded[i];
+                    read_ptr += entity_len;
+                    entity_found = true;
+                    break;
+                }
+            }
+        }
 
-    for(int i = GET_OPT_SIZE_VERB_BRIEF; i < GET_OPT_SIZE_VERB_BRIEF + option_number; i++)
-    {
-        memcpy(&priv_opt_long[i], &private_options[i - GET_OPT_SIZE_VERB_BRIEF].struct_opt_long, sizeof(PRIV_OPT_LONG));
+        if(!entity_found)
+        {
+            *write_ptr++ = *read_ptr++;
+        }
     }
-    
-    memset(&priv_opt_long[GET_OPT_SIZE_VERB_BRIEF + option_number], 0, sizeof(PRIV_OPT_LONG));
 
-    return GET_OPT_SUCCESS;
+    *write_ptr = '\0';
 }
 
-///////////////////////////////////////////////////////////////////////////////
-/// @brief Casts the provided option argument to the proper type and stores it.
-/// @param priv_opt_def Private option definition.
-/// @param arg Argument to be casted.
-/// @param dest Destination variable.
-///////////////////////////////////////////////////////////////////////////////
-void CastParsedArgument(PRIV_OPT_DEFINITION* priv_opt_def, char* arg, OPT_DATA_TYPE* dest)
+///////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Parses an XML config file, following the same layout as the project's config.xml.
+///        Each option is an element named after the option's long name, and its value is
+///        found within the "value" attribute (i.e. <threads value="4"/>). Elements without
+///        a "value" attribute (such as the root one) are just containers and thus skipped.
+/// @param buffer Config file contents. buffer[buffer_size] must be writable.
+/// @param buffer_size Config file size.
+/// @return < 0 if any error happened, 0 otherwise.
+///////////////////////////////////////////////////////////////////////////////////////////
+int ParseConfigXml(char* buffer, int buffer_size)
 {
-    int var_type = priv_opt_def->pub_opt.opt_var_type;
+    char* cursor    = buffer;
+    char* end       = buffer + buffer_size;
 
-    switch(var_type)
+    while(cursor < end && (cursor = memchr(cursor, '<', end - cursor)) != NULL)
     {
-        case GET_OPT_TYPE_INT:
-        {
-            dest->integer = atoi(arg);
-        }
-        break;
+        int token_offset = cursor - buffer;
+        cursor++;
 
-        case GET_OPT_TYPE_CHAR:
+        // Skip comments, declarations and closing tags.
+        if(end - cursor >= 3 && strncmp(cursor, GET_OPT_CFG_XML_COMMENT_START, 3) == 0)
         {
-            if(strlen(optarg) > 1)
+            // The buffer is NUL-terminated right after the end of the file.
+            cursor = strstr(cursor, GET_OPT_CFG_XML_COMMENT_END);
+
+            if(cursor == NULL)
             {
-                SVRTY_LOG_WNG(GET_OPT_MSG_STRING_NOT_CHAR     ,
-                        priv_opt_def->pub_opt.opt_char  ,
-                        priv_opt_def->pub_opt.opt_long  ,
-                        priv_opt_def->pub_opt.opt_detail);
+                break;
             }
-            dest->character = (char)atoi(arg);
-        }
-        break;
 
-        case GET_OPT_TYPE_FLOAT:
-        {
-            dest->floating = atof(arg);
+            continue;
         }
-        break;
 
-        case GET_OPT_TYPE_DOUBLE:
+        if(cursor < end && (*cursor == '?' || *cursor == '!' || *cursor == '/'))
         {
-            dest->doubling = strtod(arg, NULL);
+            continue;
         }
-        break;
 
-        case GET_OPT_TYPE_CHAR_STRING:
+        char* name = cursor;
+        while(cursor < end && !isspace((unsigned char)*cursor) && *cursor != '/' && *cursor != '>')
         {
-            dest->char_string = arg;
+            cursor++;
         }
-        break;
+        char* name_end = cursor;
 
-        default:
-        break;
-    }
-}
+        char* value     = NULL;
+        char* value_end = NULL;
 
-//////////////////////////////////////////////////////////////////////////////////////
-/// @brief Assign value to the destination variable.
-/// @param priv_opt_def Private option definition, where the target variable is found.
-/// @param src Variable which stores the value to set.
-//////////////////////////////////////////////////////////////////////////////////////
-void AssignValue(PRIV_OPT_DEFINITION* priv_opt_def, OPT_DATA_TYPE src)
-{
-    switch(priv_opt_def->pub_opt.opt_var_type)
-    {
-        case GET_OPT_TYPE_INT:
+        // Go through attributes until the tag is closed.
+        while(cursor < end && *cursor != '>')
         {
-            // If no argument is required with an integer data type option, then it should be a boolean type option.
-            if(priv_opt_def->pub_opt.opt_needs_arg == GET_OPT_ARG_REQ_NO)
+            while(cursor < end && isspace((unsigned char)*cursor))
             {
-                *(bool*)(priv_opt_def->pub_opt.opt_dest_var) = (src.integer == 0 ? false : true);
-                break;
+                cursor++;
             }
 
-            *(int*)(priv_opt_def->pub_opt.opt_dest_var) = src.integer;
-        }
-        break;
+            if(cursor >= end || *cursor == '>' || *cursor == '/')
+            {
+                cursor++;
+                continue;
+            }
 
-        case GET_OPT_TYPE_CHAR:
-        {
-            *(char*)(priv_opt_def->pub_opt.opt_dest_var) = src.character;
-        }
-        break;
+            char* attr_name = cursor;
+            while(cursor < end && *cursor != '=' && !isspace((unsigned char)*cursor))
+            {
+                cursor++;
+            }
+            int attr_name_len = cursor - attr_name;
 
-        case GET_OPT_TYPE_FLOAT:
-        {
-            *(float*)(priv_opt_def->pub_opt.opt_dest_var) = src.floating;
+            while(cursor < end && isspace((unsigned char)*cursor))
+            {
+                cursor++;
+            }
+
+            if(cursor >= end || *cursor != '=')
+            {
+                ReportOptError(GET_OPT_ERR_CONFIG_SYNTAX, -1, attr_name - buffer, '\0', NULL, NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+                return GET_OPT_ERR_CONFIG_SYNTAX;
+            }
+
+            cursor++;
+            while(cursor < end && isspace((unsigned char)*cursor))
+            {
+                cursor++;
+            }
+
+            char* attr_end = NULL;
+
+            if(cursor < end && (*cursor == '"' || *cursor == '\''))
+            {
+                attr_end = memchr(cursor + 1, *cursor, end - cursor - 1);
+            }
+
+            if(attr_end == NULL)
+            {
+                ReportOptError(GET_OPT_ERR_CONFIG_SYNTAX, -1, attr_name - buffer, '\0', NULL, NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+                return GET_OPT_ERR_CONFIG_SYNTAX;
+            }
+
+            if( attr_name_len == strlen(GET_OPT_CFG_XML_VALUE_ATTR) &&
+                strncmp(attr_name, GET_OPT_CFG_XML_VALUE_ATTR, attr_name_len) == 0)
+            {
+                value       = cursor + 1;
+                value_end   = attr_end;
+            }
+
+            cursor = attr_end + 1;
         }
-        break;
 
-        case GET_OPT_TYPE_DOUBLE:
+        if(value == NULL)
         {
-            *(double*)(priv_opt_def->pub_opt.opt_dest_var) = src.doubling;
+            continue;
         }
-        break;
 
-        case GET_OPT_TYPE_CHAR_STRING:
+        // Elements holding a value always have attributes, so the name is followed by a blank character.
+        *name_end   = '\0';
+        *value_end  = '\0';
+        DecodeXmlEntities(value);
+
+        int apply_config_entry = ApplyConfigEntry(name, value, token_offset);
+
+        if(apply_config_entry < 0)
         {
-            strcpy((char*)(priv_opt_def->pub_opt.opt_dest_var), src.char_string);
+            return apply_config_entry;
         }
-        break;
-
-        default:
-        break;
     }
 
-    priv_opt_def->opt_has_value = true;
+    return GET_OPT_SUCCESS;
 }
 
-////////////////////////////////////////////////////////
-/// @brief Parses given options and arguments if needed.
-/// @param argc Argument count.
-/// @param argv Argument character string array.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Loads a config file, either "key = value" or XML formatted. The file is memory-mapped
+///        privately now, then tokenized in place by ParseOptions, so no per-line copies are made.
+///        Values go through the same conversion and boundary checks as command-line ones.
+/// @param config_file_path Path to the config file.
 /// @return < 0 if any error happened, 0 otherwise.
-////////////////////////////////////////////////////////
-int ParseOptions(int argc, char** argv)
+///////////////////////////////////////////////////////////////////////////////////////////////////
+int LoadOptionsConfigFile(char* config_file_path)
 {
-    int generate_short_options_string = GenerateShortOptStr();
-    
-    if(generate_short_options_string < 0)
+    if(config_file_path == NULL || private_options == NULL)
     {
-        SVRTY_LOG_ERR(GET_OPT_MSG_NULL_PTR);
-        FreeHeapOptData();
-        return generate_short_options_string;
+        ReportOptError(GET_OPT_ERR_NULL_PTR, -1, -1, '\0', NULL, NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+        return GET_OPT_ERR_NULL_PTR;
     }
 
-    PRIV_OPT_LONG priv_opt_long[GET_OPT_SIZE_VERB_BRIEF + option_number + 1];
+    PRIV_CONFIG_MAP config_map;
 
-    int generate_opt_long = GenerateOptLong(priv_opt_long);
+    int map_config_file = MapConfigFile(config_file_path, &config_map);
 
-    if(generate_opt_long < 0)
+    if(map_config_file < 0)
     {
-        SVRTY_LOG_ERR(GET_OPT_MSG_NULL_PTR);
-        FreeHeapOptData();
-        return generate_opt_long;
+        // A missing file is not a wrong input, so the already defined options are kept.
+        ReportOptError(map_config_file, -1, -1, '\0', NULL, NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+        return map_config_file;
     }
 
-    int current_option;
-    int current_option_index = 0;
-    while((current_option = getopt_long(argc, argv, short_options_string, priv_opt_long, &current_option_index)) != -1)
+    // String values staged from the file point to the mapping, so it's kept until option data is freed.
+    // The path is kept as well, so that the file can be mapped again when options are reloaded.
+    PRIV_CONFIG_MAP* new_config_maps = (PRIV_CONFIG_MAP*)realloc(config_maps, (config_map_number + 1) * sizeof(PRIV_CONFIG_MAP));
+    config_map.file_path = strdup(config_file_path);
+
+    if(new_config_maps == NULL || config_map.file_path == NULL)
     {
-        if(current_option == -1)
+        if(new_config_maps != NULL)
         {
-            break;
+            config_maps = new_config_maps;
         }
 
-        switch (current_option)
-        {
-            // Option sets a flag.
-            case 0:
-            {
-                if(verbose_flag == 0)
-                {
-                    SetSeverityLogMask(SVRTY_LOG_MASK_OFF);
-                }
-                else
-                {
-                    SetSeverityLogMask(SVRTY_LOG_MASK_ALL);
-                }
-            }
-            break;
-
-            // Missing option argument.
-            case ':':
-            {
-                SVRTY_LOG_ERR(GET_OPT_MSG_NO_ARG_FOUND, optopt);
-                FreeHeapOptData();
-                return GET_OPT_ERR_NO_ARG_FOUND;
-            }
-            break;
-
-            // Invalid option.
-            case '?':
-            {
-                SVRTY_LOG_ERR(GET_OPT_MSG_UNKNOWN_OPTION, optopt);
-                FreeHeapOptData();
-                return GET_OPT_ERR_UNKNOWN_OPTION;
-            }
-            break;
+        munmap(config_map.map_addr, config_map.map_size);
+        free(config_map.file_path);
+        ReportOptError(GET_OPT_ERR_NULL_PTR, -1, -1, '\0', NULL, NULL, GET_OPT_TYPE_MIN, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+        return GET_OPT_ERR_NULL_PTR;
+    }
 
-            default:
-            {
-                // First of all, get the index of the current option within the private option structure array.
-                int current_option_index;
-                for(current_option_index = 0; current_option_index < option_number; current_option_index++)
-                {
-                    if(private_options[current_option_index].pub_opt.opt_char == current_option)
-                    {
-                        break;
-                    }
-                }
+    config_maps = new_config_maps;
+    config_maps[config_map_number++] = config_map;
 
-                // Check if the option is boolean.
-                if(private_options[current_option_index].pub_opt.opt_needs_arg == GET_OPT_ARG_REQ_NO)
-                {
-                    *((bool*)(private_options[current_option_index].pub_opt.opt_dest_var)) = true;
-                    private_options[current_option_index].opt_has_value = true;
-                    // Go to next option.
-                    break;
-                }
+    return GET_OPT_SUCCESS;
+}
 
-                if(private_options[current_option_index].pub_opt.opt_needs_arg == GET_OPT_ARG_REQ_OPTIONAL)
-                {
-                    // Check whether anyvalue has been provided for the current option.
-                    if(optarg == NULL)
-                    {
-                        // Go to next option. The default value will be assigned to the current option later.
-                        break;
-                    }
-                }
+////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Maps a config file privately, with an extra zeroed byte so that it can be tokenized
+///        in place. The path is not filled in.
+/// @param config_file_path Path to the config file.
+/// @param config_map Where to store the mapping and file identity.
+/// @return GET_OPT_ERR_CONFIG_FILE if the file could not be opened or mapped, 0 otherwise.
+////////////////////////////////////////////////////////////////////////////////////////////////
+int MapConfigFile(char* config_file_path, PRIV_CONFIG_MAP* config_map)
+{
+    int config_fd = open(config_file_path, O_RDONLY);
+    struct stat config_stat;
 
-                OPT_DATA_TYPE parsed_argument;
-                int check_value_in_range;
+    if(config_fd < 0 || fstat(config_fd, &config_stat) < 0)
+    {
+        if(config_fd >= 0)
+        {
+            close(config_fd);
+        }
 
-                CastParsedArgument(&private_options[current_option_index], optarg, &parsed_argument);
+        return GET_OPT_ERR_CONFIG_FILE;
+    }
 
-                // Check if the provided value fits in the range delimited by the option's boundaries
-                check_value_in_range = CheckValueInRange(   private_options[current_option_index].pub_opt.opt_var_type  ,
-                                                            private_options[current_option_index].pub_opt.opt_min_value ,
-                                                            private_options[current_option_index].pub_opt.opt_max_value ,
-                                                            parsed_argument                                             );
+    size_t config_size = config_stat.st_size;
 
-                if(check_value_in_range < 0)
-                {
-                    SVRTY_LOG_ERR(GET_OPT_MSG_PROV_VAL_OUT_OF_BOUNDS                      ,
-                            private_options[current_option_index].pub_opt.opt_char  ,
-                            private_options[current_option_index].pub_opt.opt_long  ,
-                            private_options[current_option_index].pub_opt.opt_detail);
-                    FreeHeapOptData();
-                    return check_value_in_range;
-                }
+    // Reserve one more (anonymous, zeroed) byte than the file size, then map the file over it.
+    // This way the last token can also be NUL-terminated in place, even if the file size is page aligned.
+    char* config_buffer = mmap(NULL, config_size + 1, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
 
-                // If the value provided value is OK, then assign it to the destination variable.
-                AssignValue(&private_options[current_option_index], parsed_argument);
-            }
-            break;
+    if( config_buffer == MAP_FAILED ||
+        (config_size > 0 && mmap(config_buffer, config_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, config_fd, 0) == MAP_FAILED))
+    {
+        if(config_buffer != MAP_FAILED)
+        {
+            munmap(config_buffer, config_size + 1);
         }
+
+        close(config_fd);
+        return GET_OPT_ERR_CONFIG_FILE;
     }
 
-    // For each option, check if any value has been provided (has_value).
-    // If not, give it its default value.
-    for(int option_to_set_index = 0; option_to_set_index < option_number; option_to_set_index++)
+    close(config_fd);
+    config_buffer[config_size] = '\0';
+
+    config_map->map_addr    = config_buffer;
+    config_map->map_size    = config_size + 1;
+    config_map->file_dev    = config_stat.st_dev;
+    config_map->file_ino    = config_stat.st_ino;
+    config_map->file_size   = config_stat.st_size;
+    config_map->file_mtime  = config_stat.st_mtim;
+
+    return GET_OPT_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Parses every config file loaded so far, in the order they were loaded.
+/// @return < 0 if any error happened, 0 otherwise.
+////////////////////////////////////////////////////////////////////////////////
+int ApplyConfigFiles(void)
+{
+    for(int i = 0; i < config_map_number; i++)
     {
-        if(private_options[option_to_set_index].opt_has_value == false)
+        char* config_buffer = config_maps[i].map_addr;
+        int config_size = config_maps[i].map_size - 1;
+
+        char* first_token = config_buffer;
+        while(first_token < config_buffer + config_size && isspace((unsigned char)*first_token))
         {
-            // If the value provided value is OK, then assign it to the destination variable.
-            AssignValue(&private_options[option_to_set_index], private_options[option_to_set_index].pub_opt.opt_default_value);
-            private_options[option_to_set_index].opt_has_value = true;
+            first_token++;
         }
-    }
 
-    ShowOptions();
+        int parse_config;
 
-    FreeHeapOptData();
+        if(*first_token == '<')
+        {
+            parse_config = ParseConfigXml(config_buffer, config_size);
+        }
+        else
+        {
+            parse_config = ParseConfigKeyValue(config_buffer, config_size);
+        }
+
+        if(parse_config < 0)
+        {
+            return parse_config;
+        }
+    }
 
     return GET_OPT_SUCCESS;
 }
@@ -946,6 +8226,15 @@ char* GetOptionsGenFormattedStr(char* string_to_format, int data_type)
 /// @param var_to_print Variable to be printed.
 void PrintBoundaryData(char* option_summary_msg, int var_type, int blank_spaces_count, OPT_DATA_TYPE var_to_print)
 {
+    // Codec values are formatted by the codec, then printed as strings.
+    if(GET_OPT_IS_CODEC(var_type))
+    {
+        char codec_value[GET_OPT_SIZE_CODEC_FORMAT_MAX];
+        FormatOptCodecValue(var_type, var_to_print.custom, codec_value, sizeof(codec_value));
+        SVRTY_LOG_INF(GetOptionsGenFormattedStr(option_summary_msg, GET_OPT_TYPE_CHAR_STRING), blank_spaces_count, GET_OPT_MSG_OPT_VAL_SEPARATOR, codec_value);
+        return;
+    }
+
     char* formatted_string = GetOptionsGenFormattedStr(option_summary_msg, var_type);
 
     switch(var_type)
@@ -983,7 +8272,7 @@ void PrintBoundaryData(char* option_summary_msg, int var_type, int blank_spaces_
                 return;
             }
 
-            if(strcmp(var_to_print.char_string, max_str) == 0)
+            if(var_to_print.char_string == max_str)
             {
                 char* msg_max_len_str = GET_OPT_MSG_OPT_MAX_STR_VALUE;
                 SVRTY_LOG_INF(msg_max_len_str, blank_spaces_count, GET_OPT_MSG_OPT_VAL_SEPARATOR, PATH_MAX);
@@ -1004,6 +8293,11 @@ void ShowOptions(void)
     SVRTY_LOG_INF(GET_OPT_MSG_OPT_SUMMARY_HEADER);
     for(int option_num = 0; option_num < option_number; option_num++)
     {
+        if(GET_OPT_IS_REMOVED(&private_options[option_num]))
+        {
+            continue;
+        }
+
         char option_summary_msg[GET_OPT_SIZE_DETAIL_MAX + 1];
 
         int blank_spaces = 0;
@@ -1026,19 +8320,43 @@ void ShowOptions(void)
 
         blank_spaces = longest_opt_info_len - (int)strlen(GET_OPT_MSG_OPT_MAX_VALUE);
         memset(option_summary_msg, 0, sizeof(option_summary_msg)); strcpy(option_summary_msg, GET_OPT_MSG_OPT_MAX_VALUE);
-        PrintBoundaryData(option_summary_msg, private_options[option_num].pub_opt.opt_var_type, blank_spaces, private_options[option_num].pub_opt.opt_max_value);
+        if(private_options[option_num].opt_str_mode != GET_OPT_STR_MODE_COPY)
+        {
+            // Reference strings are only bounded by length.
+            char max_length[GET_OPT_SIZE_CODEC_FORMAT_MAX] = "-";
+            if(private_options[option_num].opt_str_max_length != 0)
+            {
+                snprintf(max_length, sizeof(max_length), GET_OPT_MSG_LENGTH_BYTES, private_options[option_num].opt_str_max_length);
+            }
+            SVRTY_LOG_INF(GetOptionsGenFormattedStr(option_summary_msg, GET_OPT_TYPE_CHAR_STRING), blank_spaces, GET_OPT_MSG_OPT_VAL_SEPARATOR, max_length);
+        }
+        else
+        {
+            PrintBoundaryData(option_summary_msg, private_options[option_num].pub_opt.opt_var_type, blank_spaces, private_options[option_num].pub_opt.opt_max_value);
+        }
 
         blank_spaces = longest_opt_info_len - (int)strlen(GET_OPT_MSG_OPT_DEFAULT_VALUE);
         memset(option_summary_msg, 0, sizeof(option_summary_msg)); strcpy(option_summary_msg, GET_OPT_MSG_OPT_DEFAULT_VALUE);
         PrintBoundaryData(option_summary_msg, private_options[option_num].pub_opt.opt_var_type, blank_spaces, private_options[option_num].pub_opt.opt_default_value);
 
+        if(private_options[option_num].pub_opt.opt_dest_var == NULL)
+        {
+            SVRTY_LOG_INF(GET_OPT_MSG_OPT_SUMMARY_FOOTER);
+            continue;
+        }
+
         blank_spaces = longest_opt_info_len - (int)strlen(GET_OPT_MSG_OPT_ASSIGNED_VALUE);
         memset(option_summary_msg, 0, sizeof(option_summary_msg)); strcpy(option_summary_msg, GET_OPT_MSG_OPT_ASSIGNED_VALUE);
         switch(private_options[option_num].pub_opt.opt_var_type)
         {
             case GET_OPT_TYPE_INT:
             {
-                if(private_options[option_num].pub_opt.opt_needs_arg == GET_OPT_ARG_REQ_NO)
+                if(private_options[option_num].opt_flag_mask != 0)
+                {
+                    bool flag_value = ((*(uint64_t*)(private_options[option_num].pub_opt.opt_dest_var) & private_options[option_num].opt_flag_mask) != 0);
+                    SVRTY_LOG_INF(GetOptionsGenFormattedStr(option_summary_msg, private_options[option_num].pub_opt.opt_var_type), blank_spaces, GET_OPT_MSG_OPT_VAL_SEPARATOR, flag_value);
+                }
+                else if(private_options[option_num].pub_opt.opt_needs_arg == GET_OPT_ARG_REQ_NO)
                 {
                     SVRTY_LOG_INF(GetOptionsGenFormattedStr(option_summary_msg, private_options[option_num].pub_opt.opt_var_type), blank_spaces, GET_OPT_MSG_OPT_VAL_SEPARATOR, *((bool*)(private_options[option_num].pub_opt.opt_dest_var)));
                 }
@@ -1062,16 +8380,67 @@ void ShowOptions(void)
             break;
 
             case GET_OPT_TYPE_CHAR_STRING:
-                SVRTY_LOG_INF(GetOptionsGenFormattedStr(option_summary_msg, private_options[option_num].pub_opt.opt_var_type), blank_spaces, GET_OPT_MSG_OPT_VAL_SEPARATOR, ((char*)(private_options[option_num].pub_opt.opt_dest_var)));
+            {
+                char* assigned_string = (private_options[option_num].opt_str_mode == GET_OPT_STR_MODE_COPY) ?
+                                        (char*)(private_options[option_num].pub_opt.opt_dest_var)           :
+                                        *(char**)(private_options[option_num].pub_opt.opt_dest_var)         ;
+                SVRTY_LOG_INF(GetOptionsGenFormattedStr(option_summary_msg, private_options[option_num].pub_opt.opt_var_type), blank_spaces, GET_OPT_MSG_OPT_VAL_SEPARATOR, assigned_string);
+            }
             break;
             
+            case GET_OPT_TYPE_BLOB_HEX:
+            case GET_OPT_TYPE_BLOB_BASE64:
+            {
+                // Blob contents (keys, salts) are never printed, only their length.
+                char blob_length[GET_OPT_SIZE_CODEC_FORMAT_MAX];
+                snprintf(blob_length, sizeof(blob_length), GET_OPT_MSG_LENGTH_BYTES, ((GET_OPT_BLOB*)(private_options[option_num].pub_opt.opt_dest_var))->length);
+                SVRTY_LOG_INF(GetOptionsGenFormattedStr(option_summary_msg, GET_OPT_TYPE_CHAR_STRING), blank_spaces, GET_OPT_MSG_OPT_VAL_SEPARATOR, blob_length);
+            }
+            break;
+
             default:
+                PrintBoundaryData(option_summary_msg, private_options[option_num].pub_opt.opt_var_type, blank_spaces, (OPT_DATA_TYPE){.custom = private_options[option_num].pub_opt.opt_dest_var});
             break;
         }
         SVRTY_LOG_INF(GET_OPT_MSG_OPT_SUMMARY_FOOTER);
     }
 }
 
+///////////////////////////////////////////////////////////////////////
+/// @brief Formats a codec value for summaries.
+/// @param var_type Option (codec) type.
+/// @param value Value, NULL for unset boundaries.
+/// @param buffer Destination buffer.
+/// @param buffer_size Destination buffer size.
+/// @return Formatted value length (as snprintf).
+///////////////////////////////////////////////////////////////////////
+int FormatOptCodecValue(int var_type, void* value, char* buffer, size_t buffer_size)
+{
+    if(value == NULL)
+    {
+        return snprintf(buffer, buffer_size, "-");
+    }
+
+    if(GET_OPT_CODEC_OF(var_type)->format == NULL || GET_OPT_CODEC_OF(var_type)->format(value, buffer, buffer_size) < 0)
+    {
+        return snprintf(buffer, buffer_size, "(%zu bytes)", GET_OPT_CODEC_OF(var_type)->value_size);
+    }
+
+    return strnlen(buffer, buffer_size);
+}
+
+/////////////////////////////////////////////////////////////////////
+/// @brief Fills max_str, the maximum shared by unbounded strings, the
+///        first time it is needed.
+/////////////////////////////////////////////////////////////////////
+void InitOptMaxString(void)
+{
+    if(max_str[0] == '\0')
+    {
+        memset(max_str, UCHAR_MAX, PATH_MAX);
+    }
+}
+
 //////////////////////////////////////////////////////////////////////////////
 /// @brief Set double option definition without boundaries.
 /// @param opt_char Option character.
@@ -1087,7 +8456,7 @@ int SetOptionDefinitionStringNoLimits(  char opt_char           ,
                                         char* opt_default_value ,
                                         void* opt_dest_var      )
 {
-    memset(max_str, UCHAR_MAX, PATH_MAX);
+    InitOptMaxString();
 
     int set_opt = SetOptionDefinition(  opt_char                                            ,
                                         opt_long                                            ,
@@ -1102,4 +8471,68 @@ int SetOptionDefinitionStringNoLimits(  char opt_char           ,
     return set_opt;
 }
 
+//////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Set reference string option definition: the destination is a char* pointed to the
+///        value, either copied into the options arena at its exact length or left within argv
+///        (or the environment). Values read from files are always copied into the arena.
+/// @param opt_char Option character.
+/// @param opt_long Option string.
+/// @param opt_detail Option details.
+/// @param opt_str_mode GET_OPT_STR_MODE_ARENA or GET_OPT_STR_MODE_VIEW.
+/// @param max_length Maximum value length, 0 for no limit.
+/// @param opt_default_value Option default value (pointed to as is in view mode). NULL for "".
+/// @param opt_dest_var Address to the variable meant to be set after parsing.
+/// @return < 0 if any error happened, 0 otherwise.
+//////////////////////////////////////////////////////////////////////////////////////////////
+int SetOptionDefinitionStringRef(   char    opt_char            ,
+                                    char*   opt_long            ,
+                                    char*   opt_detail          ,
+                                    int     opt_str_mode        ,
+                                    size_t  max_length          ,
+                                    char*   opt_default_value   ,
+                                    char**  opt_dest_var        )
+{
+    if(opt_str_mode != GET_OPT_STR_MODE_ARENA && opt_str_mode != GET_OPT_STR_MODE_VIEW)
+    {
+        ReportOptError(GET_OPT_ERR_UNKNOWN_TYPE, -1, -1, opt_char, opt_long, opt_detail, GET_OPT_TYPE_CHAR_STRING, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+        return RejectOptionDefinition(GET_OPT_ERR_UNKNOWN_TYPE);
+    }
+
+    char* default_value = (opt_default_value == NULL ? min_str : opt_default_value);
+
+    if(max_length != 0 && strnlen(default_value, max_length + 1) > max_length)
+    {
+        ReportOptError(GET_OPT_ERR_VAL_OUT_OF_BOUNDS, -1, -1, opt_char, opt_long, opt_detail, GET_OPT_TYPE_CHAR_STRING, (OPT_DATA_TYPE){0}, (OPT_DATA_TYPE){0});
+        return RejectOptionDefinition(GET_OPT_ERR_VAL_OUT_OF_BOUNDS);
+    }
+
+    // Registered as an unbounded string first: the default is only set afterwards, as it may
+    // exceed PATH_MAX, which regular string definitions would reject.
+    int set_option_definition = SetOptionDefinition(opt_char                                ,
+                                                    opt_long                                ,
+                                                    opt_detail                              ,
+                                                    GET_OPT_TYPE_CHAR_STRING                ,
+                                                    GET_OPT_ARG_REQ_REQUIRED                ,
+                                                    (OPT_DATA_TYPE){.char_string = min_str} ,
+                                                    (OPT_DATA_TYPE){.char_string = min_str} ,
+                                                    (OPT_DATA_TYPE){.char_string = min_str} ,
+                                                    opt_dest_var                            );
+
+    if(set_option_definition < 0)
+    {
+        return set_option_definition;
+    }
+
+    PRIV_OPT_DEFINITION* priv_opt_def = &private_options[GetOptionIndexFromLong(opt_long, strlen(opt_long))];
+
+    priv_opt_def->pub_opt.opt_default_value.char_string = default_value;
+    priv_opt_def->opt_value.char_string                 = default_value;
+    priv_opt_def->opt_str_mode                          = opt_str_mode;
+    priv_opt_def->opt_str_max_length                    = max_length;
+
+    BindOptionConverter(priv_opt_def);
+
+    return GET_OPT_SUCCESS;
+}
+
 /**************************************/
@@ -8,6 +8,9 @@
 #include <stdbool.h>
 #include <getopt.h>
 #include <stdlib.h> // malloc in SetOptionDefinitionStringNL
+#include <stdint.h> // uint32_t
+#include <sys/types.h>  // dev_t, ino_t, off_t
+#include <time.h>       // struct timespec
 #include "GetOptions_api.h"
 
 /************************************/
@@ -24,6 +27,158 @@
 
 #define GET_OPT_SIZE_VERB_BRIEF             2
 
+#define GET_OPT_SIZE_LONG_INDEX_MIN         16
+#define GET_OPT_SIZE_SHORT_OPT_CELL         3   // Option character plus up to two ':'.
+#define GET_OPT_SIZE_COMPACT_MIN            16
+#define GET_OPT_SIZE_CHOICE_TABLE_MAX       65536
+#define GET_OPT_CHOICE_SEED_TRIES           64
+#define GET_OPT_SIZE_CHARSET_WORDS          4   // 256-bit byte class mask.
+#define GET_OPT_SIZE_ENV_PREFIX_MAX         32
+#define GET_OPT_SIZE_READER_SLOTS           64
+#define GET_OPT_SIZE_SUGGESTION_MAX         4   // Long names suggested for unknown or ambiguous ones.
+
+/******** Long name trie ********/
+
+#define GET_OPT_TRIE_ROOT                   0
+#define GET_OPT_TRIE_MATCH_NONE             0
+#define GET_OPT_TRIE_MATCH_EXACT            1
+#define GET_OPT_TRIE_MATCH_PREFIX           2   // Unique prefix (abbreviation).
+#define GET_OPT_TRIE_MATCH_AMBIGUOUS        3
+#define GET_OPT_IS_ARGV_OPTION(arg)         ((arg)[0] == '-' && (arg)[1] != '\0')  // getopt non-options are anything else.
+#define GET_OPT_ARGV_END                    "--"
+
+/******** Option removal ********/
+
+#define GET_OPT_INDEX_TOMBSTONE             -1
+#define GET_OPT_IS_REMOVED(priv_opt_def)    ((priv_opt_def)->pub_opt.opt_char == '\0')
+
+/******** Codec types ********/
+
+// Endpoints and blobs are built-in codec types. Blob values have no fixed size (see GetOptCodecValueSize).
+#define GET_OPT_IS_BLOB(var_type)           ((var_type) == GET_OPT_TYPE_BLOB_HEX || (var_type) == GET_OPT_TYPE_BLOB_BASE64)
+#define GET_OPT_IS_CODEC(var_type)          ((var_type) == GET_OPT_TYPE_ENDPOINT || GET_OPT_IS_BLOB(var_type) || ((var_type) >= GET_OPT_TYPE_CODEC_MIN && (var_type) < GET_OPT_TYPE_CODEC_MIN + codec_number))
+#define GET_OPT_CODEC_OF(var_type)          ((var_type) == GET_OPT_TYPE_ENDPOINT ? &endpoint_codec : GET_OPT_IS_BLOB(var_type) ? &blob_codec : &option_codecs[(var_type) - GET_OPT_TYPE_CODEC_MIN])
+#define GET_OPT_IMG_NO_VALUE                UINT32_MAX  // Codec boundaries not set.
+#define GET_OPT_SIZE_CODEC_FORMAT_MAX       256
+#define GET_OPT_ENDPOINT_UNIX_PREFIX        "unix:"
+#define GET_OPT_ENDPOINT_PORT_MAX           65535
+
+/******** Blobs and options arena ********/
+
+#define GET_OPT_BLOB_DIGIT_INVALID          0xFF    // Decode table entry of characters out of the alphabet.
+#define GET_OPT_BLOB_BASE64_PAD             '='
+#define GET_OPT_BLOB_HEX_DIGITS             "0123456789abcdef"
+#define GET_OPT_BLOB_BASE64_DIGITS          "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/"
+#define GET_OPT_SIZE_ARENA_CHUNK_MIN        65536
+#define GET_OPT_SIZE_ARENA_CHUNK_MAX        (16 * 1024 * 1024)  // Chunks double in size up to this one.
+#define GET_OPT_ARENA_ALIGN(size)           (((size) + sizeof(uint64_t) - 1) & ~(sizeof(uint64_t) - 1))
+
+/******** Long name hashing ********/
+
+#define GET_OPT_HASH_FNV_OFFSET             2166136261U
+#define GET_OPT_HASH_FNV_PRIME              16777619U
+#define GET_OPT_HASH64_FNV_OFFSET           14695981039346656037ULL
+#define GET_OPT_HASH64_FNV_PRIME            1099511628211ULL
+
+/******** Options image (cache file) ********/
+
+#define GET_OPT_IMG_MAGIC                   0x54504F47U // "GOPT"
+#define GET_OPT_IMG_VERSION                 4
+#define GET_OPT_SCHEMA_MAGIC                0x53504F47U // "GOPS"
+
+// Image sections: header, records, long name hash index (slots store index + 1) and string pool.
+#define GET_OPT_IMG_RECORDS(image)          ((PRIV_OPT_IMG_RECORD*)((char*)(image) + sizeof(PRIV_OPT_IMG_HEADER)))
+#define GET_OPT_IMG_INDEX(image)            ((uint32_t*)(GET_OPT_IMG_RECORDS(image) + ((PRIV_OPT_IMG_HEADER*)(image))->option_number))
+#define GET_OPT_IMG_POOL(image)             ((char*)(GET_OPT_IMG_INDEX(image) + ((PRIV_OPT_IMG_HEADER*)(image))->index_size))
+#define GET_OPT_CACHE_TMP_SUFFIX            ".tmp"
+#define GET_OPT_CACHE_FILE_MODE             0600
+#define GET_OPT_SHARED_MEMFD_NAME           "GetOptions"
+#define GET_OPT_SHARED_SEALS                (F_SEAL_SEAL | F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE)
+
+/******** Value provenance ********/
+
+#define GET_OPT_PROV_BIT(source)            (1U << (source))
+// The highest bit set in a provenance mask is the source whose value wins.
+#define GET_OPT_PROV_WINNER(provenance)     (31 - __builtin_clz((unsigned int)(provenance)))
+
+/******** Option constraints ********/
+
+// Bitsets over option indices (seen options and constraint masks), in 64-bit words.
+#define GET_OPT_BITSET_WORDS(bits)          (((bits) + 63) / 64)
+#define GET_OPT_BITSET_SET(bitset, bit)     ((bitset)[(bit) / 64] |= (1ULL << ((bit) % 64)))
+#define GET_OPT_BITSET_TEST(bitset, bit)    (((bitset)[(bit) / 64] >> ((bit) % 64)) & 1ULL)
+#define GET_OPT_BITSET_CLEAR(bitset, bit)   ((bitset)[(bit) / 64] &= ~(1ULL << ((bit) % 64)))
+
+/******** Environment variables ********/
+
+// Character of an option long name as written in an environment variable name (--log-level -> LOG_LEVEL).
+#define GET_OPT_ENV_FOLD_CHAR(c)            ((c) == '-' ? '_' : toupper((unsigned char)(c)))
+
+/******** Config files ********/
+
+#define GET_OPT_CFG_COMMENT                 '#'
+#define GET_OPT_CFG_COMMENT_ALT             ';'
+#define GET_OPT_CFG_ASSIGN                  '='
+#define GET_OPT_CFG_XML_VALUE_ATTR          "value"
+#define GET_OPT_CFG_XML_COMMENT_START       "!--"
+#define GET_OPT_CFG_XML_COMMENT_END         "-->"
+
+/******** Command line strings ********/
+
+#define GET_OPT_CMD_IS_BLANK(c)             ((c) == ' ' || (c) == '\t' || (c) == '\n' || (c) == '\r')
+#define GET_OPT_CMD_QUOTE_SINGLE            '\''
+#define GET_OPT_CMD_QUOTE_DOUBLE            '"'
+#define GET_OPT_CMD_ESCAPE                  '\\'
+#define GET_OPT_CMD_DQ_ESCAPABLE            "\"\\$`\n"   // Characters a backslash escapes within double quotes.
+
+/******** Options streams ********/
+
+#define GET_OPT_STREAM_STATE_BLANK          0   // Between tokens.
+#define GET_OPT_STREAM_STATE_TOKEN          1
+#define GET_OPT_STREAM_STATE_QUOTE_SINGLE   2
+#define GET_OPT_STREAM_STATE_QUOTE_DOUBLE   3
+#define GET_OPT_STREAM_STATE_ESCAPE         4   // Right after a backslash, out of quotes.
+#define GET_OPT_STREAM_STATE_ESCAPE_DOUBLE  5   // Right after a backslash, within double quotes.
+#define GET_OPT_STREAM_STATE_SKIP           6   // Rest of a message with errors.
+#define GET_OPT_STREAM_MSG_END              '\n'
+
+/******** Argv synthesis ********/
+
+#define GET_OPT_ARGV_FMT_FLAG               "--%s"
+#define GET_OPT_ARGV_FMT_OPTION             "--%s="
+#define GET_OPT_ARGV_FMT_OVERRIDE           "--%s=%s"
+#define GET_OPT_ARGV_FMT_FLOAT              "%.9g"      // Enough digits for values to be parsed back exactly.
+#define GET_OPT_ARGV_FMT_DOUBLE             "%.17g"
+
+/******** JSON export ********/
+
+#define GET_OPT_JSON_TRUE                   "true"
+#define GET_OPT_JSON_FALSE                  "false"
+#define GET_OPT_JSON_NULL                   "null"
+#define GET_OPT_JSON_ESCAPE_UNICODE         "\\u00"   // Followed by two hex digits.
+#define GET_OPT_JSON_FRACTION_DIGITS_MAX    9           // Decimals tried before falling back to snprintf.
+#define GET_OPT_JSON_FLOAT_EXACT            16777216.0  // 2^24: integers exactly representable as float.
+#define GET_OPT_JSON_DOUBLE_EXACT           9007199254740992.0  // 2^53
+#define GET_OPT_JSON_NEEDS_ESCAPE(byte)     ((unsigned char)(byte) < 0x20 || (byte) == '"' || (byte) == '\\')
+
+/******** Boolean strings ********/
+
+#define GET_OPT_BOOL_STR_TRUE               "true"
+#define GET_OPT_BOOL_STR_YES                "yes"
+#define GET_OPT_BOOL_STR_ON                 "on"
+#define GET_OPT_BOOL_STR_FALSE              "false"
+#define GET_OPT_BOOL_STR_NO                 "no"
+#define GET_OPT_BOOL_STR_OFF                "off"
+
+/******** Debug logs ********/
+
+// Debug logs are only built in when GET_OPT_DEBUG_LOG is defined (see DEBUG version mode in Makefile).
+#ifdef GET_OPT_DEBUG_LOG
+#define GET_OPT_LOG_DBG(...)                SVRTY_LOG_DBG(__VA_ARGS__)
+#else
+#define GET_OPT_LOG_DBG(...)
+#endif
+
 /******** Error codes ********/
 
 #define GET_OPT_SUCCESS                     0
@@ -42,6 +197,34 @@
 #define GET_OPT_ERR_NULL_PTR                -13
 #define GET_OPT_ERR_NO_ARG_FOUND            -14
 #define GET_OPT_ERR_UNKNOWN_OPTION          -15
+#define GET_OPT_ERR_CONFIG_FILE             -16
+#define GET_OPT_ERR_CONFIG_SYNTAX           -17
+#define GET_OPT_ERR_CACHE_MISS              -18
+#define GET_OPT_ERR_CACHE_WRITE             -19
+#define GET_OPT_ERR_RELOAD_MODE             -20
+#define GET_OPT_ERR_READER_SLOTS            -21
+#define GET_OPT_ERR_NO_OPT_STORE            -22
+#define GET_OPT_ERR_SHARED_MEM              -23
+#define GET_OPT_ERR_SCHEMA_FILE             -24
+#define GET_OPT_ERR_REGISTRATION_BATCH      -25
+#define GET_OPT_ERR_CONSTRAINT_DEF          -26
+#define GET_OPT_ERR_REQUIRED_OPTION         -27
+#define GET_OPT_ERR_EXCLUSIVE_OPTIONS       -28
+#define GET_OPT_ERR_DEPENDENT_OPTION        -29
+#define GET_OPT_ERR_FLAG_SET                -30
+#define GET_OPT_ERR_FLAG_HEADER             -31
+#define GET_OPT_ERR_CHOICE_DEF              -32
+#define GET_OPT_ERR_UNKNOWN_CHOICE          -33
+#define GET_OPT_ERR_STRING_CONSTRAINT_DEF   -34
+#define GET_OPT_ERR_STRING_CONSTRAINT       -35
+#define GET_OPT_ERR_CODEC_DEF               -36
+#define GET_OPT_ERR_CODEC_VALUE             -37
+#define GET_OPT_ERR_CMDLINE_SYNTAX          -38
+#define GET_OPT_ERR_STREAM_TOKEN            -39
+#define GET_OPT_ERR_EXPORT_SIZE             -40
+#define GET_OPT_ERR_AMBIGUOUS_OPTION        -41
+#define GET_OPT_ERR_READ_SECTION            -42
+#define GET_OPT_ERR_FLAG_MACRO              -43
 
 /******** Messages ********/
 #define GET_OPT_MSG_NO_OPT_CHAR             "No option character provided."
@@ -61,6 +244,37 @@
 #define GET_OPT_MSG_ALREADY_NULL_PTR        "Pointer to memory meant to be freed is NULL."
 #define GET_OPT_MSG_NO_ARG_FOUND            "Option %c requires an argument!"
 #define GET_OPT_MSG_UNKNOWN_OPTION          "Unknown option (%c)."
+#define GET_OPT_MSG_UNKNOWN_OPTION_LONG     "Unknown option (--%s)."
+#define GET_OPT_MSG_UNKNOWN_OPTION_HANDLE   "Unknown option handle (%d)."
+#define GET_OPT_MSG_AMBIGUOUS_OPTION        "Ambiguous option (--%s), which several long options start with."
+#define GET_OPT_MSG_DID_YOU_MEAN            "Did you mean --%s?"
+#define GET_OPT_MSG_CONFIG_FILE             "Config file could not be opened or mapped."
+#define GET_OPT_MSG_CONFIG_SYNTAX           "Config file syntax error at byte %d."
+#define GET_OPT_MSG_RELOAD_MODE             "Options can only be reloaded (or read from a snapshot) in reload mode, once parsed."
+#define GET_OPT_MSG_READER_SLOTS            "Too many option reader threads (%d at most)."
+#define GET_OPT_MSG_READ_SECTION            "--%s points into the snapshot, so it can only be read within a read section (OptionsReadLock)."
+#define GET_OPT_MSG_NO_OPT_STORE            "No option store exists (options have not been parsed yet)."
+#define GET_OPT_MSG_SHARED_MEM              "Option store could not be exported to or attached from shared memory."
+#define GET_OPT_MSG_SCHEMA_FILE             "Schema file could not be written or loaded (missing, corrupted, or options already defined)."
+#define GET_OPT_MSG_CONSTRAINT_DEF          "Wrong option constraint: unknown type, or not enough options for it."
+#define GET_OPT_MSG_REQUIRED_OPTION         "Required option not given: -%c --%s."
+#define GET_OPT_MSG_EXCLUSIVE_OPTIONS       "Option can not be given along with the other ones in its group: -%c --%s."
+#define GET_OPT_MSG_DEPENDENT_OPTION        "Option required by another given option is missing: -%c --%s."
+#define GET_OPT_MSG_FLAG_SET                "No flag set has been provided, or there is no bit left in it: -%c --%s."
+#define GET_OPT_MSG_FLAG_HEADER             "Flag set header file could not be written."
+#define GET_OPT_MSG_FLAG_MACRO              "Flag header macro name of the option collides with another one: -%c --%s."
+#define GET_OPT_MSG_CHOICE_DEF              "Wrong choice list (empty, or with NULL or repeated values): -%c --%s."
+#define GET_OPT_MSG_UNKNOWN_CHOICE          "Value is not one of the choices of option: -%c --%s."
+#define GET_OPT_MSG_STRING_CONSTRAINT_DEF   "Wrong string constraint (not a string option, minimum length > maximum, or default value not meeting it): -%c --%s."
+#define GET_OPT_MSG_STRING_CONSTRAINT       "Value length, characters or prefix do not meet the string constraint of option: -%c --%s."
+#define GET_OPT_MSG_CODEC_DEF               "Wrong option codec (no parse callback or value size), or no codec slot left (%d at most)."
+#define GET_OPT_MSG_CODEC_VALUE             "Value could not be parsed by the codec of option: -%c --%s."
+#define GET_OPT_MSG_CMDLINE_SYNTAX          "Command line syntax error (unterminated quote or escape) at byte %d."
+#define GET_OPT_MSG_STREAM_TOKEN            "Control message token exceeds maximum length (%d bytes) at byte %d."
+#define GET_OPT_MSG_EXPORT_SIZE             "Options export does not fit within the buffer (at byte %d)."
+#define GET_OPT_MSG_REGISTRATION_BATCH      "Registration batches can not be nested, nor closed if none is open. Options can not be removed within them."
+#define GET_OPT_MSG_OPTION_RELOADED         "Option value reloaded: -%c --%s."
+#define GET_OPT_MSG_UNKNOWN_ERROR           "Unknown error code (%d)."
 #define GET_OPT_MSG_STRING_NOT_CHAR         "Passed string as argument to an option that requires a character instead: -%c --%s (%s)."
 #define GET_OPT_MSG_PROV_VAL_OUT_OF_BOUNDS  "Provided value is out of boundaries for current option: -%c --%s (%s)."
 #define GET_OPT_MSG_OPT_SUMMARY_HEADER      "*********** Options summary ***********"
@@ -77,6 +291,7 @@
 #define GET_OPT_MSG_OPT_VAL_SEPARATOR       ""
 #define GET_OPT_MSG_OPT_MIN_STR_VALUE       "Minimum value: %*s\\0"
 #define GET_OPT_MSG_OPT_MAX_STR_VALUE       "Maximum value: %*sUCHAR_MAX * %d"
+#define GET_OPT_MSG_LENGTH_BYTES            "%zu bytes"
 
 /***********************************/
 
@@ -86,13 +301,195 @@
 
 typedef struct option PRIV_OPT_LONG;
 
-typedef struct 
+typedef struct
+{
+    int                 choice_number   ;
+    uint32_t            hash_seed       ;   // Seed making the hash collision-free over every choice.
+    uint32_t            table_mask      ;
+    int*                table           ;   // Choice index + 1 per slot, 0 means empty.
+    char**              choices         ;   // Choice strings, within the same allocation.
+
+} PRIV_OPT_CHOICE;
+
+typedef struct
+{
+    size_t              min_length      ;
+    size_t              max_length      ;
+    uint64_t            charset[GET_OPT_SIZE_CHARSET_WORDS];    // Bit set for each allowed byte.
+    size_t              prefix_length   ;
+    char*               prefix          ;   // Within the same allocation.
+
+} PRIV_OPT_STR_CONSTRAINT;
+
+// Blob values and boundaries, length-prefixed so that images can hold them as they are.
+typedef struct
+{
+    size_t              length          ;   // Decoded length, which is what boundaries are about.
+    size_t              data_length     ;   // Bytes within data: length for values, 0 for boundaries.
+    uint8_t             data[]          ;
+
+} PRIV_OPT_BLOB_VALUE;
+
+typedef struct priv_opt_arena_chunk
+{
+    struct priv_opt_arena_chunk*    next;
+    size_t              size            ;
+    size_t              used            ;
+    char                data[]          ;   // 8-byte aligned, as the header is.
+
+} PRIV_OPT_ARENA_CHUNK;
+
+typedef struct priv_opt_definition PRIV_OPT_DEFINITION;
+
+// Converts an argument, checks it and, only if it is fine, stores it into value. Bound to each option once.
+typedef int (*PRIV_OPT_CONVERTER)(PRIV_OPT_DEFINITION* priv_opt_def, char* arg, OPT_DATA_TYPE* value);
+
+struct priv_opt_definition
 {
     PUB_OPT_DEFINITION  pub_opt         ;
-    PRIV_OPT_LONG       struct_opt_long ;
-    bool                opt_has_value   ;
+    int                 opt_dispatch    ;   // Position within short_options_string cells and the long options table.
+    OPT_DATA_TYPE       opt_value       ;   // Value staged from the highest precedence source found so far.
+    uint8_t             opt_provenance  ;   // Bit (1 << OPT_VALUE_SOURCE) set for each source providing a value.
+    uint64_t            opt_flag_mask   ;   // Flag options: bit within the flag set word opt_dest_var points to, 0 otherwise.
+    PRIV_OPT_CHOICE*    opt_choice      ;   // Choice options: perfect hash from choice strings to indices, NULL otherwise.
+    PRIV_OPT_STR_CONSTRAINT*    opt_str_constraint; // String options: length, charset and prefix constraint, NULL if none.
+    PRIV_OPT_CONVERTER  opt_convert     ;   // Convert + range check + store routine specialized for the option.
+    char*               opt_codec_values;   // Codec options: two value slots, one staged while the other one is parsed into.
+    void*               opt_codec_owned ;   // Codec boundaries (and default value) owned by the option (endpoints, blobs), NULL otherwise.
+    uint8_t             opt_str_mode    ;   // String options: OPT_STRING_MODE. Destinations are char* unless GET_OPT_STR_MODE_COPY.
+    size_t              opt_str_max_length; // Reference strings (arena or view modes): maximum length, 0 for none.
+    size_t              opt_argv_length ;   // Argv batch being built: size of the option's argument, 0 if left out.
+    int                 opt_argv_child  ;   // Argv batch being built: last child overriding the option, -1 if none.
+
+};
+
+typedef struct
+{
+    void*               opt_dest_var    ;
+    uint8_t             opt_provenance  ;
+
+} PRIV_OPT_PROVENANCE;
+
+typedef struct
+{
+    char*               file_path       ;
+    char*               map_addr        ;
+    size_t              map_size        ;
+    dev_t               file_dev        ;
+    ino_t               file_ino        ;
+    off_t               file_size       ;
+    struct timespec     file_mtime      ;
+
+} PRIV_CONFIG_MAP;
+
+typedef struct
+{
+    uint32_t            magic           ;
+    uint32_t            version         ;
+    uint64_t            key             ;   // Cache key, snapshot generation or schema file checksum.
+    uint32_t            option_number   ;
+    uint32_t            index_size      ;   // Long name hash index slots (power of two).
+    uint32_t            image_size      ;
+    int32_t             verbose_flag    ;
+    int32_t             next_arg_index  ;   // optind once argv has been parsed.
+
+} PRIV_OPT_IMG_HEADER;
+
+typedef union
+{
+    int32_t             integer         ;
+    char                character       ;
+    float               floating        ;
+    double              doubling        ;
+    uint32_t            str_offset      ;   // Offset within the image string pool.
+
+} PRIV_OPT_IMG_VALUE;
+
+typedef struct
+{
+    PRIV_OPT_IMG_VALUE  value           ;
+    PRIV_OPT_IMG_VALUE  min_value       ;
+    PRIV_OPT_IMG_VALUE  max_value       ;
+    PRIV_OPT_IMG_VALUE  default_value   ;
+    uint32_t            name_offset     ;   // Offset of the long name within the image string pool.
+    uint32_t            detail_offset   ;
+    int32_t             var_type        ;
+    int8_t              needs_arg       ;
+    char                opt_char        ;
+    uint8_t             provenance      ;
+    uint8_t             str_mode        ;   // OPT_STRING_MODE of string options.
+    uint64_t            str_max_length  ;   // Maximum length of reference strings, 0 for none.
+
+} PRIV_OPT_IMG_RECORD;
+
+typedef struct
+{
+    char*               string_pool     ;   // NULL while the image is only being sized.
+    uint32_t            pool_offset     ;
+    uint32_t            max_str_offset  ;   // UINT32_MAX until max_str has been pooled.
+
+} PRIV_OPT_IMG_BUILDER;
+
+// Radix trie node. Nodes are laid out in a single array, and children of a node are contiguous.
+typedef struct
+{
+    const char*         label           ;   // Edge label, within the long name of any option below.
+    uint16_t            label_length    ;
+    uint16_t            child_number    ;
+    uint32_t            first_child     ;   // Children are sorted by the first byte of their label.
+    uint32_t            leaf_number     ;   // Long names ending at or below this node.
+    int32_t             long_entry      ;   // Long options table entry ending here, -1 if none.
+    int32_t             option_index    ;   // -1 for none, and for --verbose and --brief.
+
+} PRIV_OPT_TRIE_NODE;
+
+typedef struct
+{
+    const char*         name            ;
+    int                 long_entry      ;
+    int                 option_index    ;
+
+} PRIV_OPT_TRIE_ENTRY;
+
+typedef struct
+{
+    // Longest generated name is "SET_" plus the long name.
+    char                name[GET_OPT_SIZE_LONG_MAX + 5] ;
+    int                 option_index                    ;
+
+} PRIV_OPT_FLAG_MACRO;
+
+typedef struct
+{
+    int                 match_type      ;   // GET_OPT_TRIE_MATCH_*.
+    uint32_t            node            ;   // Node matched, or the one below which the closest long names are.
+    size_t              matched_length  ;   // Token bytes matched.
+
+} PRIV_OPT_TRIE_MATCH;
+
+typedef struct
+{
+    char*               buffer          ;   // NULL while only sizing.
+    size_t              buffer_size     ;
+    size_t              length          ;
+
+} PRIV_OPT_EXPORT_WRITER;
+
+typedef struct
+{
+    char*               snapshot        ;
+    unsigned long       retire_epoch    ;
+
+} PRIV_OPT_RETIRED;
+
+typedef struct
+{
+    int                 constraint_type ;   // OPT_CONSTRAINT_TYPE.
+    int                 opt_long_number ;
+    char                (*opt_longs)[GET_OPT_SIZE_LONG_MAX + 1];    // Resolved into option indices when compiled.
+    int                 trigger_index   ;   // Dependent constraints: index of the option the other ones depend on.
 
-} PRIV_OPT_DEFINITION;
+} PRIV_OPT_CONSTRAINT;
 
 /**********************************/
 
@@ -101,8 +498,22 @@ typedef struct
 /*************************************/
 
 void FreeHeapOptData(void);
+void ReportOptError(int             code            ,
+                    int             option_index    ,
+                    int             token_offset    ,
+                    char            opt_char        ,
+                    char*           opt_long        ,
+                    char*           opt_detail      ,
+                    int             opt_var_type    ,
+                    OPT_DATA_TYPE   opt_min_value   ,
+                    OPT_DATA_TYPE   opt_max_value   );
+void ReportOptErrorFromDef(int code, int option_index, int token_offset);
 int CheckExistingOptionChar(char current_opt_char);
 int CheckExistingOptionLong(char* current_opt_long);
+uint32_t GetOptHashLong(char* opt_long, int opt_long_len);
+int InsertLongNameIndex(int option_index);
+void FillLongNameIndex(int* new_index, int new_size, int skip_index);
+int GetOptionIndexFromLong(char* opt_long, int opt_long_len);
 int CheckValidDataType(int opt_var_type);
 int CheckOptArgRequirement(int arg_requirement);
 int CheckOptLowerOrEqual(int opt_var_type, OPT_DATA_TYPE min, OPT_DATA_TYPE max);
@@ -113,6 +524,23 @@ int CheckValueInRange(   int             opt_var_type        ,
                          OPT_DATA_TYPE   opt_min_value     ,
                          OPT_DATA_TYPE   opt_max_value     ,
                          OPT_DATA_TYPE   opt_check_value );
+int RejectOptionDefinition(int code);
+int CompileOptionsConstraints(void);
+int CheckOptionsConstraints(void);
+int GetOptConstraintOffender(uint64_t* mask, int given, int nth);
+void FreeOptionsConstraints(void);
+void GetOptFlagMacroName(char* opt_long, char* macro_name);
+int CheckOptFlagMacroNames(void);
+int CompareOptFlagMacros(const void* macro_a, const void* macro_b);
+int GetOptFlagBit(PRIV_OPT_DEFINITION* priv_opt_def);
+void ReleaseOptFlagBit(PRIV_OPT_DEFINITION* priv_opt_def);
+PRIV_OPT_CHOICE* BuildOptionChoice(char** choices, int choice_number);
+uint32_t GetOptHashSeeded(uint32_t seed, char* string);
+int GetOptChoiceIndex(PRIV_OPT_CHOICE* choice, char* arg);
+void CompileOptCharset(char* charset, uint64_t* charset_mask);
+void InitOptMaxString(void);
+int CheckStringConstraint(PRIV_OPT_STR_CONSTRAINT* constraint, char* arg);
+void RollbackOptionDefinitions(int first_index);
 int FillPrivateOptStruct(char            opt_char            ,
                          char*           opt_long            ,
                          char*           opt_detail          ,
@@ -122,10 +550,108 @@ int FillPrivateOptStruct(char            opt_char            ,
                          OPT_DATA_TYPE   opt_max_value       ,
                          OPT_DATA_TYPE   opt_default_value   ,
                          void*           opt_dest_var        );
-int GenerateShortOptStr(void);
-int GenerateOptLong(PRIV_OPT_LONG* priv_opt_long);
-void CastParsedArgument(PRIV_OPT_DEFINITION* priv_opt_def, char* arg, OPT_DATA_TYPE* dest);
+int ReserveOptionDefinitions(int required_number);
+int AddOptionDispatch(int option_index);
+void RemoveOptionDispatch(int option_index);
+void RefreshOptionDispatchNames(void);
+void ReleaseLongNameTrie(void);
+PRIV_OPT_TRIE_NODE* GetLongNameTrie(void);
+int CompareOptTrieEntries(const void* entry_a, const void* entry_b);
+void FillLongNameTrieNode(PRIV_OPT_TRIE_ENTRY* entries, int first_entry, int last_entry, size_t depth, uint32_t node, uint32_t* node_number);
+PRIV_OPT_TRIE_MATCH FindLongNameTrie(const char* opt_long, size_t opt_long_length);
+uint32_t GetLongNameTrieLeaf(uint32_t node);
+int CollectLongNameTrie(uint32_t node, char** names, int name_max, int name_number);
+int ResolveOptionLong(char* opt_long, size_t opt_long_length, int token_offset);
+int ResolveArgvLongOption(int argc, char** argv, bool permute, PRIV_OPT_LONG** call_opt_long, PRIV_OPT_LONG* long_option_match);
+void RemoveLongNameIndex(int option_index);
+void RemoveOptionAt(int option_index);
+void CompactSparseOptionDefinitions(void);
+void CompactOptionDefinitions(void);
+void BindOptionConverter(PRIV_OPT_DEFINITION* priv_opt_def);
+int ConvertOptBool(PRIV_OPT_DEFINITION* priv_opt_def, char* arg, OPT_DATA_TYPE* value);
+int ConvertOptInt(PRIV_OPT_DEFINITION* priv_opt_def, char* arg, OPT_DATA_TYPE* value);
+int ConvertOptChoice(PRIV_OPT_DEFINITION* priv_opt_def, char* arg, OPT_DATA_TYPE* value);
+int ConvertOptChar(PRIV_OPT_DEFINITION* priv_opt_def, char* arg, OPT_DATA_TYPE* value);
+int ConvertOptFloat(PRIV_OPT_DEFINITION* priv_opt_def, char* arg, OPT_DATA_TYPE* value);
+int ConvertOptDouble(PRIV_OPT_DEFINITION* priv_opt_def, char* arg, OPT_DATA_TYPE* value);
+int ConvertOptString(PRIV_OPT_DEFINITION* priv_opt_def, char* arg, OPT_DATA_TYPE* value);
+int ConvertOptConstrainedString(PRIV_OPT_DEFINITION* priv_opt_def, char* arg, OPT_DATA_TYPE* value);
+int ConvertOptCodec(PRIV_OPT_DEFINITION* priv_opt_def, char* arg, OPT_DATA_TYPE* value);
+int ConvertOptStringRef(PRIV_OPT_DEFINITION* priv_opt_def, char* arg, OPT_DATA_TYPE* value);
+int PinOptionValue(PRIV_OPT_DEFINITION* priv_opt_def);
+int FormatOptCodecValue(int var_type, void* value, char* buffer, size_t buffer_size);
+int ParseOptEndpoint(char* arg, void* value);
+int CompareOptEndpoint(void* value_a, void* value_b);
+int FormatOptEndpoint(void* value, char* buffer, size_t buffer_size);
+int GetOptEndpointPort(struct sockaddr_storage* endpoint);
+int ConvertOptBlob(PRIV_OPT_DEFINITION* priv_opt_def, char* arg, OPT_DATA_TYPE* value);
+void InitOptBlobTables(void);
+int GetOptBlobLength(int blob_type, char* arg, size_t arg_len, size_t* length);
+int DecodeOptBlob(int blob_type, char* arg, PRIV_OPT_BLOB_VALUE* blob);
+int CompareOptBlob(void* value_a, void* value_b);
+int FormatOptBlob(void* value, char* buffer, size_t buffer_size);
+size_t GetOptCodecValueSize(int var_type, void* value);
+void* GetOptArenaAlloc(size_t size);
+void ReleaseOptArenaAlloc(void* allocation);
 void AssignValue(PRIV_OPT_DEFINITION* priv_opt_def, OPT_DATA_TYPE src);
+int ApplyOptionValue(int option_index, char* arg, int token_offset, int source);
+int GetOptParseBool(char* arg);
+int RetainOptionsProvenance(void);
+uint32_t GetOptHashEnvName(char* name, int name_len);
+int ApplyEnvironmentOptions(void);
+char* GetOptSkipBlanks(char* cursor, char* end);
+int ApplyConfigEntry(char* key, char* value, int token_offset);
+int ParseConfigKeyValue(char* buffer, int buffer_size);
+void DecodeXmlEntities(char* value);
+int ParseConfigXml(char* buffer, int buffer_size);
+int ApplyConfigFiles(void);
+uint64_t GetOptHash64(uint64_t hash, void* data, size_t data_size);
+uint64_t GetOptHashValue(uint64_t hash, int var_type, OPT_DATA_TYPE value);
+uint64_t GetOptionsCacheKey(int argc, char** argv);
+int ApplyOptionsCache(uint64_t cache_key);
+int CheckOptionsImage(char* image, size_t image_size, uint64_t key);
+OPT_DATA_TYPE GetOptImageValue(PRIV_OPT_IMG_RECORD* record, char* string_pool);
+OPT_DATA_TYPE GetOptImageTypedValue(int var_type, PRIV_OPT_IMG_VALUE* img_value, char* string_pool);
+void PutOptImageValue(PRIV_OPT_IMG_BUILDER* builder, int var_type, OPT_DATA_TYPE value, PRIV_OPT_IMG_VALUE* img_value);
+uint32_t PutOptImageString(PRIV_OPT_IMG_BUILDER* builder, char* string);
+uint32_t PutOptImageBytes(PRIV_OPT_IMG_BUILDER* builder, void* bytes, size_t byte_number);
+int CheckOptImageBytes(char* string_pool, size_t pool_size, uint32_t bytes_offset, int var_type, bool may_be_unset);
+int CheckOptionsImageLayout(char* image, size_t image_size);
+int CheckOptImageString(char* string_pool, size_t pool_size, uint32_t string_offset);
+char* BuildOptionsImage(uint64_t key, size_t* image_size);
+int SaveOptionsCache(uint64_t cache_key);
+int WriteOptionsImageFile(char* file_path, char* image, size_t image_size);
+uint64_t GetOptionsImageChecksum(char* image, size_t image_size);
+int ParseArgvOptions(int argc, char** argv, PRIV_OPT_LONG* priv_opt_long);
+int FinishParseOptions(int argc, char** argv, int parse_result, int snapshot_published);
+int TokenizeOptionsCmdline(char* cmdline, size_t* tokens_size);
+int ParseOptionsTokens(char* tokens, int token_number);
+int PushOptionsStreamByte(GET_OPT_STREAM* stream, char byte);
+int EndOptionsStreamToken(GET_OPT_STREAM* stream);
+int StartOptionsStreamOption(GET_OPT_STREAM* stream, int option_index, char* arg);
+int EmitOptionsStreamOption(GET_OPT_STREAM* stream, int option_index, char* arg);
+int FailOptionsStream(GET_OPT_STREAM* stream, int code);
+int EndOptionsStreamMessage(GET_OPT_STREAM* stream);
+bool IsOptArgvIncluded(PRIV_OPT_DEFINITION* priv_opt_def, int argv_mode);
+int FormatOptArgvToken(PRIV_OPT_DEFINITION* priv_opt_def, char* buffer, size_t buffer_size);
+int FormatOptArgvValue(PRIV_OPT_DEFINITION* priv_opt_def, OPT_DATA_TYPE value, char* buffer, size_t buffer_size);
+int FormatOptArgvOverride(PRIV_OPT_DEFINITION* priv_opt_def, const char* value, char* buffer, size_t buffer_size);
+int EncodeOptBlob(int blob_type, PRIV_OPT_BLOB_VALUE* blob, char* buffer, size_t buffer_size);
+int CompareOptValue(int var_type, OPT_DATA_TYPE value_a, OPT_DATA_TYPE value_b);
+int MapConfigFile(char* config_file_path, PRIV_CONFIG_MAP* config_map);
+int RemapConfigFiles(void);
+int CompareOptionsImageRecord(char* image_a, char* image_b, int option_index);
+void PublishOptionsSnapshot(char* snapshot);
+void ReclaimOptionsSnapshots(void);
+char* AcquireOptionsSnapshot(void);
+int GetOptImageIndex(char* image, char* opt_long);
+OPT_DATA_TYPE GetOptStoreValue(int opt_handle, int var_type);
+void FreeOptionsSnapshot(char* snapshot);
+bool PutOptExportBytes(PRIV_OPT_EXPORT_WRITER* writer, const char* bytes, size_t byte_number);
+bool PutOptJsonString(PRIV_OPT_EXPORT_WRITER* writer, const char* string, size_t length);
+bool PutOptJsonInteger(PRIV_OPT_EXPORT_WRITER* writer, int64_t integer);
+bool PutOptJsonFloating(PRIV_OPT_EXPORT_WRITER* writer, double floating, bool single_precision);
+bool PutOptJsonValue(PRIV_OPT_EXPORT_WRITER* writer, PRIV_OPT_IMG_RECORD* record, OPT_DATA_TYPE value);
 char* GetOptionsGenFormattedStr(char* string_to_format, int data_type);
 void PrintBoundaryData(char* option_summary_msg, int var_type, int blank_spaces_count, OPT_DATA_TYPE var_to_print);
 void ShowOptions(void);
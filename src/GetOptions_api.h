@@ -11,6 +11,10 @@ extern "C" {
 
 #include <limits.h> // INT_MIN, INT_MAX, CHAR_MIN, CHAR_MAX
 #include <float.h>  // FLT_MIN, FLT_MAX, DBL_MIN, DBL_MAX
+#include <stdbool.h> // bool
+#include <stdint.h> // uint64_t
+#include <stddef.h> // size_t
+#include <sys/socket.h> // struct sockaddr_storage
 
 /************************************/
 
@@ -24,9 +28,27 @@ extern "C" {
 
 #define GET_OPT_SIZE_LONG_MAX           50
 #define GET_OPT_SIZE_DETAIL_MAX         50
+#define GET_OPT_SIZE_DIAG_MSG_MAX       256
+#define GET_OPT_SIZE_CODEC_MAX          32
+#define GET_OPT_SIZE_STREAM_TOKEN_MAX   4096
 
 /*****************************/
 
+/******** Flag sets ********/
+
+// Boolean options may be packed as bits of a caller-provided uint64_t array (see SetOptionsFlagSet).
+#define GET_OPT_FLAG_WORDS(flag_number)         (((flag_number) + 63) / 64)
+#define GET_OPT_FLAG_TEST(flag_set, flag_bit)   (((flag_set)[(flag_bit) / 64] >> ((flag_bit) % 64)) & 1ULL)
+#define GET_OPT_FLAG_SET(flag_set, flag_bit)    ((flag_set)[(flag_bit) / 64] |= (1ULL << ((flag_bit) % 64)))
+#define GET_OPT_FLAG_CLEAR(flag_set, flag_bit)  ((flag_set)[(flag_bit) / 64] &= ~(1ULL << ((flag_bit) % 64)))
+
+/******** Export records ********/
+
+// Binary records (see ExportOptionsRecord): header, then one slot per option handle, then string and codec bytes.
+#define GET_OPT_RECORD_MAGIC                    0x52504F47U // "GOPR"
+#define GET_OPT_RECORD_VERSION                  1
+#define GET_OPT_RECORD_NO_VALUE                 UINT32_MAX  // Offset of unset codec values.
+
 /**********************************/
 /******** Type definitions ********/
 /**********************************/
@@ -39,7 +61,11 @@ typedef enum C_GET_OPTIONS_API
     GET_OPT_TYPE_FLOAT          = 2,
     GET_OPT_TYPE_DOUBLE         = 3,
     GET_OPT_TYPE_CHAR_STRING    = 4,
-    GET_OPT_TYPE_MAX            = 4,
+    GET_OPT_TYPE_ENDPOINT       = 5,    // struct sockaddr_storage: "1.2.3.4:80", "[::1]:80" or "unix:/path".
+    GET_OPT_TYPE_BLOB_HEX       = 6,    // GET_OPT_BLOB given as hex digits. Defined through SetOptionDefinitionBlob only.
+    GET_OPT_TYPE_BLOB_BASE64    = 7,    // GET_OPT_BLOB given as base64 (standard or URL-safe alphabet, padding optional).
+    GET_OPT_TYPE_MAX            = 7,
+    GET_OPT_TYPE_CODEC_MIN      = 16,   // Types registered through RegisterOptionCodec, up to GET_OPT_SIZE_CODEC_MAX.
 
 } OPT_DATA_SUPPORTED_TYPES;
 
@@ -53,6 +79,56 @@ typedef enum C_GET_OPTIONS_API
 
 } OPT_ARG_REQUIREMENT;
 
+typedef enum C_GET_OPTIONS_API
+{
+    GET_OPT_SRC_DEFAULT         = 0,
+    GET_OPT_SRC_CONFIG_FILE     = 1,
+    GET_OPT_SRC_ENV             = 2,
+    GET_OPT_SRC_ARGV            = 3,
+    GET_OPT_SRC_MAX             = 3,
+
+} OPT_VALUE_SOURCE;
+
+typedef enum C_GET_OPTIONS_API
+{
+    GET_OPT_CONSTRAINT_MIN          = 0,
+    GET_OPT_CONSTRAINT_REQUIRED     = 0,    // Every option in the group must be given.
+    GET_OPT_CONSTRAINT_EXCLUSIVE    = 1,    // At most one option in the group may be given.
+    GET_OPT_CONSTRAINT_ONE_OF       = 2,    // Exactly one option in the group must be given.
+    GET_OPT_CONSTRAINT_DEPENDENT    = 3,    // If the first option is given, every other one must be given too.
+    GET_OPT_CONSTRAINT_MAX          = 3,
+
+} OPT_CONSTRAINT_TYPE;
+
+typedef enum C_GET_OPTIONS_API
+{
+    GET_OPT_STR_MODE_MIN        = 0,
+    GET_OPT_STR_MODE_COPY       = 0,    // Copied into a caller buffer of PATH_MAX + 1 bytes (SetOptionDefinitionString).
+    GET_OPT_STR_MODE_ARENA      = 1,    // Copied into the options arena, at its exact length.
+    GET_OPT_STR_MODE_VIEW       = 2,    // Pointed to within argv or the environment. Config file values go to the arena.
+    GET_OPT_STR_MODE_MAX        = 2,
+
+} OPT_STRING_MODE;
+
+typedef enum C_GET_OPTIONS_API
+{
+    GET_OPT_STREAM_EVENT_MIN        = 0,
+    GET_OPT_STREAM_EVENT_OPTION     = 0,    // An option (and its argument, if any) has been parsed.
+    GET_OPT_STREAM_EVENT_ERROR      = 1,    // The rest of the message is skipped.
+    GET_OPT_STREAM_EVENT_END        = 2,    // End of message (newline).
+    GET_OPT_STREAM_EVENT_MAX        = 2,
+
+} OPT_STREAM_EVENT;
+
+typedef enum C_GET_OPTIONS_API
+{
+    GET_OPT_ARGV_MODE_MIN       = 0,
+    GET_OPT_ARGV_MODE_FULL      = 0,    // Every option with a value that can be given on the command line.
+    GET_OPT_ARGV_MODE_DELTA     = 1,    // Only options whose value is not the default one.
+    GET_OPT_ARGV_MODE_MAX       = 1,
+
+} OPT_ARGV_MODE;
+
 typedef union C_GET_OPTIONS_API
 {
     int     integer;
@@ -60,9 +136,33 @@ typedef union C_GET_OPTIONS_API
     float   floating;
     double  doubling;
     char*   char_string;
+    void*   custom;         // Codec types: value in its binary form. NULL boundaries mean no boundary.
 
 } OPT_DATA_TYPE;
 
+//////////////////////////////////////////////////////////////////////////////////////
+/// @brief User-defined option type. Values are converted once, at parse time, straight
+///        into their binary form (value_size bytes), which is what destinations get.
+//////////////////////////////////////////////////////////////////////////////////////
+typedef struct C_GET_OPTIONS_API
+{
+    size_t  value_size                                                      ;
+    int     (*parse)    (char* arg, void* value)                            ;   // < 0 if arg is not valid.
+    int     (*compare)  (void* value_a, void* value_b)                      ;   // < 0, 0, > 0 like strcmp. NULL if unordered.
+    int     (*format)   (void* value, char* buffer, size_t buffer_size)     ;   // snprintf-like. NULL if not printable.
+
+} GET_OPT_CODEC;
+
+//////////////////////////////////////////////////////////////////////////////////////
+/// @brief Decoded binary blob. Data belongs to the options arena (see FreeOptionsArena).
+//////////////////////////////////////////////////////////////////////////////////////
+typedef struct C_GET_OPTIONS_API
+{
+    const uint8_t*  data    ;
+    size_t          length  ;
+
+} GET_OPT_BLOB;
+
 ////////////////////////////////////////////////////////////
 /// @brief Public structure, meant to be filled by the user.
 ////////////////////////////////////////////////////////////
@@ -80,6 +180,123 @@ typedef struct C_GET_OPTIONS_API
 
 } PUB_OPT_DEFINITION;
 
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Structured error record, filled instead of logging when provided.
+//////////////////////////////////////////////////////////////////////////////
+typedef struct C_GET_OPTIONS_API
+{
+    int             code                                    ;   // Error code (< 0).
+    int             option_index                            ;   // Index of the option within the registry, -1 if unknown.
+    int             token_offset                            ;   // Index of the offending token within argv (byte offset for config files, environ index for environment variables), -1 if not parsing.
+    char            opt_char                                ;
+    char            opt_long[GET_OPT_SIZE_LONG_MAX + 1]     ;
+    char            opt_detail[GET_OPT_SIZE_DETAIL_MAX + 1] ;
+    int             opt_var_type                            ;
+    OPT_DATA_TYPE   expected_min                            ;
+    OPT_DATA_TYPE   expected_max                            ;
+
+} GET_OPT_DIAG;
+
+//////////////////////////////////////////////////////////////////////////////////////
+/// @brief Event emitted by an options stream (see FeedOptionsStream).
+//////////////////////////////////////////////////////////////////////////////////////
+typedef struct C_GET_OPTIONS_API
+{
+    int             event           ;   // OPT_STREAM_EVENT.
+    int             code            ;   // Error code (GET_OPT_STREAM_EVENT_ERROR), or result of the whole message (GET_OPT_STREAM_EVENT_END).
+    char            opt_char        ;   // Option events only, as the fields below.
+    const char*     opt_long        ;
+    int             opt_var_type    ;
+    OPT_DATA_TYPE   value           ;   // Converted value. Strings and blobs only stay valid within the callback.
+
+} GET_OPT_STREAM_EVENT;
+
+//////////////////////////////////////////////////////////////////////////////////////
+/// @brief Option value overriding the resolved one in a synthesized argv.
+//////////////////////////////////////////////////////////////////////////////////////
+typedef struct C_GET_OPTIONS_API
+{
+    const char*     opt_long    ;   // Option long name. Entries with no name are ignored.
+    const char*     value       ;   // As written on the command line. NULL for boolean options (or optional arguments).
+
+} GET_OPT_OVERRIDE;
+
+//////////////////////////////////////////////////////////////////////////////////////
+/// @brief Synthesized argv (see BuildOptionsArgv). Arguments are laid out one after
+///        another, NUL-terminated, so they can be used either way.
+//////////////////////////////////////////////////////////////////////////////////////
+typedef struct C_GET_OPTIONS_API
+{
+    int             argc            ;
+    char**          argv            ;   // NULL-terminated, argv[0] being the program.
+    char*           cmdline         ;   // Same arguments, as in /proc/<pid>/cmdline.
+    size_t          cmdline_size    ;
+
+} GET_OPT_ARGV;
+
+//////////////////////////////////////////////////////////////////////////////////////
+/// @brief Options export, owned by the caller. JSON keys are escaped once, when it is
+///        initialized, and then copied as they are on every export.
+//////////////////////////////////////////////////////////////////////////////////////
+typedef struct C_GET_OPTIONS_API
+{
+    int             option_number   ;
+    uint32_t*       key_offsets     ;   // option_number + 1 offsets within keys.
+    char*           keys            ;   // ,"long": for each option (no comma for the first one), within the same allocation.
+
+} GET_OPT_EXPORT;
+
+//////////////////////////////////////////////////////////////////////////////////////
+/// @brief Binary record header (see ExportOptionsRecord). Records are native-endian.
+//////////////////////////////////////////////////////////////////////////////////////
+typedef struct C_GET_OPTIONS_API
+{
+    uint32_t        magic           ;
+    uint32_t        version         ;
+    uint64_t        generation      ;   // Snapshot the values were taken from.
+    uint32_t        option_number   ;
+    uint32_t        record_size     ;
+
+} GET_OPT_RECORD_HEADER;
+
+//////////////////////////////////////////////////////////////////////////////////////
+/// @brief Binary record slot, one per option handle. Characters are stored as
+///        integers, as are boolean and choice options (choice index).
+//////////////////////////////////////////////////////////////////////////////////////
+typedef union C_GET_OPTIONS_API
+{
+    int32_t         integer         ;
+    float           floating        ;
+    double          doubling        ;
+    struct
+    {
+        uint32_t    offset          ;   // From the start of the record. GET_OPT_RECORD_NO_VALUE if unset.
+        uint32_t    length          ;   // Strings are NUL-terminated too, codec values are in their binary form.
+    } bytes;
+
+} GET_OPT_RECORD_SLOT;
+
+typedef void (*GET_OPT_STREAM_CALLBACK)(GET_OPT_STREAM_EVENT* event, void* user_data);
+
+//////////////////////////////////////////////////////////////////////////////////////
+/// @brief Push-style options parser state, owned by the caller. Only the token being
+///        parsed is kept, so messages of any length are parsed without buffering them.
+//////////////////////////////////////////////////////////////////////////////////////
+typedef struct C_GET_OPTIONS_API
+{
+    GET_OPT_STREAM_CALLBACK callback                                    ;
+    void*                   user_data                                   ;
+    int                     state                                       ;   // Tokenizer state (private).
+    int                     resume_state                                ;   // State to go back to after an escape (private).
+    int                     pending_option                              ;   // Option waiting for its argument, -1 if none.
+    int                     message_result                              ;   // First error found within the current message, 0 if none.
+    size_t                  message_offset                              ;   // Bytes of the current message fed so far.
+    size_t                  token_length                                ;   // Bytes of the current (partial) token.
+    int                     short_index[UCHAR_MAX + 1]                  ;   // Option index of each option character, -1 if none.
+    char                    token[GET_OPT_SIZE_STREAM_TOKEN_MAX + 1]    ;
+
+} GET_OPT_STREAM;
+
 /**********************************/
 
 /*************************************/
@@ -416,6 +633,37 @@ C_GET_OPTIONS_API int SetOptionDefinitionStringNoLimits(char opt_char
                                             (char*)opt_default_value    ,   \
                                             opt_dest_var                )   
 
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Set option definition for a type registered by RegisterOptionCodec.
+/// @param opt_char Option character.
+/// @param opt_long Option string.
+/// @param opt_detail Option details.
+/// @param opt_codec_type Type returned by RegisterOptionCodec.
+/// @param opt_min_value Address of the minimum value, NULL for none.
+/// @param opt_max_value Address of the maximum value, NULL for none.
+/// @param opt_default_value Address of the default value.
+/// @param opt_dest_var Address to the variable meant to be set after parsing.
+/// @return < 0 if any error happened, 0 otherwise.
+//////////////////////////////////////////////////////////////////////////////
+#define SetOptionDefinitionCodec(   opt_char            ,                       \
+                                    opt_long            ,                       \
+                                    opt_detail          ,                       \
+                                    opt_codec_type      ,                       \
+                                    opt_min_value       ,                       \
+                                    opt_max_value       ,                       \
+                                    opt_default_value   ,                       \
+                                    opt_dest_var        )                       \
+                                                                                \
+        SetOptionDefinition(    opt_char                                    ,   \
+                                (char*)opt_long                             ,   \
+                                (char*)opt_detail                           ,   \
+                                opt_codec_type                              ,   \
+                                GET_OPT_ARG_REQ_REQUIRED                    ,   \
+                                (OPT_DATA_TYPE){.custom = opt_min_value}    ,   \
+                                (OPT_DATA_TYPE){.custom = opt_max_value}    ,   \
+                                (OPT_DATA_TYPE){.custom = opt_default_value},   \
+                                opt_dest_var                                )
+
 ///////////////////////////////////////////////////////////////////////////
 /// @brief Set multiple option definition taking a struct array as input. 
 /// @param pub_opt_def Head of the array which includes option definitions.
@@ -424,6 +672,209 @@ C_GET_OPTIONS_API int SetOptionDefinitionStringNoLimits(char opt_char
 ///////////////////////////////////////////////////////////////////////////
 C_GET_OPTIONS_API int GetOptDefFromStruct(PUB_OPT_DEFINITION* pub_opt_def, int pub_opt_def_size);
 
+////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Set choice option definition: its value must be one of the given strings,
+///        and the index of the matching one is stored (i.e. with {"fast", "safe"},
+///        "--mode safe" stores 1). Values that are not choices are reported as errors.
+/// @param opt_char Option character.
+/// @param opt_long Option string.
+/// @param opt_detail Option details.
+/// @param choices Allowed strings.
+/// @param choice_number Number of allowed strings.
+/// @param opt_default_value Index of the default choice.
+/// @param opt_dest_var Address to the variable meant to be set after parsing.
+/// @return < 0 if any error happened, 0 otherwise.
+////////////////////////////////////////////////////////////////////////////////////////
+C_GET_OPTIONS_API int SetOptionDefinitionChoice(char    opt_char            ,
+                                                char*   opt_long            ,
+                                                char*   opt_detail          ,
+                                                char**  choices             ,
+                                                int     choice_number       ,
+                                                int     opt_default_value   ,
+                                                int*    opt_dest_var        );
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Sets a string constraint on an already defined string option: length bounds,
+///        allowed characters and required prefix, all of them checked in a single pass
+///        over each value. The default value must meet the constraint as well.
+/// @param opt_long Option string.
+/// @param min_length Minimum value length.
+/// @param max_length Maximum value length, 0 for PATH_MAX (no limit for reference strings).
+/// @param charset Allowed characters, where "a-z" stands for a whole range. NULL for any.
+/// @param prefix Prefix every value must start with. NULL for none.
+/// @return < 0 if any error happened, 0 otherwise.
+/////////////////////////////////////////////////////////////////////////////////////////////
+C_GET_OPTIONS_API int SetOptionStringConstraint(char*   opt_long    ,
+                                                size_t  min_length  ,
+                                                size_t  max_length  ,
+                                                char*   charset     ,
+                                                char*   prefix      );
+
+//////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Registers a user-defined option type. Its values are parsed, bounds-checked
+///        (compare) and shown (format) through the codec callbacks. Types are numbered
+///        in registration order, so processes sharing schema files or option stores
+///        must register the same codecs in the same order.
+/// @param codec Codec (copied). parse is mandatory, and value_size must not be 0.
+/// @return < 0 if any error happened, type to define options with otherwise.
+//////////////////////////////////////////////////////////////////////////////////////////
+C_GET_OPTIONS_API int RegisterOptionCodec(GET_OPT_CODEC* codec);
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Set network endpoint option definition. Values are parsed without any name lookup
+///        straight into the destination: "1.2.3.4:80" (IPv4), "[::1]:80" (IPv6) or
+///        "unix:/run/app.sock" (Unix domain socket, which has no port to be bounded).
+/// @param opt_char Option character.
+/// @param opt_long Option string.
+/// @param opt_detail Option details.
+/// @param min_port Minimum port, from 0.
+/// @param max_port Maximum port, up to 65535 and not lower than min_port.
+/// @param opt_default_value Default endpoint, NULL for none (AF_UNSPEC).
+/// @param opt_dest_var Address to the variable meant to be set after parsing.
+/// @return < 0 if any error happened, 0 otherwise.
+//////////////////////////////////////////////////////////////////////////////////////////////
+C_GET_OPTIONS_API int SetOptionDefinitionEndpoint(  char                        opt_char            ,
+                                                    char*                       opt_long            ,
+                                                    char*                       opt_detail          ,
+                                                    int                         min_port            ,
+                                                    int                         max_port            ,
+                                                    char*                       opt_default_value   ,
+                                                    struct sockaddr_storage*    opt_dest_var        );
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Set binary blob option definition. Values are decoded (hex or base64) at parse time
+///        straight into the options arena, so there is no length ceiling other than the given
+///        maximum, and destinations are only pointed to the decoded bytes.
+/// @param opt_char Option character.
+/// @param opt_long Option string.
+/// @param opt_detail Option details.
+/// @param opt_blob_type GET_OPT_TYPE_BLOB_HEX or GET_OPT_TYPE_BLOB_BASE64.
+/// @param min_length Minimum decoded length (bytes).
+/// @param max_length Maximum decoded length (bytes), 0 for no limit.
+/// @param opt_default_value Default value, encoded as values are. NULL for an empty blob.
+/// @param opt_dest_var Address to the variable meant to be set after parsing.
+/// @return < 0 if any error happened, 0 otherwise.
+//////////////////////////////////////////////////////////////////////////////////////////////
+C_GET_OPTIONS_API int SetOptionDefinitionBlob(  char            opt_char            ,
+                                                char*           opt_long            ,
+                                                char*           opt_detail          ,
+                                                int             opt_blob_type       ,
+                                                size_t          min_length          ,
+                                                size_t          max_length          ,
+                                                char*           opt_default_value   ,
+                                                GET_OPT_BLOB*   opt_dest_var        );
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Set reference string option definition: the destination is a char* pointed to the
+///        value, either copied into the options arena at its exact length or left within argv
+///        (or the environment), so memory use is proportional to the input and there is no
+///        PATH_MAX ceiling.
+/// @param opt_char Option character.
+/// @param opt_long Option string.
+/// @param opt_detail Option details.
+/// @param opt_str_mode GET_OPT_STR_MODE_ARENA or GET_OPT_STR_MODE_VIEW.
+/// @param max_length Maximum value length, 0 for no limit.
+/// @param opt_default_value Option default value (pointed to as is in view mode). NULL for "".
+/// @param opt_dest_var Address to the variable meant to be set after parsing.
+/// @return < 0 if any error happened, 0 otherwise.
+//////////////////////////////////////////////////////////////////////////////////////////////
+C_GET_OPTIONS_API int SetOptionDefinitionStringRef( char    opt_char            ,
+                                                    char*   opt_long            ,
+                                                    char*   opt_detail          ,
+                                                    int     opt_str_mode        ,
+                                                    size_t  max_length          ,
+                                                    char*   opt_default_value   ,
+                                                    char**  opt_dest_var        );
+
+//////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Frees the options arena, where blob values and reference strings are stored.
+///        Destinations pointing to it are no longer valid afterwards, so it is kept until
+///        this is called, even after ParseOptions (and across reloads, which only append
+///        to it).
+//////////////////////////////////////////////////////////////////////////////////////////
+C_GET_OPTIONS_API void FreeOptionsArena(void);
+
+//////////////////////////////////////////////////////////////////////////////////////
+/// @brief Sets the flag set boolean options defined by SetOptionDefinitionFlag are
+///        packed into, one bit each, so that 512 flags fit within a cache line.
+/// @param flag_set Caller-provided array, GET_OPT_FLAG_WORDS(flag_number) words long.
+/// @param flag_number Number of flags (bits) the array can hold.
+/// @return < 0 if any error happened (i.e. flags already defined do not fit within
+///         the new set), 0 otherwise. Setting the same set again keeps their bits.
+//////////////////////////////////////////////////////////////////////////////////////
+C_GET_OPTIONS_API int SetOptionsFlagSet(uint64_t* flag_set, int flag_number);
+
+/////////////////////////////////////////////////////////////////////////////////////
+/// @brief Sets a boolean option definition whose destination is the lowest free
+///        bit of the flag set. Bits of removed flags are free again.
+///        Test it with GET_OPT_FLAG_TEST(flag_set, bit).
+/// @param opt_char Option character.
+/// @param opt_long Option string.
+/// @param opt_detail Option details.
+/// @param opt_default_value Option default value.
+/// @return < 0 if any error happened, bit of the flag within the flag set otherwise.
+/////////////////////////////////////////////////////////////////////////////////////
+C_GET_OPTIONS_API int SetOptionDefinitionFlag(char opt_char, char* opt_long, char* opt_detail, bool opt_default_value);
+
+///////////////////////////////////////////////////////////////////////////////////////
+/// @brief Writes a C header with the bit of every flag option, plus test and set
+///        macros for each one (i.e. with "APP_" as prefix, --fast-path gets
+///        APP_FAST_PATH_BIT, APP_FAST_PATH(flag_set) and APP_SET_FAST_PATH(flag_set)).
+/// @param header_path Header file path.
+/// @param macro_prefix Prefix for every macro name.
+/// @return < 0 if any error happened (i.e. two flags get the same macro name, as
+///         --fast-path and --fast_path do), 0 otherwise.
+///////////////////////////////////////////////////////////////////////////////////////
+C_GET_OPTIONS_API int WriteOptionsFlagHeader(char* header_path, char* macro_prefix);
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Opens a registration batch: options defined from now on are either all kept (see
+///        CommitOptionsRegistration) or all rolled back, leaving previous options untouched.
+/// @return < 0 if a batch is already open, 0 otherwise.
+///////////////////////////////////////////////////////////////////////////////////////////////
+C_GET_OPTIONS_API int BeginOptionsRegistration(void);
+
+/////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Closes the current registration batch. If any definition within it failed,
+///        every option defined within the batch is rolled back.
+/// @return < 0 (first error within the batch) if it was rolled back, 0 otherwise.
+/////////////////////////////////////////////////////////////////////////////////////////
+C_GET_OPTIONS_API int CommitOptionsRegistration(void);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Closes the current registration batch, rolling back every option
+///        defined within it.
+/// @return < 0 if no batch is open, 0 otherwise.
+////////////////////////////////////////////////////////////////////////////////
+C_GET_OPTIONS_API int AbortOptionsRegistration(void);
+
+///////////////////////////////////////////////////////////////////////////////////////
+/// @brief Removes an option, given its long name. The option is left out of following
+///        parsings (or reloads), and its slot is reused by options defined later on,
+///        once no option store is published (handles never change while one is).
+/// @param opt_long Option string.
+/// @return < 0 if the option is unknown or a registration batch is open, 0 otherwise.
+///////////////////////////////////////////////////////////////////////////////////////
+C_GET_OPTIONS_API int RemoveOptionDefinition(char* opt_long);
+
+///////////////////////////////////////////////////////////////////////////////////////
+/// @brief Removes an option, given its handle (see GetOptHandle).
+/// @param opt_handle Option handle.
+/// @return < 0 if the option is unknown or a registration batch is open, 0 otherwise.
+///////////////////////////////////////////////////////////////////////////////////////
+C_GET_OPTIONS_API int RemoveOptionDefinitionByHandle(int opt_handle);
+
+//////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Attaches a constraint to a group of already defined options (i.e. exactly one
+///        of --input or --stdin). Constraints are checked once every source has been
+///        parsed, before any destination variable is written.
+/// @param constraint_type Constraint type (OPT_CONSTRAINT_TYPE).
+/// @param opt_longs Long names of the options in the group.
+/// @param opt_long_number Number of options in the group.
+/// @return < 0 if the constraint is wrong or any option is unknown, 0 otherwise.
+//////////////////////////////////////////////////////////////////////////////////////////
+C_GET_OPTIONS_API int SetOptionsConstraint(int constraint_type, char** opt_longs, int opt_long_number);
+
 ////////////////////////////////////////////////////////
 /// @brief Parses given options and arguments if needed.
 /// @param argc Argument count.
@@ -432,6 +883,357 @@ C_GET_OPTIONS_API int GetOptDefFromStruct(PUB_OPT_DEFINITION* pub_opt_def, int p
 ////////////////////////////////////////////////////////
 C_GET_OPTIONS_API int ParseOptions(int argc, char** argv);
 
+/////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Parses options given as a single command line string (i.e. a job spec or a
+///        systemd ExecStart line), program name included. The string is tokenized in place
+///        as a shell would (blanks, single and double quotes, backslash escapes), so it is
+///        modified, and it must stay valid as long as argv would (reference strings in view
+///        mode, reload mode). Tokens are not copied: only a view of them is kept in the
+///        options arena (see FreeOptionsArena).
+/// @param cmdline Command line string.
+/// @return < 0 if any error happened, 0 otherwise.
+/////////////////////////////////////////////////////////////////////////////////////////////
+C_GET_OPTIONS_API int ParseOptionsFromString(char* cmdline);
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Parses options given as NUL-terminated arguments laid out one after another, as
+///        read from /proc/<pid>/cmdline, program name included. Arguments are used in place,
+///        as with ParseOptionsFromString.
+/// @param cmdline NUL-separated arguments.
+/// @param cmdline_size Size of cmdline, every argument terminator included.
+/// @return < 0 if any error happened, 0 otherwise.
+/////////////////////////////////////////////////////////////////////////////////////////////
+C_GET_OPTIONS_API int ParseOptionsFromCmdline(char* cmdline, size_t cmdline_size);
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Completes a long option name (i.e. for shell completion): gets the long names
+///        starting with prefix, in lexicographic order. Long names are looked up through
+///        the trie parsing also resolves them with, so it takes O(prefix length) to find
+///        them. Needs the option schema (before ParseOptions, or in reload mode).
+/// @param prefix Long name prefix, without dashes.
+/// @param completions Where to store up to completion_max long names (owned by options).
+/// @param completion_max Maximum number of long names to store.
+/// @return < 0 if any error happened, number of long names starting with prefix otherwise
+///         (which may be greater than completion_max).
+/////////////////////////////////////////////////////////////////////////////////////////////
+C_GET_OPTIONS_API int CompleteOptionLong(char* prefix, char** completions, int completion_max);
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Gets the long names closest to a mistyped one ("did you mean"): the ones sharing
+///        the longest prefix with it, in lexicographic order. Parsing suggests them too.
+///        Needs the option schema (before ParseOptions, or in reload mode).
+/// @param opt_long Long name (as given, without dashes, up to any '=').
+/// @param suggestions Where to store up to suggestion_max long names (owned by options).
+/// @param suggestion_max Maximum number of long names to store.
+/// @return < 0 if any error happened, number of suggested long names otherwise (0 if no
+///         long name even starts with the same character).
+/////////////////////////////////////////////////////////////////////////////////////////////
+C_GET_OPTIONS_API int SuggestOptionLong(char* opt_long, char** suggestions, int suggestion_max);
+
+//////////////////////////////////////////////////////////////////////////////////
+/// @brief Sets the record in which errors are stored instead of being logged.
+///        Records are only written when an error happens. NULL restores logging.
+/// @param diag Caller-owned error record.
+//////////////////////////////////////////////////////////////////////////////////
+C_GET_OPTIONS_API void SetOptionsDiagnostics(GET_OPT_DIAG* diag);
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief Formats the message matching a previously filled error record.
+/// @param diag Error record.
+/// @param buffer Destination buffer.
+/// @param buffer_size Destination buffer size.
+/// @return < 0 if any error happened, formatted message length otherwise.
+//////////////////////////////////////////////////////////////////////////////
+C_GET_OPTIONS_API int GetOptionsDiagMessage(GET_OPT_DIAG* diag, char* buffer, int buffer_size);
+
+///////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Loads option values from a config file ("key = value" lines or XML elements
+///        such as <option_long value="..."/>). Must be called after defining the options
+///        and before ParseOptions, which is the one actually parsing the file.
+/// @param config_file_path Path to the config file.
+/// @return < 0 if any error happened, 0 otherwise.
+///////////////////////////////////////////////////////////////////////////////////////////
+C_GET_OPTIONS_API int LoadOptionsConfigFile(char* config_file_path);
+
+/////////////////////////////////////////////////////////////////////////////////////
+/// @brief Sets the prefix of the environment variables options fall back to.
+///        For instance, with "APP_" as prefix, --threads is bound to APP_THREADS.
+///        Environment values override default and config file ones, argv overrides
+///        them all.
+/// @param prefix Environment variable prefix. NULL disables the binding.
+/// @return < 0 if any error happened, 0 otherwise.
+/////////////////////////////////////////////////////////////////////////////////////
+C_GET_OPTIONS_API int SetOptionsEnvPrefix(char* prefix);
+
+////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Gets the sources that provided a value for an option during the last parsing.
+/// @param opt_dest_var Address of the option's destination variable.
+/// @return Bitmask with bit (1 << OPT_VALUE_SOURCE) set for each source that provided
+///         a value (the default one is always set), < 0 if the option is unknown.
+////////////////////////////////////////////////////////////////////////////////////////////
+C_GET_OPTIONS_API int GetOptionProvenance(void* opt_dest_var);
+
+//////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Gets the source the value of an option came from during the last parsing.
+/// @param opt_dest_var Address of the option's destination variable.
+/// @return OPT_VALUE_SOURCE the value came from, < 0 if the option is unknown.
+//////////////////////////////////////////////////////////////////////////////////////////
+C_GET_OPTIONS_API int GetOptionSource(void* opt_dest_var);
+
+//////////////////////////////////////////////////////////////////////////////////////
+/// @brief Sets the file in which resolved option values are cached across restarts.
+///        If the schema, argv, bound environment variables and config files (size and
+///        modification time) are the same as when the cache was written, ParseOptions
+///        takes the values straight from it. Otherwise, options are parsed as usual.
+///        Note that argv is not permuted when values are taken from the cache.
+/// @param cache_file Path to the cache file. NULL disables caching.
+/// @return < 0 if any error happened, 0 otherwise.
+//////////////////////////////////////////////////////////////////////////////////////
+C_GET_OPTIONS_API int SetOptionsCacheFile(char* cache_file);
+
+///////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Enables or disables reload mode. Must be called before ParseOptions. In reload
+///        mode, ParseOptions keeps the option schema (and argv, which must stay valid) and
+///        publishes resolved values as an immutable snapshot, so that options can be
+///        reloaded later on without restarting. EndOptionsReload frees everything.
+/// @param enable 0 to disable reload mode, anything else to enable it.
+///////////////////////////////////////////////////////////////////////////////////////////
+C_GET_OPTIONS_API void SetOptionsReloadMode(int enable);
+
+//////////////////////////////////////////////////////////////////////////////////////
+/// @brief Requests options to be reloaded. Async-signal-safe: it only sets a flag, so
+///        it can be installed as a SIGHUP handler (i.e. signal(SIGHUP, ...)).
+/// @param signum Signal number (unused).
+//////////////////////////////////////////////////////////////////////////////////////
+C_GET_OPTIONS_API void RequestOptionsReload(int signum);
+
+///////////////////////////////////////////////////////////////////////////////////
+/// @brief Reloads options if a reload has been requested (RequestOptionsReload).
+///        Meant to be polled from the service main loop, never from the handler.
+/// @return < 0 if any error happened, number of changed options otherwise.
+///////////////////////////////////////////////////////////////////////////////////
+C_GET_OPTIONS_API int PollOptionsReload(void);
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Parses config files, environment variables and argv again into a new snapshot,
+///        compares it to the current one and publishes it with a single atomic pointer swap.
+///        Destination variables of changed options are updated as well. The current snapshot
+///        is kept if anything goes wrong. Must not be called by more than one thread at once.
+/// @return < 0 if any error happened, number of changed options otherwise.
+//////////////////////////////////////////////////////////////////////////////////////////////
+C_GET_OPTIONS_API int ReloadOptions(void);
+
+//////////////////////////////////////////////////////////////////////////////////////
+/// @brief Enters a read section. Snapshots retired by reloads are only freed once
+///        every reader has left the read section it was in. Sections can be nested.
+/// @return < 0 if any error happened, 0 otherwise.
+//////////////////////////////////////////////////////////////////////////////////////
+C_GET_OPTIONS_API int OptionsReadLock(void);
+
+//////////////////////////////////////////////
+/// @brief Leaves a read section.
+//////////////////////////////////////////////
+C_GET_OPTIONS_API void OptionsReadUnlock(void);
+
+/////////////////////////////////////////////////////////////////////////////////
+/// @brief Releases the reader slot claimed by the calling thread. Meant to be
+///        called by reader threads before exiting.
+/////////////////////////////////////////////////////////////////////////////////
+C_GET_OPTIONS_API void ReleaseOptionsReader(void);
+
+///////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Copies the current value of an option (from the published snapshot) into value.
+///        Blob data and reference strings are not copied: they belong to the snapshot, like
+///        typed getter strings, so they can only be read (and used) within a read section
+///        (OptionsReadLock) the caller is in.
+/// @param opt_long Option long name.
+/// @param value Where to copy the value to. Same type as the option destination variable.
+/// @return < 0 if any error happened (or if a blob or reference string is read outside
+///         a read section), 0 otherwise.
+///////////////////////////////////////////////////////////////////////////////////////////
+C_GET_OPTIONS_API int ReadOptionValue(char* opt_long, void* value);
+
+//////////////////////////////////////////////////////////////////////////////////////
+/// @brief Leaves reload mode, freeing the option schema and every snapshot. No reader
+///        may be within a read section when this is called.
+//////////////////////////////////////////////////////////////////////////////////////
+C_GET_OPTIONS_API void EndOptionsReload(void);
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Initializes an options stream, meant to parse control messages (i.e. coming from
+///        a UNIX socket) written with the command line syntax: "--set-log-level 3 --drain".
+///        Streams reuse the schema kept in reload mode, so options must have been parsed
+///        in reload mode before, and streams must be fed by the thread reloading options.
+/// @param stream Stream state.
+/// @param callback Function called for every event.
+/// @param user_data Passed to callback as is.
+/// @return < 0 if any error happened, 0 otherwise.
+//////////////////////////////////////////////////////////////////////////////////////////////
+C_GET_OPTIONS_API int InitOptionsStream(GET_OPT_STREAM* stream, GET_OPT_STREAM_CALLBACK callback, void* user_data);
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Feeds an options stream with the next chunk of bytes, however they are split.
+///        Messages end with a newline (out of quotes), and tokens are split as a shell would.
+///        Values are converted and checked as ParseOptions does, but nothing is assigned:
+///        events are emitted instead. No memory is allocated: blobs are decoded into the
+///        options arena, which gets them back once emitted. Messages with errors are
+///        skipped up to their end.
+/// @param stream Stream state.
+/// @param chunk Bytes received.
+/// @param chunk_size Number of bytes received.
+/// @return First error found within the chunk, 0 if none.
+//////////////////////////////////////////////////////////////////////////////////////////////
+C_GET_OPTIONS_API int FeedOptionsStream(GET_OPT_STREAM* stream, const char* chunk, size_t chunk_size);
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Builds the command lines of a batch of child processes out of the resolved option
+///        values (i.e. for execv or posix_spawn), one "--option=value" argument per option.
+///        Children share the resolved values, and each one gets its own overrides on top.
+///        Boolean options can only be given, so false ones are left out. Uses the schema
+///        kept in reload mode, so options must have been parsed in reload mode before.
+/// @param program Program name (argv[0]). NULL for the one options were parsed with.
+/// @param argv_mode OPT_ARGV_MODE.
+/// @param overrides override_number entries per child, child after child.
+/// @param override_number Number of overrides per child.
+/// @param child_number Number of children.
+/// @param children Where to store the child_number command lines, built within a single
+///        allocation, to be released with free().
+/// @return < 0 if any error happened, 0 otherwise.
+///////////////////////////////////////////////////////////////////////////////////////////////
+C_GET_OPTIONS_API int BuildOptionsArgv(  char*               program         ,
+                                         int                 argv_mode       ,
+                                         GET_OPT_OVERRIDE*   overrides       ,
+                                         int                 override_number ,
+                                         int                 child_number    ,
+                                         GET_OPT_ARGV**      children        );
+
+/////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Gets the handle of an option within the option store, which is kept once
+///        ParseOptions is over (until FreeOptionsStore). Handles stay valid across
+///        reloads, so they are meant to be resolved once and kept.
+/// @param opt_long Option long name.
+/// @return < 0 if the option is not found or no option store exists, handle otherwise.
+/////////////////////////////////////////////////////////////////////////////////////////
+C_GET_OPTIONS_API int GetOptHandle(char* opt_long);
+
+//////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Typed getters over the option store. Each of them takes O(1) and never locks,
+///        so they can be used from any thread. Values are zeroed (NULL for strings) if
+///        the handle is not valid or the option type does not match the getter.
+///        Strings belong to the store: within reload mode, a reload may free them as
+///        soon as no reader is left, so NULL is returned (GET_OPT_ERR_READ_SECTION
+///        reported) unless the caller is within a read section (OptionsReadLock).
+/// @param opt_handle Option handle (see GetOptHandle).
+/// @return Current option value.
+//////////////////////////////////////////////////////////////////////////////////////////
+C_GET_OPTIONS_API int GetOptInt(int opt_handle);
+C_GET_OPTIONS_API bool GetOptBool(int opt_handle);
+C_GET_OPTIONS_API char GetOptChar(int opt_handle);
+C_GET_OPTIONS_API float GetOptFloat(int opt_handle);
+C_GET_OPTIONS_API double GetOptDouble(int opt_handle);
+C_GET_OPTIONS_API char* GetOptString(int opt_handle);
+
+//////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Gets the current value of a codec type option from the option store, under
+///        the same rules as the typed getters. Codec values (endpoints and blobs as
+///        well) belong to the store, so they are read within a read section as strings.
+/// @param opt_handle Option handle (see GetOptHandle).
+/// @param opt_codec_type Type returned by RegisterOptionCodec.
+/// @return Address of the value (codec binary form), NULL if handle or type do not match,
+///         or if in reload mode and the caller is not within a read section.
+//////////////////////////////////////////////////////////////////////////////////////////
+C_GET_OPTIONS_API void* GetOptCodecValue(int opt_handle, int opt_codec_type);
+C_GET_OPTIONS_API struct sockaddr_storage* GetOptEndpoint(int opt_handle);
+C_GET_OPTIONS_API GET_OPT_BLOB GetOptBlob(int opt_handle);
+
+//////////////////////////////////////////////////////////////////////////////////////
+/// @brief Frees the option store. No reader may be using it when this is called.
+//////////////////////////////////////////////////////////////////////////////////////
+C_GET_OPTIONS_API void FreeOptionsStore(void);
+
+//////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Prepares the export of the option store: JSON keys are escaped once, here, so
+///        that exports only copy them. Stays valid across reloads.
+/// @param opt_export Export to be initialized.
+/// @return < 0 if any error happened, 0 otherwise.
+//////////////////////////////////////////////////////////////////////////////////////////
+C_GET_OPTIONS_API int InitOptionsExport(GET_OPT_EXPORT* opt_export);
+
+//////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Writes the current option values as compact JSON ({"long":value,...}), in a
+///        single pass. Boolean options are true or false, choice options their index,
+///        codec values their formatted string (null if unset), and floating point
+///        values the shortest decimal that reads back the same (null if not finite).
+/// @param opt_export Export initialized by InitOptionsExport.
+/// @param buffer Destination buffer.
+/// @param buffer_size Destination buffer size.
+/// @return < 0 if any error happened (i.e. buffer too small), JSON length otherwise
+///         (NUL-terminated).
+//////////////////////////////////////////////////////////////////////////////////////////
+C_GET_OPTIONS_API int ExportOptionsJson(GET_OPT_EXPORT* opt_export, char* buffer, size_t buffer_size);
+
+//////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Writes the current option values as a fixed-layout binary record, in a single
+///        pass: GET_OPT_RECORD_HEADER, one GET_OPT_RECORD_SLOT per option handle, then
+///        the bytes of string and codec values.
+/// @param opt_export Export initialized by InitOptionsExport.
+/// @param buffer Destination buffer, 8-byte aligned.
+/// @param buffer_size Destination buffer size.
+/// @return < 0 if any error happened (i.e. buffer too small), record size otherwise.
+//////////////////////////////////////////////////////////////////////////////////////////
+C_GET_OPTIONS_API int ExportOptionsRecord(GET_OPT_EXPORT* opt_export, char* buffer, size_t buffer_size);
+
+//////////////////////////////////////////////////////////////////////////////////////
+/// @brief Frees an export initialized by InitOptionsExport.
+/// @param opt_export Export to be freed.
+//////////////////////////////////////////////////////////////////////////////////////
+C_GET_OPTIONS_API void FreeOptionsExport(GET_OPT_EXPORT* opt_export);
+
+////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Exports the option store (schema and resolved values) to a sealed, read-only
+///        memfd. The layout is position-independent (strings are referenced by offsets),
+///        so processes attaching to it read it in place, with no private copies.
+/// @return < 0 if any error happened, memfd file descriptor otherwise.
+////////////////////////////////////////////////////////////////////////////////////////////
+C_GET_OPTIONS_API int ExportOptionsShared(void);
+
+////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Attaches to an option store exported by ExportOptionsShared (i.e. from a worker
+///        process which inherited the file descriptor). No option is parsed: the shared
+///        image replaces the current option store, and is read through the usual getters.
+///        Images which are not sealed against writes and resizing are rejected.
+/// @param shared_fd File descriptor returned by ExportOptionsShared.
+/// @return < 0 if any error happened, 0 otherwise.
+////////////////////////////////////////////////////////////////////////////////////////////
+C_GET_OPTIONS_API int AttachOptionsShared(int shared_fd);
+
+////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Writes the options defined so far to a versioned binary schema file (records,
+///        string pool and precomputed long name hash index, checksummed).
+/// @param schema_file_path Path to the schema file.
+/// @return < 0 if any error happened, 0 otherwise.
+////////////////////////////////////////////////////////////////////////////////////////////
+C_GET_OPTIONS_API int SaveOptionsSchema(char* schema_file_path);
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Loads the option schema from a binary schema file, instead of defining options one
+///        by one. The file is memory-mapped and used as is: only its header checksum is
+///        validated. Must be called before defining any option. Loaded options are not bound
+///        to any variable, but values can be read through GetOptHandle and typed getters.
+/// @param schema_file_path Path to the schema file.
+/// @return < 0 if any error happened, 0 otherwise.
+//////////////////////////////////////////////////////////////////////////////////////////////
+C_GET_OPTIONS_API int LoadOptionsSchema(char* schema_file_path);
+
+/////////////////////////////////////////////////////////////////////////////////
+/// @brief Binds an already defined option (i.e. loaded from a schema file) to a
+///        destination variable, which is set once options are parsed.
+/// @param opt_long Option long name.
+/// @param opt_dest_var Destination variable address.
+/// @return < 0 if any error happened, 0 otherwise.
+/////////////////////////////////////////////////////////////////////////////////
+C_GET_OPTIONS_API int BindOptionDestination(char* opt_long, void* opt_dest_var);
+
 /*************************************/
 
 #ifdef __cplusplus
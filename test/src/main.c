@@ -1,4 +1,13 @@
+#define _GNU_SOURCE
+#include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <sys/un.h>
+#include <arpa/inet.h>
 #include "GetOptions_api.h"
 #include "SeverityLog_api.h"
 
@@ -26,6 +35,34 @@
 #define GET_OPT_ERR_NULL_PTR                -13
 #define GET_OPT_ERR_NO_ARG_FOUND            -14
 #define GET_OPT_ERR_UNKNOWN_OPTION          -15
+#define GET_OPT_ERR_CONFIG_FILE             -16
+#define GET_OPT_ERR_CONFIG_SYNTAX           -17
+#define GET_OPT_ERR_CACHE_MISS              -18
+#define GET_OPT_ERR_CACHE_WRITE             -19
+#define GET_OPT_ERR_RELOAD_MODE             -20
+#define GET_OPT_ERR_READER_SLOTS            -21
+#define GET_OPT_ERR_NO_OPT_STORE            -22
+#define GET_OPT_ERR_SHARED_MEM              -23
+#define GET_OPT_ERR_SCHEMA_FILE             -24
+#define GET_OPT_ERR_REGISTRATION_BATCH      -25
+#define GET_OPT_ERR_CONSTRAINT_DEF          -26
+#define GET_OPT_ERR_REQUIRED_OPTION         -27
+#define GET_OPT_ERR_EXCLUSIVE_OPTIONS       -28
+#define GET_OPT_ERR_DEPENDENT_OPTION        -29
+#define GET_OPT_ERR_FLAG_SET                -30
+#define GET_OPT_ERR_FLAG_HEADER             -31
+#define GET_OPT_ERR_CHOICE_DEF              -32
+#define GET_OPT_ERR_UNKNOWN_CHOICE          -33
+#define GET_OPT_ERR_STRING_CONSTRAINT_DEF   -34
+#define GET_OPT_ERR_STRING_CONSTRAINT       -35
+#define GET_OPT_ERR_CODEC_DEF               -36
+#define GET_OPT_ERR_CODEC_VALUE             -37
+#define GET_OPT_ERR_CMDLINE_SYNTAX          -38
+#define GET_OPT_ERR_STREAM_TOKEN            -39
+#define GET_OPT_ERR_EXPORT_SIZE             -40
+#define GET_OPT_ERR_AMBIGUOUS_OPTION        -41
+#define GET_OPT_ERR_READ_SECTION            -42
+#define GET_OPT_ERR_FLAG_MACRO              -43
 
 typedef struct
 {
@@ -67,7 +104,7 @@ SetOptionDefinition_Test_Data SetOptionDefinition_data =
                                 NULL,
                                 "xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx"
                             },
-    .opt_var_type =         {0, -1, 5   },
+    .opt_var_type =         {0, -1, GET_OPT_TYPE_MAX + 1},
     .opt_needs_arg =        {1, -1, 3, 0},
     .opt_min_value =        {0, 2       },
     .opt_max_value =        {2, 0       },
@@ -86,7 +123,7 @@ SetOptionDefinition_Test_Case SetOptionDefinition_Test_Indexes[]=
     {2,         1,          0,      0,              0,              0,              0,              0,                  0,              GET_OPT_ERR_NO_OPT_LONG             },
     {3,         2,          0,      0,              0,              0,              0,              0,                  0,              GET_OPT_ERR_LONG_LENGTH_EXCEEDED    },
     {4,         3,          0,      0,              0,              0,              0,              0,                  0,              GET_OPT_SUCCESS                     },
-    {0,         0,          0,      0,              0,              0,              0,              0,                  0,              GET_OPT_SUCCESS                     },
+    {0,         0,          0,      0,              0,              0,              0,              0,                  0,              GET_OPT_ERR_OPT_CHAR_ALREADY_EXISTS },
     {5,         0,          1,      0,              0,              0,              0,              0,                  0,              GET_OPT_ERR_OPT_LONG_ALREADY_EXISTS },
     {6,         4,          2,      0,              0,              0,              0,              0,                  0,              GET_OPT_ERR_DETAIL_LENGTH_EXCEEDED  },
     {7,         5,          0,      1,              0,              0,              0,              0,                  0,              GET_OPT_ERR_UNKNOWN_TYPE            },
@@ -100,6 +137,126 @@ SetOptionDefinition_Test_Case SetOptionDefinition_Test_Indexes[]=
 
 };
 
+typedef struct
+{
+    char*   config_contents ;
+    int     expected_result ;
+    int     expected_value  ;
+
+}ConfigFile_Test_Case;
+
+ConfigFile_Test_Case ConfigFile_Test_Cases[] =
+{
+//  Config file contents                                                                            Error code                      Value
+    // "key = value" files.
+    {"# Comment\n; Comment\n\n  \t ConfigThreads   =   7  \r\n",                                 GET_OPT_SUCCESS,                7},
+    {"--ConfigThreads=\"5\"",                                                                       GET_OPT_SUCCESS,                5},
+    {"",                                                                                            GET_OPT_SUCCESS,                2},
+    {"ConfigThreads = 3\nConfigUnknown = 3\n",                                                      GET_OPT_ERR_UNKNOWN_OPTION,     0},
+    {"ConfigThreads 3\n",                                                                           GET_OPT_ERR_CONFIG_SYNTAX,      0},
+    {"ConfigThreads = 9\n",                                                                         GET_OPT_ERR_VAL_OUT_OF_BOUNDS,  0},
+    {"ConfigThre",                                                                                  GET_OPT_ERR_UNKNOWN_OPTION,     0},
+    // XML files.
+    {"<?xml version=\"1.0\"?>\n<!-- <ConfigThreads value=\"1\"/> -->\n<config>\n  <ConfigThreads  value = '6' />\n</config>\n", GET_OPT_SUCCESS, 6},
+    {"\n <config><ConfigUnknown value=\"1\"/></config>",                                            GET_OPT_ERR_UNKNOWN_OPTION,     0},
+    {"<config><ConfigThreads value=\"6",                                                            GET_OPT_ERR_CONFIG_SYNTAX,      0},
+    {"<config><ConfigThreads value/></config>",                                                     GET_OPT_ERR_CONFIG_SYNTAX,      0},
+    {"<config><!-- <ConfigThreads value=\"6\"/>",                                                   GET_OPT_SUCCESS,                2},
+
+};
+
+typedef struct
+{
+    char*   env_prefix      ;
+    char*   env_name        ;
+    char*   env_value       ;
+    char*   config_contents ;
+    char*   argv_option     ;
+    int     expected_result ;
+    int     expected_value  ;
+    int     expected_source ;
+
+}Environment_Test_Case;
+
+typedef struct
+{
+    int     constraint_type     ;
+    char*   group[3]            ;
+    char*   argv_options[3]     ;
+    int     expected_result     ;
+    char*   expected_offender   ;
+
+}Constraint_Test_Case;
+
+Constraint_Test_Case Constraint_Test_Cases[] =
+{
+//  Constraint                      Group                               Argv                                                Error code                      Offender
+    {GET_OPT_CONSTRAINT_REQUIRED,   {"GroupA", "GroupB"},               {"--GroupA=1", "--GroupB=1"},                       GET_OPT_SUCCESS,                NULL        },
+    {GET_OPT_CONSTRAINT_REQUIRED,   {"GroupA", "GroupB"},               {"--GroupA=1"},                                     GET_OPT_ERR_REQUIRED_OPTION,    "GroupB"    },
+    {GET_OPT_CONSTRAINT_REQUIRED,   {"GroupA", "GroupB"},               {NULL},                                             GET_OPT_ERR_REQUIRED_OPTION,    "GroupA"    },
+    {GET_OPT_CONSTRAINT_EXCLUSIVE,  {"GroupA", "GroupB", "GroupC"},     {NULL},                                             GET_OPT_SUCCESS,                NULL        },
+    {GET_OPT_CONSTRAINT_EXCLUSIVE,  {"GroupA", "GroupB", "GroupC"},     {"--GroupB=1"},                                     GET_OPT_SUCCESS,                NULL        },
+    {GET_OPT_CONSTRAINT_EXCLUSIVE,  {"GroupA", "GroupB", "GroupC"},     {"--GroupA=1", "--GroupC=1"},                       GET_OPT_ERR_EXCLUSIVE_OPTIONS,  "GroupC"    },
+    {GET_OPT_CONSTRAINT_EXCLUSIVE,  {"GroupA", "GroupB", "GroupC"},     {"--GroupC=1", "--GroupB=1", "--GroupA=1"},         GET_OPT_ERR_EXCLUSIVE_OPTIONS,  "GroupB"    },
+    {GET_OPT_CONSTRAINT_ONE_OF,     {"GroupA", "GroupB"},               {"--GroupB=1"},                                     GET_OPT_SUCCESS,                NULL        },
+    {GET_OPT_CONSTRAINT_ONE_OF,     {"GroupA", "GroupB"},               {NULL},                                             GET_OPT_ERR_REQUIRED_OPTION,    "GroupA"    },
+    {GET_OPT_CONSTRAINT_ONE_OF,     {"GroupA", "GroupB"},               {"--GroupA=1", "--GroupB=1"},                       GET_OPT_ERR_EXCLUSIVE_OPTIONS,  "GroupB"    },
+    // GroupA depends on GroupB and GroupC.
+    {GET_OPT_CONSTRAINT_DEPENDENT,  {"GroupA", "GroupB", "GroupC"},     {NULL},                                             GET_OPT_SUCCESS,                NULL        },
+    {GET_OPT_CONSTRAINT_DEPENDENT,  {"GroupA", "GroupB", "GroupC"},     {"--GroupB=1"},                                     GET_OPT_SUCCESS,                NULL        },
+    {GET_OPT_CONSTRAINT_DEPENDENT,  {"GroupA", "GroupB", "GroupC"},     {"--GroupA=1", "--GroupB=1", "--GroupC=1"},         GET_OPT_SUCCESS,                NULL        },
+    {GET_OPT_CONSTRAINT_DEPENDENT,  {"GroupA", "GroupB", "GroupC"},     {"--GroupA=1", "--GroupB=1"},                       GET_OPT_ERR_DEPENDENT_OPTION,   "GroupC"    },
+    {GET_OPT_CONSTRAINT_DEPENDENT,  {"GroupA", "GroupB", "GroupC"},     {"--GroupA=1"},                                     GET_OPT_ERR_DEPENDENT_OPTION,   "GroupB"    },
+
+};
+
+typedef struct
+{
+    int     str_mode        ;
+    size_t  max_length      ;
+    char*   config_contents ;
+    char*   argv_option     ;
+    int     expected_result ;
+    char*   expected_value  ;
+    bool    expected_in_argv;
+
+}StringRef_Test_Case;
+
+StringRef_Test_Case StringRef_Test_Cases[] =
+{
+//  Mode                        Maximum Config file             Argv                    Error code                      Value       Within argv
+    {GET_OPT_STR_MODE_ARENA,    4,      NULL,                   "--RefWord=abcd",       GET_OPT_SUCCESS,                "abcd",     false   },
+    {GET_OPT_STR_MODE_ARENA,    4,      NULL,                   "--RefWord=abcde",      GET_OPT_ERR_VAL_OUT_OF_BOUNDS,  NULL,       false   },
+    {GET_OPT_STR_MODE_ARENA,    0,      NULL,                   "--RefWord=abcdefgh",   GET_OPT_SUCCESS,                "abcdefgh", false   },
+    {GET_OPT_STR_MODE_VIEW,     4,      NULL,                   "--RefWord=abcd",       GET_OPT_SUCCESS,                "abcd",     true    },
+    {GET_OPT_STR_MODE_VIEW,     4,      NULL,                   "--RefWord=abcde",      GET_OPT_ERR_VAL_OUT_OF_BOUNDS,  NULL,       false   },
+    {GET_OPT_STR_MODE_VIEW,     4,      NULL,                   NULL,                   GET_OPT_SUCCESS,                "dflt",     false   },
+    // Config files are unmapped once parsed, so their values are pinned into the arena even in view mode.
+    {GET_OPT_STR_MODE_VIEW,     0,      "RefWord = abcdef\n",   NULL,                   GET_OPT_SUCCESS,                "abcdef",   false   },
+    {GET_OPT_STR_MODE_VIEW,     0,      "RefWord = abcdef\n",   "--RefWord=abc",        GET_OPT_SUCCESS,                "abc",      true    },
+
+};
+
+Environment_Test_Case Environment_Test_Cases[] =
+{
+//  Prefix          Variable                        Value   Config file             Argv                    Error code                      Value   Source
+    // Prefix matching and '-' -> '_' folding.
+    {"GETOPT_TEST_",    "GETOPT_TEST_ENV_THREADS",      "5",    NULL,                   NULL,                   GET_OPT_SUCCESS,                5,      GET_OPT_SRC_ENV         },
+    {"GETOPT_TEST_",    "GETOPT_TESTX_ENV_THREADS",     "5",    NULL,                   NULL,                   GET_OPT_SUCCESS,                2,      GET_OPT_SRC_DEFAULT     },
+    {"GETOPT_TEST_",    "GETOPT_TEST_ENV_THREADS_X",    "5",    NULL,                   NULL,                   GET_OPT_SUCCESS,                2,      GET_OPT_SRC_DEFAULT     },
+    {"GETOPT_TEST_",    "GETOPT_TEST_ENV-THREADS",      "5",    NULL,                   NULL,                   GET_OPT_SUCCESS,                2,      GET_OPT_SRC_DEFAULT     },
+    {"GETOPT_TEST_",    "GETOPT_TEST_env_threads",      "5",    NULL,                   NULL,                   GET_OPT_SUCCESS,                2,      GET_OPT_SRC_DEFAULT     },
+    {NULL,              "GETOPT_TEST_ENV_THREADS",      "5",    NULL,                   NULL,                   GET_OPT_SUCCESS,                2,      GET_OPT_SRC_DEFAULT     },
+    // Precedence: argv > environment > config file > default.
+    {"GETOPT_TEST_",    "GETOPT_TEST_ENV_THREADS",      "5",    "env-threads = 6\n",    NULL,                   GET_OPT_SUCCESS,                5,      GET_OPT_SRC_ENV         },
+    {"GETOPT_TEST_",    "GETOPT_TESTX_ENV_THREADS",     "5",    "env-threads = 6\n",    NULL,                   GET_OPT_SUCCESS,                6,      GET_OPT_SRC_CONFIG_FILE },
+    {"GETOPT_TEST_",    "GETOPT_TEST_ENV_THREADS",      "5",    "env-threads = 6\n",    "--env-threads=3",      GET_OPT_SUCCESS,                3,      GET_OPT_SRC_ARGV        },
+    // Wrong values.
+    {"GETOPT_TEST_",    "GETOPT_TEST_ENV_THREADS",      "9",    NULL,                   NULL,                   GET_OPT_ERR_VAL_OUT_OF_BOUNDS,  0,      0                       },
+    {"GETOPT_TEST_",    "GETOPT_TEST_ENV_THREADS",      "9",    NULL,                   "--env-threads=3",      GET_OPT_ERR_VAL_OUT_OF_BOUNDS,  0,      0                       },
+
+};
+
 ///////////////////////////////////////////////////////////////
 /// @brief Test SetOptionDefinition function. Test cases above.
 /// @return < 0 if any test went wrong, 0 otherwise.
@@ -115,6 +272,9 @@ int Test_SetOptionDefinition()
 
     int test_overall_result = TEST_FLG_SUCCESS;
 
+    // Test options are registered as a single batch, so they are rolled back afterwards.
+    BeginOptionsRegistration();
+
     for(int i = 0; i < sizeof(SetOptionDefinition_Test_Indexes) / sizeof(SetOptionDefinition_Test_Indexes[0]); i++)
     {
         SVRTY_LOG_INF("\r\nTest %d.", i);
@@ -139,6 +299,14 @@ int Test_SetOptionDefinition()
         }
     }
 
+    int commit_options_registration = CommitOptionsRegistration();
+
+    if(commit_options_registration != GET_OPT_ERR_OPT_CHAR_ALREADY_EXISTS)
+    {
+        SVRTY_LOG_ERR("Batch commit failed.\tExpected %d, got %d.", GET_OPT_ERR_OPT_CHAR_ALREADY_EXISTS, commit_options_registration);
+        test_overall_result = TEST_FLG_ERROR;
+    }
+
     SVRTY_LOG_INF("********** SetOptionDefinition test results **********");
     for(int i = 0; i < number_of_tests; i++)
     {
@@ -168,6 +336,59 @@ int Test_SetOptionDefinition()
     return test_overall_result;
 }
 
+///////////////////////////////////////////////////////////////////////
+/// @brief Test that errors are recorded in the caller's diagnostics
+/// record instead of being logged, then formatted on demand.
+/// @return < 0 if any test went wrong, 0 otherwise.
+///////////////////////////////////////////////////////////////////////
+int Test_OptionsDiagnostics()
+{
+    SVRTY_LOG_INF("********** OptionsDiagnostics Test Start **********");
+
+    GET_OPT_DIAG diag = {};
+    char diag_msg[GET_OPT_SIZE_DIAG_MSG_MAX];
+    int test_overall_result = TEST_FLG_SUCCESS;
+
+    SetOptionsDiagnostics(&diag);
+
+    int set_option_definition = SetOptionDefinitionInt('q', "DiagTest", "Diagnostics test.", 0, 4, 7, &dummy);
+
+    SetOptionsDiagnostics(NULL);
+
+    if( set_option_definition   != GET_OPT_ERR_VAL_OUT_OF_BOUNDS    ||
+        diag.code               != GET_OPT_ERR_VAL_OUT_OF_BOUNDS    ||
+        diag.opt_char           != 'q'                              ||
+        diag.token_offset       != -1                               ||
+        diag.expected_max.integer != 4                              )
+    {
+        SVRTY_LOG_ERR("Unexpected diagnostics record (code %d).", diag.code);
+        test_overall_result = TEST_FLG_ERROR;
+    }
+
+    if(GetOptionsDiagMessage(&diag, diag_msg, sizeof(diag_msg)) <= 0)
+    {
+        SVRTY_LOG_ERR("Could not format diagnostics message.");
+        test_overall_result = TEST_FLG_ERROR;
+    }
+    else
+    {
+        SVRTY_LOG_INF("Formatted diagnostics message: %s", diag_msg);
+    }
+
+    if(test_overall_result < 0)
+    {
+        SVRTY_LOG_WNG("OptionsDiagnostics test failed.");
+    }
+    else
+    {
+        SVRTY_LOG_INF("OptionsDiagnostics test succeed!");
+    }
+
+    SVRTY_LOG_INF("********** OptionsDiagnostics Test End **********");
+
+    return test_overall_result;
+}
+
 ///////////////////////////////////////////////////
 /// @brief Test ParseOptions function.
 /// @param argc Argument count.
@@ -245,6 +466,23 @@ int TestParseOptions(int argc, char** argv)
                                 "~/Test_7_ggg"          ,
                                 test_7                  );
 
+    // Removed options are left out of parsing, as if they had never been defined.
+    int test_8 = 0;
+    SetOptionDefinitionInt('q', "TestParseRemoved", "Removed option.", 0, 4, 2, &test_8);
+    int remove_option_definition = RemoveOptionDefinition("TestParseRemoved");
+
+    // Boolean options may also be packed into a flag set.
+    uint64_t test_flags[GET_OPT_FLAG_WORDS(64)] = {0};
+    SetOptionsFlagSet(test_flags, 64);
+    int test_flag_bit = SetOptionDefinitionFlag('f', "TestParseFlag", "Test flag option.", true);
+
+    // Choice options store the index of the matching string.
+    int test_mode = -1;
+    SetOptionDefinitionChoice('o', "TestParseMode", "Test choice option.", (char*[]){"fast", "safe", "paranoid"}, 3, 1, &test_mode);
+
+    // TestParse4 values are three lowercase letters.
+    SetOptionStringConstraint("TestParse4", 3, 3, "a-z", NULL);
+
     SetSeverityLogPrintTimeStatus(true);
 
     int parse_options = ParseOptions(argc, argv);
@@ -256,6 +494,43 @@ int TestParseOptions(int argc, char** argv)
     SVRTY_LOG_INF("test_5 = %s", test_5);
     SVRTY_LOG_INF("test_6 = %s", test_6);
     SVRTY_LOG_INF("test_7 = %s", test_6);
+    SVRTY_LOG_INF("test_1 source = %d (provenance mask 0x%02X)", GetOptionSource(&test_1), GetOptionProvenance(&test_1));
+    SVRTY_LOG_INF("test_3 source = %d (provenance mask 0x%02X)", GetOptionSource(&test_3), GetOptionProvenance(&test_3));
+
+    // TestParse2 is given without its optional argument, so it keeps its default value but comes from argv.
+    if(parse_options >= 0 && (test_2 != 3 || GetOptionSource(&test_2) != GET_OPT_SRC_ARGV))
+    {
+        parse_options = -1;
+    }
+
+    // Values are also kept in the option store once parsing is over.
+    int test_1_handle = GetOptHandle("TestParse1");
+    int test_5_handle = GetOptHandle("TestParse5");
+
+    SVRTY_LOG_INF("TestParse1 (store) = %2f", GetOptFloat(test_1_handle));
+    SVRTY_LOG_INF("TestParse5 (store) = %s", GetOptString(test_5_handle));
+
+    if(parse_options >= 0 && (test_flag_bit < 0 || !GET_OPT_FLAG_TEST(test_flags, test_flag_bit)))
+    {
+        parse_options = -1;
+    }
+
+    if(parse_options >= 0 && test_mode != 1)
+    {
+        parse_options = -1;
+    }
+
+    if(parse_options >= 0 && (remove_option_definition < 0 || GetOptHandle("TestParseRemoved") >= 0))
+    {
+        parse_options = -1;
+    }
+
+    if(parse_options >= 0 && (test_1_handle < 0 || GetOptFloat(test_1_handle) != test_1 || strcmp(GetOptString(test_5_handle), test_5) != 0))
+    {
+        parse_options = -1;
+    }
+
+    FreeOptionsStore();
 
     if(parse_options < 0)
     {
@@ -274,13 +549,2139 @@ int TestParseOptions(int argc, char** argv)
     return (parse_options < 0) ? parse_options : GET_OPT_SUCCESS;
 }
 
-int main(int argc, char **argv)
+/////////////////////////////////////////////////////////////////////
+/// @brief Creates a temporary file holding the given contents.
+/// @param file_path mkstemp template, filled in with the file path.
+/// @param contents File contents (NUL-terminated).
+/// @return < 0 if the file could not be written, 0 otherwise.
+/////////////////////////////////////////////////////////////////////
+int CreateTestFile(char* file_path, char* contents)
 {
-    SeverityLogInitWithMask(1000, 0xFF);
+    int file_fd = mkstemp(file_path);
+    size_t contents_size = strlen(contents);
 
-    Test_SetOptionDefinition();
+    if(file_fd < 0)
+    {
+        return TEST_FLG_ERROR;
+    }
 
-    TestParseOptions(argc, argv);
+    ssize_t written = write(file_fd, contents, contents_size);
+    close(file_fd);
+
+    return (written == (ssize_t)contents_size ? TEST_FLG_SUCCESS : TEST_FLG_ERROR);
+}
+
+////////////////////////////////////////////////////////////////////////
+/// @brief Test config files, both "key = value" and XML formatted.
+///        Test cases above. Each one is parsed with an empty argv.
+/// @return < 0 if any test went wrong, 0 otherwise.
+////////////////////////////////////////////////////////////////////////
+int Test_OptionsConfigFile()
+{
+    SVRTY_LOG_INF("********** OptionsConfigFile Test Start **********");
+
+    int number_of_tests = sizeof(ConfigFile_Test_Cases) / sizeof(ConfigFile_Test_Cases[0]);
+    int test_overall_result = TEST_FLG_SUCCESS;
+
+    for(int i = 0; i < number_of_tests; i++)
+    {
+        char config_path[] = "/tmp/GetOptionsConfigXXXXXX";
+
+        if(CreateTestFile(config_path, ConfigFile_Test_Cases[i].config_contents) < 0)
+        {
+            SVRTY_LOG_ERR("Test %d failed.\tCould not write config file.", i);
+            test_overall_result = TEST_FLG_ERROR;
+            continue;
+        }
+
+        int config_threads = 0;
+        SetOptionDefinitionInt('n', "ConfigThreads", "Config file test.", 1, 8, 2, &config_threads);
+        LoadOptionsConfigFile(config_path);
+
+        // getopt is restarted, as argv has already been parsed by a previous test.
+        optind = 0;
+        int parse_options = ParseOptions(1, (char*[]){"ConfigFileTest", NULL});
+
+        if(parse_options >= 0)
+        {
+            FreeOptionsStore();
+        }
+
+        unlink(config_path);
+
+        if( parse_options != ConfigFile_Test_Cases[i].expected_result ||
+            (parse_options >= 0 && config_threads != ConfigFile_Test_Cases[i].expected_value))
+        {
+            SVRTY_LOG_ERR("Test %d failed.\tExpected %d (value %d), got %d (value %d).", i, ConfigFile_Test_Cases[i].expected_result, ConfigFile_Test_Cases[i].expected_value, parse_options, config_threads);
+            test_overall_result = TEST_FLG_ERROR;
+            continue;
+        }
+
+        SVRTY_LOG_INF(TEST_MSG_SUCCEED, i);
+    }
+
+    if(test_overall_result < 0)
+    {
+        SVRTY_LOG_WNG("OptionsConfigFile test failed.");
+    }
+    else
+    {
+        SVRTY_LOG_INF("OptionsConfigFile test succeed!");
+    }
+
+    SVRTY_LOG_INF("********** OptionsConfigFile Test End **********");
+
+    return test_overall_result;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Test that cache files are only used if they are consistent. The config file
+///        value is changed behind the cache key (same size, inode and mtime), so values
+///        only come from the config file again if the cache has been rejected.
+/// @return < 0 if any test went wrong, 0 otherwise.
+////////////////////////////////////////////////////////////////////////////////////////
+int Test_OptionsCacheFile()
+{
+    SVRTY_LOG_INF("********** OptionsCacheFile Test Start **********");
+
+    // Corruption applied to the cache file: none, bad magic number, truncated image.
+    int expected_values[] = {5, 6, 6};
+    int test_overall_result = TEST_FLG_SUCCESS;
+
+    for(int i = 0; i < sizeof(expected_values) / sizeof(expected_values[0]); i++)
+    {
+        char config_path[] = "/tmp/GetOptionsConfigXXXXXX";
+        char cache_path[] = "/tmp/GetOptionsCacheXXXXXX";
+        struct stat config_stat;
+
+        if( CreateTestFile(config_path, "CacheThreads = 5\n") < 0 ||
+            CreateTestFile(cache_path, "") < 0                      ||
+            stat(config_path, &config_stat) < 0                     )
+        {
+            SVRTY_LOG_ERR("Test %d failed.\tCould not write test files.", i);
+            test_overall_result = TEST_FLG_ERROR;
+            continue;
+        }
+
+        int cache_threads = 0;
+        int parse_options[2];
+
+        SetOptionsCacheFile(cache_path);
+
+        for(int parse_number = 0; parse_number < 2; parse_number++)
+        {
+            SetOptionDefinitionInt('n', "CacheThreads", "Cache file test.", 1, 8, 2, &cache_threads);
+            LoadOptionsConfigFile(config_path);
+
+            optind = 0;
+            parse_options[parse_number] = ParseOptions(1, (char*[]){"CacheFileTest", NULL});
+
+            if(parse_options[parse_number] >= 0)
+            {
+                FreeOptionsStore();
+            }
+
+            if(parse_number > 0)
+            {
+                break;
+            }
+
+            // Same size, inode and modification time, so the cache key does not change.
+            int config_fd = open(config_path, O_WRONLY);
+            pwrite(config_fd, "CacheThreads = 6\n", config_stat.st_size, 0);
+            futimens(config_fd, (struct timespec[]){config_stat.st_atim, config_stat.st_mtim});
+            close(config_fd);
+
+            if(i == 1)
+            {
+                int cache_fd = open(cache_path, O_WRONLY);
+                pwrite(cache_fd, "X", 1, 0);
+                close(cache_fd);
+            }
+            else if(i == 2)
+            {
+                struct stat cache_stat;
+                stat(cache_path, &cache_stat);
+                truncate(cache_path, cache_stat.st_size - 1);
+            }
+        }
+
+        SetOptionsCacheFile(NULL);
+        unlink(config_path);
+        unlink(cache_path);
+
+        if(parse_options[0] < 0 || parse_options[1] < 0 || cache_threads != expected_values[i])
+        {
+            SVRTY_LOG_ERR("Test %d failed.\tExpected %d, got %d (%d, %d).", i, expected_values[i], cache_threads, parse_options[0], parse_options[1]);
+            test_overall_result = TEST_FLG_ERROR;
+            continue;
+        }
+
+        SVRTY_LOG_INF(TEST_MSG_SUCCEED, i);
+    }
+
+    if(test_overall_result < 0)
+    {
+        SVRTY_LOG_WNG("OptionsCacheFile test failed.");
+    }
+    else
+    {
+        SVRTY_LOG_INF("OptionsCacheFile test succeed!");
+    }
+
+    SVRTY_LOG_INF("********** OptionsCacheFile Test End **********");
+
+    return test_overall_result;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Test reload mode: a config file value is changed, then a reload is requested
+///        and polled. Only the changed option must be reported and updated.
+/// @return < 0 if any test went wrong, 0 otherwise.
+//////////////////////////////////////////////////////////////////////////////////////////
+int Test_OptionsReload()
+{
+    SVRTY_LOG_INF("********** OptionsReload Test Start **********");
+
+    char config_path[] = "/tmp/GetOptionsConfigXXXXXX";
+    char* reload_argv[] = {"ReloadTest", "--ReloadLevel", "3", NULL};
+    int reload_threads = 0;
+    int reload_level = 0;
+    GET_OPT_BLOB reload_key = {};
+    int test_overall_result = TEST_FLG_SUCCESS;
+
+    if(CreateTestFile(config_path, "ReloadThreads = 5\n") < 0)
+    {
+        SVRTY_LOG_WNG("OptionsReload test failed.");
+        return TEST_FLG_ERROR;
+    }
+
+    // Nothing has been parsed in reload mode yet.
+    int reload_options = ReloadOptions();
+
+    SetOptionsReloadMode(1);
+    SetOptionDefinitionInt('n', "ReloadThreads", "Reload test.", 1, 8, 2, &reload_threads);
+    SetOptionDefinitionInt('m', "ReloadLevel", "Reload test.", 0, 4, 1, &reload_level);
+    SetOptionDefinitionBlob('k', "ReloadKey", "Reload test.", GET_OPT_TYPE_BLOB_HEX, 0, 0, "c0de", &reload_key);
+    LoadOptionsConfigFile(config_path);
+
+    optind = 0;
+    int parse_options = ParseOptions(3, reload_argv);
+
+    // Reloads map config files again, whatever their modification time.
+    FILE* config_file = fopen(config_path, "w");
+    fputs("ReloadThreads = 7\n", config_file);
+    fclose(config_file);
+
+    int unrequested_reload = PollOptionsReload();
+    RequestOptionsReload(0);
+    int changed_options = PollOptionsReload();
+    int reload_threads_handle = GetOptHandle("ReloadThreads");
+
+    // Blobs point into the snapshot, so they are only read within a read section.
+    int read_level = 0;
+    GET_OPT_BLOB read_key = {};
+    int read_level_unlocked = ReadOptionValue("ReloadLevel", &read_level);
+    int read_key_unlocked = ReadOptionValue("ReloadKey", &read_key);
+    OptionsReadLock();
+    int read_key_locked = ReadOptionValue("ReloadKey", &read_key);
+    bool read_key_matches = (read_key.length == 2 && read_key.data[0] == 0xC0 && read_key.data[1] == 0xDE);
+    GET_OPT_BLOB store_key_locked = GetOptBlob(GetOptHandle("ReloadKey"));
+    OptionsReadUnlock();
+    GET_OPT_BLOB store_key_unlocked = GetOptBlob(GetOptHandle("ReloadKey"));
+
+    if( reload_options          != GET_OPT_ERR_RELOAD_MODE  ||
+        parse_options           < 0                         ||
+        unrequested_reload      != 0                        ||
+        changed_options         != 1                        ||
+        reload_threads          != 7                        ||
+        reload_level            != 3                        ||
+        GetOptInt(reload_threads_handle) != 7               )
+    {
+        SVRTY_LOG_ERR("Unexpected reload (%d, %d, %d, %d), threads = %d, level = %d.", reload_options, parse_options, unrequested_reload, changed_options, reload_threads, reload_level);
+        test_overall_result = TEST_FLG_ERROR;
+    }
+
+    if( read_level_unlocked != GET_OPT_SUCCESS          ||
+        read_level          != 3                        ||
+        read_key_unlocked   != GET_OPT_ERR_READ_SECTION ||
+        read_key_locked     != GET_OPT_SUCCESS          ||
+        !read_key_matches                               ||
+        store_key_locked.length     != 2                ||
+        store_key_unlocked.data     != NULL             )
+    {
+        SVRTY_LOG_ERR("Unexpected snapshot reads (%d, %d, %d), level = %d.", read_level_unlocked, read_key_unlocked, read_key_locked, read_level);
+        test_overall_result = TEST_FLG_ERROR;
+    }
+
+    EndOptionsReload();
+    unlink(config_path);
+
+    if(test_overall_result < 0)
+    {
+        SVRTY_LOG_WNG("OptionsReload test failed.");
+    }
+    else
+    {
+        SVRTY_LOG_INF("OptionsReload test succeed!");
+    }
+
+    SVRTY_LOG_INF("********** OptionsReload Test End **********");
+
+    return test_overall_result;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+/// @brief Copies an exported option store into a new memfd.
+/// @param shared_fd File descriptor returned by ExportOptionsShared.
+/// @param corrupt Whether the first byte (magic number) is overwritten.
+/// @param seals Seals added to the copy, 0 for none.
+/// @return < 0 if the copy failed, memfd file descriptor otherwise.
+//////////////////////////////////////////////////////////////////////////////////
+int CopySharedOptions(int shared_fd, bool corrupt, int seals)
+{
+    char image[4096];
+    ssize_t image_size = pread(shared_fd, image, sizeof(image), 0);
+    int copy_fd = memfd_create("GetOptionsTest", MFD_ALLOW_SEALING);
+
+    if(image_size <= 0 || copy_fd < 0)
+    {
+        return TEST_FLG_ERROR;
+    }
+
+    if(corrupt)
+    {
+        image[0] ^= 0xFF;
+    }
+
+    if(write(copy_fd, image, image_size) != image_size || (seals != 0 && fcntl(copy_fd, F_ADD_SEALS, seals) < 0))
+    {
+        close(copy_fd);
+        return TEST_FLG_ERROR;
+    }
+
+    return copy_fd;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Test attaching to an option store exported to shared memory. Copies which
+///        are not sealed, or whose layout is corrupted, must be rejected.
+/// @return < 0 if any test went wrong, 0 otherwise.
+////////////////////////////////////////////////////////////////////////////////////////
+int Test_OptionsShared()
+{
+    SVRTY_LOG_INF("********** OptionsShared Test Start **********");
+
+    int shared_threads = 0;
+    int test_overall_result = TEST_FLG_SUCCESS;
+    int all_seals = F_SEAL_SEAL | F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE;
+
+    SetOptionDefinitionInt('n', "SharedThreads", "Shared memory test.", 1, 8, 2, &shared_threads);
+
+    optind = 0;
+    int parse_options = ParseOptions(3, (char*[]){"SharedTest", "-n", "6", NULL});
+    int shared_fd = ExportOptionsShared();
+
+    // Whether the copy is corrupted, seals added to it and expected result.
+    struct
+    {
+        bool    corrupt         ;
+        int     seals           ;
+        int     expected_result ;
+
+    } shared_test_cases[] =
+    {
+        {false, 0                           , GET_OPT_ERR_SHARED_MEM},
+        {false, F_SEAL_SHRINK | F_SEAL_GROW , GET_OPT_ERR_SHARED_MEM},
+        {true , all_seals                   , GET_OPT_ERR_SHARED_MEM},
+        {false, all_seals                   , GET_OPT_SUCCESS       },
+    };
+
+    if(parse_options < 0 || shared_fd < 0)
+    {
+        SVRTY_LOG_ERR("Could not export options (%d, %d).", parse_options, shared_fd);
+        test_overall_result = TEST_FLG_ERROR;
+    }
+
+    for(int i = 0; test_overall_result == TEST_FLG_SUCCESS && i < sizeof(shared_test_cases) / sizeof(shared_test_cases[0]); i++)
+    {
+        int copy_fd = CopySharedOptions(shared_fd, shared_test_cases[i].corrupt, shared_test_cases[i].seals);
+        int attach_options_shared = (copy_fd < 0 ? copy_fd : AttachOptionsShared(copy_fd));
+
+        if(copy_fd >= 0)
+        {
+            close(copy_fd);
+        }
+
+        if(attach_options_shared != shared_test_cases[i].expected_result)
+        {
+            SVRTY_LOG_ERR("Test %d failed.\tExpected %d, got %d.", i, shared_test_cases[i].expected_result, attach_options_shared);
+            test_overall_result = TEST_FLG_ERROR;
+            continue;
+        }
+
+        SVRTY_LOG_INF(TEST_MSG_SUCCEED, i);
+    }
+
+    if(test_overall_result == TEST_FLG_SUCCESS && GetOptInt(GetOptHandle("SharedThreads")) != 6)
+    {
+        SVRTY_LOG_ERR("Unexpected attached value %d.", GetOptInt(GetOptHandle("SharedThreads")));
+        test_overall_result = TEST_FLG_ERROR;
+    }
+
+    if(shared_fd >= 0)
+    {
+        close(shared_fd);
+    }
+
+    FreeOptionsStore();
+
+    if(test_overall_result < 0)
+    {
+        SVRTY_LOG_WNG("OptionsShared test failed.");
+    }
+    else
+    {
+        SVRTY_LOG_INF("OptionsShared test succeed!");
+    }
+
+    SVRTY_LOG_INF("********** OptionsShared Test End **********");
+
+    return test_overall_result;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+/// @brief Test flag sets: flags take the lowest free bit, and bits of removed (or
+///        rolled back) flags are given back, so a full set still takes new flags.
+/// @return < 0 if any test went wrong, 0 otherwise.
+/////////////////////////////////////////////////////////////////////////////////////
+int Test_OptionsFlagSet()
+{
+    SVRTY_LOG_INF("********** OptionsFlagSet Test Start **********");
+
+    uint64_t flag_set[GET_OPT_FLAG_WORDS(2)] = {0};
+    int test_overall_result = TEST_FLG_SUCCESS;
+
+    SetOptionsFlagSet(flag_set, 2);
+
+    int flag_bits[] =
+    {
+        SetOptionDefinitionFlag('a', "FlagA", "Flag set test.", false),
+        SetOptionDefinitionFlag('b', "FlagB", "Flag set test.", false),
+        SetOptionDefinitionFlag('c', "FlagC", "Flag set test.", false),
+        RemoveOptionDefinition("FlagA"),
+        BeginOptionsRegistration(),
+        SetOptionDefinitionFlag('e', "FlagE", "Flag set test.", false),
+        AbortOptionsRegistration(),
+        SetOptionDefinitionFlag('d', "FlagD", "Flag set test.", false),
+    };
+    int expected_flag_bits[] = {0, 1, GET_OPT_ERR_FLAG_SET, GET_OPT_SUCCESS, GET_OPT_SUCCESS, 0, GET_OPT_SUCCESS, 0};
+
+    for(int i = 0; i < sizeof(flag_bits) / sizeof(flag_bits[0]); i++)
+    {
+        if(flag_bits[i] != expected_flag_bits[i])
+        {
+            SVRTY_LOG_ERR("Test %d failed.\tExpected %d, got %d.", i, expected_flag_bits[i], flag_bits[i]);
+            test_overall_result = TEST_FLG_ERROR;
+        }
+    }
+
+    // FlagB and FlagD keep their bits when the same set is given again, but do not fit within another one.
+    uint64_t other_flag_set[GET_OPT_FLAG_WORDS(64)] = {0};
+    int set_other_flag_set = SetOptionsFlagSet(other_flag_set, 64);
+    int set_same_flag_set = SetOptionsFlagSet(flag_set, 64);
+    int flag_f_bit = SetOptionDefinitionFlag('g', "FlagF", "Flag set test.", false);
+
+    if(set_other_flag_set != GET_OPT_ERR_FLAG_SET || set_same_flag_set != GET_OPT_SUCCESS || flag_f_bit != 2)
+    {
+        SVRTY_LOG_ERR("Unexpected flag set switch (%d, %d), FlagF bit %d.", set_other_flag_set, set_same_flag_set, flag_f_bit);
+        test_overall_result = TEST_FLG_ERROR;
+    }
+
+    // --fast-path and --fast_path would both get FLAG_TEST_FAST_PATH.
+    char header_path[] = "/tmp/GetOptionsFlagsXXXXXX";
+    char header_contents[2048] = {};
+
+    SetOptionDefinitionFlag('x', "fast-path", "Flag set test.", false);
+    SetOptionDefinitionFlag('y', "fast_path", "Flag set test.", false);
+
+    int create_test_file = CreateTestFile(header_path, "");
+    int write_colliding_header = WriteOptionsFlagHeader(header_path, "FLAG_TEST_");
+    RemoveOptionDefinition("fast_path");
+    int write_header = WriteOptionsFlagHeader(header_path, "FLAG_TEST_");
+
+    FILE* header_file = fopen(header_path, "r");
+
+    if(header_file != NULL)
+    {
+        fread(header_contents, 1, sizeof(header_contents) - 1, header_file);
+        fclose(header_file);
+    }
+
+    unlink(header_path);
+
+    char* expected_header_lines[] =
+    {
+        "#ifndef FLAG_TEST_FLAG_SET_H\n",
+        "#define FLAG_TEST_FLAG_WORDS 1\n",
+        "#define FLAG_TEST_FLAGD_BIT 0\n",
+        "#define FLAG_TEST_FLAGB(flag_set) GET_OPT_FLAG_TEST(flag_set, 1)\n",
+        "#define FLAG_TEST_SET_FLAGF(flag_set) GET_OPT_FLAG_SET(flag_set, 2)\n",
+        "#define FLAG_TEST_FAST_PATH_BIT 3\n",
+    };
+
+    if(create_test_file < 0 || write_colliding_header != GET_OPT_ERR_FLAG_MACRO || write_header != GET_OPT_SUCCESS)
+    {
+        SVRTY_LOG_ERR("Unexpected flag header (%d, %d, %d).", create_test_file, write_colliding_header, write_header);
+        test_overall_result = TEST_FLG_ERROR;
+    }
+
+    for(int i = 0; i < sizeof(expected_header_lines) / sizeof(expected_header_lines[0]); i++)
+    {
+        if(strstr(header_contents, expected_header_lines[i]) == NULL)
+        {
+            SVRTY_LOG_ERR("Flag header line missing: %s", expected_header_lines[i]);
+            test_overall_result = TEST_FLG_ERROR;
+        }
+    }
+
+    optind = 0;
+    int parse_options = ParseOptions(2, (char*[]){"FlagSetTest", "--FlagD", NULL});
+
+    if(parse_options < 0 || !GET_OPT_FLAG_TEST(flag_set, 0) || GET_OPT_FLAG_TEST(flag_set, 1) || GET_OPT_FLAG_TEST(flag_set, 2))
+    {
+        SVRTY_LOG_ERR("Unexpected flag set 0x%02lX (%d).", (unsigned long)flag_set[0], parse_options);
+        test_overall_result = TEST_FLG_ERROR;
+    }
+
+    FreeOptionsStore();
+
+    if(test_overall_result < 0)
+    {
+        SVRTY_LOG_WNG("OptionsFlagSet test failed.");
+    }
+    else
+    {
+        SVRTY_LOG_INF("OptionsFlagSet test succeed!");
+    }
+
+    SVRTY_LOG_INF("********** OptionsFlagSet Test End **********");
+
+    return test_overall_result;
+}
+
+///////////////////////////////////////////////////////////////////////////////////
+/// @brief Test that options defined while an option store is published do not
+///        reuse slots of removed options (by name or by handle), so older handles
+///        never read them.
+/// @return < 0 if any test went wrong, 0 otherwise.
+///////////////////////////////////////////////////////////////////////////////////
+int Test_OptionsRemoval()
+{
+    SVRTY_LOG_INF("********** OptionsRemoval Test Start **********");
+
+    int slot_a = 0;
+    int slot_b = 0;
+    int slot_c = 0;
+    int slot_d = 0;
+    int test_overall_result = TEST_FLG_SUCCESS;
+
+    SetOptionsReloadMode(1);
+    SetOptionDefinitionInt('a', "SlotA", "Removal test.", 0, 9, 4, &slot_a);
+    SetOptionDefinitionInt('c', "SlotC", "Removal test.", 0, 9, 8, &slot_c);
+
+    optind = 0;
+    int parse_options = ParseOptions(1, (char*[]){"RemovalTest", NULL});
+    int slot_a_handle = GetOptHandle("SlotA");
+
+    int remove_option_definition = RemoveOptionDefinition("SlotA");
+    SetOptionDefinitionInt('b', "SlotB", "Removal test.", 0, 9, 6, &slot_b);
+
+    int reload_options = ReloadOptions();
+    int slot_b_handle = GetOptHandle("SlotB");
+
+    if( parse_options               < 0                 ||
+        slot_a_handle               < 0                 ||
+        remove_option_definition    != GET_OPT_SUCCESS  ||
+        reload_options              != 1                ||
+        slot_b_handle               == slot_a_handle    ||
+        GetOptInt(slot_b_handle)    != 6                ||
+        GetOptHandle("SlotA")       >= 0                )
+    {
+        SVRTY_LOG_ERR("Unexpected removal (%d, %d, %d), handles %d and %d.", parse_options, remove_option_definition, reload_options, slot_a_handle, slot_b_handle);
+        test_overall_result = TEST_FLG_ERROR;
+    }
+
+    // Removal by handle: only once, never within a registration batch, and other handles keep working.
+    int slot_c_handle = GetOptHandle("SlotC");
+
+    BeginOptionsRegistration();
+    int remove_within_batch = RemoveOptionDefinitionByHandle(slot_b_handle);
+    AbortOptionsRegistration();
+
+    int remove_by_handle = RemoveOptionDefinitionByHandle(slot_b_handle);
+    int remove_by_handle_twice = RemoveOptionDefinitionByHandle(slot_b_handle);
+    int remove_by_removed_handle = RemoveOptionDefinitionByHandle(slot_a_handle);
+    int remove_by_wrong_handle = RemoveOptionDefinitionByHandle(-1);
+    SetOptionDefinitionInt('d', "SlotD", "Removal test.", 0, 9, 2, &slot_d);
+
+    reload_options = ReloadOptions();
+    int slot_d_handle = GetOptHandle("SlotD");
+
+    if( remove_within_batch         != GET_OPT_ERR_REGISTRATION_BATCH   ||
+        remove_by_handle            != GET_OPT_SUCCESS                  ||
+        remove_by_handle_twice      != GET_OPT_ERR_UNKNOWN_OPTION       ||
+        remove_by_removed_handle    != GET_OPT_ERR_UNKNOWN_OPTION       ||
+        remove_by_wrong_handle      != GET_OPT_ERR_UNKNOWN_OPTION       ||
+        reload_options              < 0                                 ||
+        GetOptHandle("SlotB")       >= 0                                ||
+        GetOptHandle("SlotC")       != slot_c_handle                    ||
+        GetOptInt(slot_c_handle)    != 8                                ||
+        slot_d_handle               == slot_b_handle                    ||
+        GetOptInt(slot_d_handle)    != 2                                )
+    {
+        SVRTY_LOG_ERR("Unexpected removal by handle (%d, %d, %d, %d, %d, %d), handles %d and %d.", remove_within_batch, remove_by_handle, remove_by_handle_twice, remove_by_removed_handle, remove_by_wrong_handle, reload_options, slot_c_handle, slot_d_handle);
+        test_overall_result = TEST_FLG_ERROR;
+    }
+
+    EndOptionsReload();
+
+    if(test_overall_result < 0)
+    {
+        SVRTY_LOG_WNG("OptionsRemoval test failed.");
+    }
+    else
+    {
+        SVRTY_LOG_INF("OptionsRemoval test succeed!");
+    }
+
+    SVRTY_LOG_INF("********** OptionsRemoval Test End **********");
+
+    return test_overall_result;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////
+/// @brief Test string constraints: length, characters and boundaries ("bb" to "dd")
+///        are all checked on the same pass over the value.
+/// @return < 0 if any test went wrong, 0 otherwise.
+//////////////////////////////////////////////////////////////////////////////////////
+int Test_OptionsStringConstraint()
+{
+    SVRTY_LOG_INF("********** OptionsStringConstraint Test Start **********");
+
+    struct
+    {
+        char*   value           ;
+        int     expected_result ;
+
+    } constraint_test_cases[] =
+    {
+        {"c"    , GET_OPT_SUCCESS                   },
+        {"bb"   , GET_OPT_SUCCESS                   },
+        {"dd"   , GET_OPT_SUCCESS                   },
+        {"b"    , GET_OPT_ERR_VAL_OUT_OF_BOUNDS     },
+        {"dda"  , GET_OPT_ERR_VAL_OUT_OF_BOUNDS     },
+        {"e"    , GET_OPT_ERR_VAL_OUT_OF_BOUNDS     },
+        {"abcd" , GET_OPT_ERR_STRING_CONSTRAINT     },
+        {"cC"   , GET_OPT_ERR_STRING_CONSTRAINT     },
+        {""     , GET_OPT_ERR_STRING_CONSTRAINT     },
+    };
+
+    char constrained_name[100] = {};
+    int test_overall_result = TEST_FLG_SUCCESS;
+
+    for(int i = 0; i < sizeof(constraint_test_cases) / sizeof(constraint_test_cases[0]); i++)
+    {
+        // A NULL prefix stands for none.
+        SetOptionDefinitionString('k', "ConstrainedName", "String constraint test.", "bb", "dd", "cc", constrained_name);
+        int set_option_string_constraint = SetOptionStringConstraint("ConstrainedName", 1, 3, "a-z", NULL);
+
+        optind = 0;
+        int parse_options = (set_option_string_constraint < 0 ? set_option_string_constraint : ParseOptions(3, (char*[]){"StringConstraintTest", "--ConstrainedName", constraint_test_cases[i].value, NULL}));
+
+        if(parse_options >= 0)
+        {
+            FreeOptionsStore();
+        }
+
+        if( parse_options != constraint_test_cases[i].expected_result ||
+            (parse_options >= 0 && strcmp(constrained_name, constraint_test_cases[i].value) != 0))
+        {
+            SVRTY_LOG_ERR("Test %d failed.\tExpected %d, got %d.", i, constraint_test_cases[i].expected_result, parse_options);
+            test_overall_result = TEST_FLG_ERROR;
+            continue;
+        }
+
+        SVRTY_LOG_INF(TEST_MSG_SUCCEED, i);
+    }
+
+    if(test_overall_result < 0)
+    {
+        SVRTY_LOG_WNG("OptionsStringConstraint test failed.");
+    }
+    else
+    {
+        SVRTY_LOG_INF("OptionsStringConstraint test succeed!");
+    }
+
+    SVRTY_LOG_INF("********** OptionsStringConstraint Test End **********");
+
+    return test_overall_result;
+}
+
+int ParsePercentCodec(char* arg, void* value)
+{
+    char* end = NULL;
+    long percent = strtol(arg, &end, 10);
+
+    if(end == arg || strcmp(end, "%") != 0 || percent < 0 || percent > 100)
+    {
+        return -1;
+    }
+
+    *(uint8_t*)value = (uint8_t)percent;
+
+    return 0;
+}
+
+int ComparePercentCodec(void* value_a, void* value_b)
+{
+    return (int)*(uint8_t*)value_a - (int)*(uint8_t*)value_b;
+}
+
+int FormatPercentCodec(void* value, char* buffer, size_t buffer_size)
+{
+    return snprintf(buffer, buffer_size, "%u%%", *(uint8_t*)value);
+}
+
+void FormatConvertedEndpoint(struct sockaddr_storage* endpoint, char* buffer, size_t buffer_size)
+{
+    char address[INET6_ADDRSTRLEN] = {};
+
+    switch(endpoint->ss_family)
+    {
+        case AF_INET:
+            inet_ntop(AF_INET, &((struct sockaddr_in*)endpoint)->sin_addr, address, sizeof(address));
+            snprintf(buffer, buffer_size, "%s:%u", address, ntohs(((struct sockaddr_in*)endpoint)->sin_port));
+            break;
+
+        case AF_INET6:
+            inet_ntop(AF_INET6, &((struct sockaddr_in6*)endpoint)->sin6_addr, address, sizeof(address));
+            snprintf(buffer, buffer_size, "[%s]:%u", address, ntohs(((struct sockaddr_in6*)endpoint)->sin6_port));
+            break;
+
+        case AF_UNIX:
+            snprintf(buffer, buffer_size, "unix:%s", ((struct sockaddr_un*)endpoint)->sun_path);
+            break;
+
+        default:
+            snprintf(buffer, buffer_size, "unspec");
+            break;
+    }
+}
+
+int Test_OptionsConverters()
+{
+    SVRTY_LOG_INF("********** OptionsConverters Test Start **********");
+
+    static int percent_type = -1;
+
+    if(percent_type < 0)
+    {
+        percent_type = RegisterOptionCodec(&(GET_OPT_CODEC){sizeof(uint8_t), ParsePercentCodec, ComparePercentCodec, FormatPercentCodec});
+    }
+
+    struct
+    {
+        char    opt_char        ;
+        char*   opt_long        ;
+        char*   value           ;
+        int     expected_result ;
+        char*   expected_value  ;
+
+    } converter_test_cases[] =
+    {
+        {'i', "--ConvertedInt"     , "3"                   , GET_OPT_SUCCESS               , "3"                   },
+        {'i', "--ConvertedInt"     , "9"                   , GET_OPT_ERR_VAL_OUT_OF_BOUNDS , NULL                  },
+        {'f', "--ConvertedFloat"   , "1.25"                , GET_OPT_SUCCESS               , "1.25"                },
+        {'f', "--ConvertedFloat"   , "3"                   , GET_OPT_ERR_VAL_OUT_OF_BOUNDS , NULL                  },
+        {'d', "--ConvertedDouble"  , "-0.125"              , GET_OPT_SUCCESS               , "-0.125"              },
+        {'d', "--ConvertedDouble"  , "-2"                  , GET_OPT_ERR_VAL_OUT_OF_BOUNDS , NULL                  },
+        {'s', "--ConvertedString"  , "m"                   , GET_OPT_SUCCESS               , "m"                   },
+        {'s', "--ConvertedString"  , "z"                   , GET_OPT_ERR_VAL_OUT_OF_BOUNDS , NULL                  },
+        {'p', "--ConvertedPercent" , "40%"                 , GET_OPT_SUCCESS               , "40%"                 },
+        {'p', "--ConvertedPercent" , "60%"                 , GET_OPT_ERR_VAL_OUT_OF_BOUNDS , NULL                  },
+        {'p', "--ConvertedPercent" , "40"                  , GET_OPT_ERR_CODEC_VALUE       , NULL                  },
+        {'p', "--ConvertedPercent" , "101%"                , GET_OPT_ERR_CODEC_VALUE       , NULL                  },
+        {'e', "--ConvertedEndpoint", "127.0.0.1:8080"      , GET_OPT_SUCCESS               , "127.0.0.1:8080"      },
+        {'e', "--ConvertedEndpoint", "[::1]:80"            , GET_OPT_SUCCESS               , "[::1]:80"            },
+        {'e', "--ConvertedEndpoint", "unix:/run/test.sock" , GET_OPT_SUCCESS               , "unix:/run/test.sock" },
+        {'e', "--ConvertedEndpoint", "127.0.0.1:70"        , GET_OPT_ERR_VAL_OUT_OF_BOUNDS , NULL                  },
+        {'e', "--ConvertedEndpoint", "127.0.0.1"           , GET_OPT_ERR_CODEC_VALUE       , NULL                  },
+        {'e', "--ConvertedEndpoint", "localhost:80"        , GET_OPT_ERR_CODEC_VALUE       , NULL                  },
+        {'e', "--ConvertedEndpoint", "[::1]:65536"         , GET_OPT_ERR_CODEC_VALUE       , NULL                  },
+    };
+
+    int                     converted_int       = 0;
+    float                   converted_float     = 0;
+    double                  converted_double    = 0;
+    char                    converted_string[100] = {};
+    uint8_t                 converted_percent   = 0;
+    struct sockaddr_storage converted_endpoint  = {};
+    uint8_t                 percent_max         = 50;
+    uint8_t                 percent_default     = 10;
+    char                    converted_value[128] = {};
+    int                     test_overall_result = TEST_FLG_SUCCESS;
+
+    if(percent_type < 0)
+    {
+        SVRTY_LOG_ERR("Codec registration failed.\tGot %d.", percent_type);
+        test_overall_result = TEST_FLG_ERROR;
+    }
+
+    for(int i = 0; i < sizeof(converter_test_cases) / sizeof(converter_test_cases[0]) && percent_type >= 0; i++)
+    {
+        int set_option_definition = GET_OPT_SUCCESS;
+
+        set_option_definition |= SetOptionDefinitionInt('i', "ConvertedInt", "Integer converter test.", 0, 4, 1, &converted_int);
+        set_option_definition |= SetOptionDefinitionFloat('f', "ConvertedFloat", "Float converter test.", 0.5, 2.5, 1.0, &converted_float);
+        set_option_definition |= SetOptionDefinitionDouble('d', "ConvertedDouble", "Double converter test.", -1.0, 1.0, 0.0, &converted_double);
+        set_option_definition |= SetOptionDefinitionString('s', "ConvertedString", "String converter test.", "b", "y", "c", converted_string);
+        set_option_definition |= SetOptionDefinitionCodec('p', "ConvertedPercent", "Codec converter test.", percent_type, NULL, &percent_max, &percent_default, &converted_percent);
+        set_option_definition |= SetOptionDefinitionEndpoint('e', "ConvertedEndpoint", "Endpoint converter test.", 80, 9000, "127.0.0.1:8000", &converted_endpoint);
+
+        optind = 0;
+        int parse_options = (set_option_definition < 0 ? set_option_definition : ParseOptions(3, (char*[]){"ConverterTest", converter_test_cases[i].opt_long, converter_test_cases[i].value, NULL}));
+
+        if(parse_options >= 0)
+        {
+            FreeOptionsStore();
+        }
+
+        switch(converter_test_cases[i].opt_char)
+        {
+            case 'i': snprintf(converted_value, sizeof(converted_value), "%d", converted_int);                  break;
+            case 'f': snprintf(converted_value, sizeof(converted_value), "%g", converted_float);                break;
+            case 'd': snprintf(converted_value, sizeof(converted_value), "%g", converted_double);               break;
+            case 's': snprintf(converted_value, sizeof(converted_value), "%s", converted_string);               break;
+            case 'p': FormatPercentCodec(&converted_percent, converted_value, sizeof(converted_value));         break;
+            case 'e': FormatConvertedEndpoint(&converted_endpoint, converted_value, sizeof(converted_value));   break;
+        }
+
+        if( parse_options != converter_test_cases[i].expected_result ||
+            (parse_options >= 0 && strcmp(converted_value, converter_test_cases[i].expected_value) != 0))
+        {
+            SVRTY_LOG_ERR("Test %d failed.\tExpected %d, got %d (%s).", i, converter_test_cases[i].expected_result, parse_options, converted_value);
+            test_overall_result = TEST_FLG_ERROR;
+            continue;
+        }
+
+        SVRTY_LOG_INF(TEST_MSG_SUCCEED, i);
+    }
+
+    // Port boundaries are checked against each other and against the port range when defined.
+    int endpoint_boundaries[][2] = {{-1, 80}, {80, 65536}, {9000, 80}};
+
+    for(int i = 0; i < sizeof(endpoint_boundaries) / sizeof(endpoint_boundaries[0]); i++)
+    {
+        BeginOptionsRegistration();
+        int set_option_definition = SetOptionDefinitionEndpoint('e', "ConvertedEndpoint", "Endpoint converter test.", endpoint_boundaries[i][0], endpoint_boundaries[i][1], NULL, &converted_endpoint);
+        AbortOptionsRegistration();
+
+        if(set_option_definition != GET_OPT_ERR_WRONG_BOUNDARIES)
+        {
+            SVRTY_LOG_ERR("Port boundaries %d..%d accepted.\tExpected %d, got %d.", endpoint_boundaries[i][0], endpoint_boundaries[i][1], GET_OPT_ERR_WRONG_BOUNDARIES, set_option_definition);
+            test_overall_result = TEST_FLG_ERROR;
+        }
+    }
+
+    if(test_overall_result < 0)
+    {
+        SVRTY_LOG_WNG("OptionsConverters test failed.");
+    }
+    else
+    {
+        SVRTY_LOG_INF("OptionsConverters test succeed!");
+    }
+
+    SVRTY_LOG_INF("********** OptionsConverters Test End **********");
+
+    return test_overall_result;
+}
+
+int Test_OptionsBlobs()
+{
+    SVRTY_LOG_INF("********** OptionsBlobs Test Start **********");
+
+    struct
+    {
+        char*   opt_long        ;
+        char*   value           ;
+        int     expected_result ;
+        char*   expected_value  ;
+
+    } blob_test_cases[] =
+    {
+        {"--HexBlob"    , "deadBEEF"    , GET_OPT_SUCCESS               , "deadbeef"    },
+        {"--HexBlob"    , "0a1"         , GET_OPT_ERR_CODEC_VALUE       , NULL          },
+        {"--HexBlob"    , "0g"          , GET_OPT_ERR_CODEC_VALUE       , NULL          },
+        {"--HexBlob"    , "0102030405"  , GET_OPT_ERR_VAL_OUT_OF_BOUNDS , NULL          },
+        {"--HexBlob"    , ""            , GET_OPT_ERR_VAL_OUT_OF_BOUNDS , NULL          },
+        {"--Base64Blob" , "aGk="        , GET_OPT_SUCCESS               , "6869"        },
+        {"--Base64Blob" , "aGk"         , GET_OPT_SUCCESS               , "6869"        },
+        {"--Base64Blob" , "_-8="        , GET_OPT_SUCCESS               , "ffef"        },
+        {"--Base64Blob" , "aGk=="       , GET_OPT_ERR_CODEC_VALUE       , NULL          },
+        {"--Base64Blob" , "a=k="        , GET_OPT_ERR_CODEC_VALUE       , NULL          },
+        {"--Base64Blob" , "aG!="        , GET_OPT_ERR_CODEC_VALUE       , NULL          },
+        {"--Base64Blob" , "a"           , GET_OPT_ERR_CODEC_VALUE       , NULL          },
+    };
+
+    GET_OPT_BLOB    hex_blob            = {};
+    GET_OPT_BLOB    base64_blob         = {};
+    char            blob_value[64]      = {};
+    int             test_overall_result = TEST_FLG_SUCCESS;
+
+    for(int i = 0; i < sizeof(blob_test_cases) / sizeof(blob_test_cases[0]); i++)
+    {
+        int set_option_definition = GET_OPT_SUCCESS;
+
+        set_option_definition |= SetOptionDefinitionBlob('x', "HexBlob", "Hex blob test.", GET_OPT_TYPE_BLOB_HEX, 1, 4, "00", &hex_blob);
+        set_option_definition |= SetOptionDefinitionBlob('y', "Base64Blob", "Base64 blob test.", GET_OPT_TYPE_BLOB_BASE64, 0, 0, NULL, &base64_blob);
+
+        optind = 0;
+        int parse_options = (set_option_definition < 0 ? set_option_definition : ParseOptions(3, (char*[]){"BlobTest", blob_test_cases[i].opt_long, blob_test_cases[i].value, NULL}));
+
+        if(parse_options >= 0)
+        {
+            FreeOptionsStore();
+        }
+
+        GET_OPT_BLOB* blob = (blob_test_cases[i].opt_long[2] == 'H' ? &hex_blob : &base64_blob);
+
+        blob_value[0] = '\0';
+
+        for(size_t j = 0; j < blob->length && 2 * j + 2 < sizeof(blob_value); j++)
+        {
+            snprintf(blob_value + 2 * j, 3, "%02x", blob->data[j]);
+        }
+
+        if( parse_options != blob_test_cases[i].expected_result ||
+            (parse_options >= 0 && strcmp(blob_value, blob_test_cases[i].expected_value) != 0))
+        {
+            SVRTY_LOG_ERR("Test %d failed.\tExpected %d, got %d (%s).", i, blob_test_cases[i].expected_result, parse_options, blob_value);
+            test_overall_result = TEST_FLG_ERROR;
+            continue;
+        }
+
+        SVRTY_LOG_INF(TEST_MSG_SUCCEED, i);
+    }
+
+    // Defaults are checked as values are: not decodable or out of the boundaries.
+    struct
+    {
+        char*   default_value   ;
+        size_t  min_length      ;
+        int     expected_result ;
+
+    } blob_default_test_cases[] =
+    {
+        {"0"    , 0 , GET_OPT_ERR_CODEC_VALUE       },
+        {"zz"   , 0 , GET_OPT_ERR_CODEC_VALUE       },
+        {NULL   , 1 , GET_OPT_ERR_VAL_OUT_OF_BOUNDS },
+    };
+
+    for(int i = 0; i < sizeof(blob_default_test_cases) / sizeof(blob_default_test_cases[0]); i++)
+    {
+        BeginOptionsRegistration();
+        int set_option_definition = SetOptionDefinitionBlob('x', "HexBlob", "Hex blob test.", GET_OPT_TYPE_BLOB_HEX, blob_default_test_cases[i].min_length, 0, blob_default_test_cases[i].default_value, &hex_blob);
+        AbortOptionsRegistration();
+
+        if(set_option_definition != blob_default_test_cases[i].expected_result)
+        {
+            SVRTY_LOG_ERR("Default %d failed.\tExpected %d, got %d.", i, blob_default_test_cases[i].expected_result, set_option_definition);
+            test_overall_result = TEST_FLG_ERROR;
+        }
+    }
+
+    if(test_overall_result < 0)
+    {
+        SVRTY_LOG_WNG("OptionsBlobs test failed.");
+    }
+    else
+    {
+        SVRTY_LOG_INF("OptionsBlobs test succeed!");
+    }
+
+    SVRTY_LOG_INF("********** OptionsBlobs Test End **********");
+
+    return test_overall_result;
+}
+
+int Test_OptionsCmdline()
+{
+    SVRTY_LOG_INF("********** OptionsCmdline Test Start **********");
+
+    // A cmdline_size of 0 stands for a command line string, NUL-separated arguments otherwise.
+    struct
+    {
+        char*   cmdline         ;
+        size_t  cmdline_size    ;
+        int     expected_result ;
+        char*   expected_word   ;
+        int     expected_count  ;
+
+    } cmdline_test_cases[] =
+    {
+        {"prog --CmdlineWord \"a b\" --CmdlineCount 2"      , 0 , GET_OPT_SUCCESS               , "a b"         , 2 },
+        {"prog --CmdlineWord 'x \"y\" \\z'"                 , 0 , GET_OPT_SUCCESS               , "x \"y\" \\z" , 1 },
+        {"prog --CmdlineWord a\\ b\\\"c"                    , 0 , GET_OPT_SUCCESS               , "a b\"c"      , 1 },
+        {"prog --CmdlineWord \"q\\\"\\$\\x\""               , 0 , GET_OPT_SUCCESS               , "q\"$\\x"     , 1 },
+        {"prog --CmdlineWord ab\\\nc"                       , 0 , GET_OPT_SUCCESS               , "abc"         , 1 },
+        {"prog --CmdlineWord '' --CmdlineCount 3"           , 0 , GET_OPT_SUCCESS               , ""            , 3 },
+        {"prog --CmdlineWord \"\"x"                         , 0 , GET_OPT_SUCCESS               , "x"           , 1 },
+        {"  prog \t --CmdlineCount   4  \n"                 , 0 , GET_OPT_SUCCESS               , "word"        , 4 },
+        {"prog --CmdlineWord \"abc"                         , 0 , GET_OPT_ERR_CMDLINE_SYNTAX    , NULL          , 0 },
+        {"prog --CmdlineWord 'abc"                          , 0 , GET_OPT_ERR_CMDLINE_SYNTAX    , NULL          , 0 },
+        {"prog --CmdlineWord abc\\"                         , 0 , GET_OPT_ERR_CMDLINE_SYNTAX    , NULL          , 0 },
+        {"prog\0--CmdlineWord\0a 'b'"                       , 25, GET_OPT_SUCCESS               , "a 'b'"       , 1 },
+        {"prog\0--CmdlineWord\0\0--CmdlineCount\0005"       , 37, GET_OPT_SUCCESS               , ""            , 5 },
+        {"prog\0--CmdlineWord\0abc"                         , 22, GET_OPT_ERR_CMDLINE_SYNTAX    , NULL          , 0 },
+    };
+
+    char cmdline[128] = {};
+    char cmdline_word[PATH_MAX + 1] = {};
+    int cmdline_count = 0;
+    int test_overall_result = TEST_FLG_SUCCESS;
+
+    for(int i = 0; i < sizeof(cmdline_test_cases) / sizeof(cmdline_test_cases[0]); i++)
+    {
+        int set_option_definition = GET_OPT_SUCCESS;
+
+        set_option_definition |= SetOptionDefinitionStringNL('w', "CmdlineWord", "Command line test.", "word", cmdline_word);
+        set_option_definition |= SetOptionDefinitionInt('c', "CmdlineCount", "Command line test.", 0, 8, 1, &cmdline_count);
+
+        // Command lines are tokenized in place.
+        size_t cmdline_size = (cmdline_test_cases[i].cmdline_size == 0 ? strlen(cmdline_test_cases[i].cmdline) + 1 : cmdline_test_cases[i].cmdline_size);
+        memcpy(cmdline, cmdline_test_cases[i].cmdline, cmdline_size);
+
+        optind = 0;
+        int parse_options = set_option_definition;
+
+        if(set_option_definition >= 0)
+        {
+            parse_options = (cmdline_test_cases[i].cmdline_size == 0 ? ParseOptionsFromString(cmdline) : ParseOptionsFromCmdline(cmdline, cmdline_size));
+        }
+
+        if(parse_options >= 0)
+        {
+            FreeOptionsStore();
+        }
+
+        if( parse_options != cmdline_test_cases[i].expected_result                                                          ||
+            (parse_options >= 0 && (strcmp(cmdline_word, cmdline_test_cases[i].expected_word) != 0 || cmdline_count != cmdline_test_cases[i].expected_count)))
+        {
+            SVRTY_LOG_ERR("Test %d failed.\tExpected %d, got %d (\"%s\", %d).", i, cmdline_test_cases[i].expected_result, parse_options, cmdline_word, cmdline_count);
+            test_overall_result = TEST_FLG_ERROR;
+            continue;
+        }
+
+        SVRTY_LOG_INF(TEST_MSG_SUCCEED, i);
+    }
+
+    if(test_overall_result < 0)
+    {
+        SVRTY_LOG_WNG("OptionsCmdline test failed.");
+    }
+    else
+    {
+        SVRTY_LOG_INF("OptionsCmdline test succeed!");
+    }
+
+    SVRTY_LOG_INF("********** OptionsCmdline Test End **********");
+
+    return test_overall_result;
+}
+
+typedef struct
+{
+    char        events[512]     ;
+    void*       blob_values[2]  ;
+    int         blob_number     ;
+
+} StreamTestLog;
+
+void LogStreamEvent(GET_OPT_STREAM_EVENT* event, void* user_data)
+{
+    StreamTestLog* log = (StreamTestLog*)user_data;
+    size_t log_length = strlen(log->events);
+
+    switch(event->event)
+    {
+        case GET_OPT_STREAM_EVENT_OPTION:
+        {
+            // Blob values are only checked to take the same memory every time.
+            if(event->opt_var_type == GET_OPT_TYPE_BLOB_HEX)
+            {
+                snprintf(log->events + log_length, sizeof(log->events) - log_length, "%c ", event->opt_char);
+                log->blob_values[log->blob_number++ % 2] = event->value.custom;
+                break;
+            }
+
+            snprintf(log->events + log_length, sizeof(log->events) - log_length, "%c=%d ", event->opt_char, event->value.integer);
+        }
+        break;
+
+        case GET_OPT_STREAM_EVENT_ERROR:
+            snprintf(log->events + log_length, sizeof(log->events) - log_length, "E%d ", event->code);
+            break;
+
+        case GET_OPT_STREAM_EVENT_END:
+            snprintf(log->events + log_length, sizeof(log->events) - log_length, "END%d|", event->code);
+            break;
+    }
+}
+
+int Test_OptionsStream()
+{
+    SVRTY_LOG_INF("********** OptionsStream Test Start **********");
+
+    // Messages are fed in chunks of chunk_size bytes, so tokens are split across chunks.
+    struct
+    {
+        char*   messages        ;
+        size_t  chunk_size      ;
+        char*   expected_events ;
+
+    } stream_test_cases[] =
+    {
+        {"--StreamLevel 3 -d --StreamKey c0de\n"        , 5     , "l=3 d=1 k END0|"                 },
+        {"-l2 --StreamKey=00ff\n-dl 4\n"                , 1     , "l=2 k END0|d=1 l=4 END0|"        },
+        {"-l9\n-l1\n"                                   , 3     , "E-10 END-10|l=1 END0|"           },
+        {"--StreamKey 0\n"                              , 64    , "E-37 END-37|"                    },
+        {"--StreamUnknown 1 -l2\n-x\n"                  , 7     , "E-15 END-15|E-15 END-15|"        },
+        {"-d -l\n"                                      , 64    , "d=1 E-14 END-14|"                },
+        {"-d --StreamLevel '3'\n-l \"2\"\\\n\n"         , 2     , "d=1 l=3 END0|l=2 END0|"          },
+    };
+
+    int stream_level = 0;
+    int stream_drain = 0;
+    GET_OPT_BLOB stream_key = {};
+    GET_OPT_STREAM stream;
+    StreamTestLog stream_log = {};
+    int test_overall_result = TEST_FLG_SUCCESS;
+
+    // Streams need the schema kept in reload mode, once parsed.
+    int init_unparsed = InitOptionsStream(&stream, LogStreamEvent, &stream_log);
+
+    SetOptionsReloadMode(1);
+    SetOptionDefinitionInt('l', "StreamLevel", "Stream test.", 0, 4, 1, &stream_level);
+    SetOptionDefinitionBool('d', "StreamDrain", "Stream test.", 0, &stream_drain);
+    SetOptionDefinitionBlob('k', "StreamKey", "Stream test.", GET_OPT_TYPE_BLOB_HEX, 1, 0, "00", &stream_key);
+
+    optind = 0;
+    int parse_options = ParseOptions(1, (char*[]){"StreamTest", NULL});
+    int init_options_stream = InitOptionsStream(&stream, LogStreamEvent, &stream_log);
+
+    if(init_unparsed != GET_OPT_ERR_RELOAD_MODE || parse_options < 0 || init_options_stream < 0)
+    {
+        SVRTY_LOG_ERR("Unexpected stream initialization (%d, %d, %d).", init_unparsed, parse_options, init_options_stream);
+        EndOptionsReload();
+        SVRTY_LOG_WNG("OptionsStream test failed.");
+        return TEST_FLG_ERROR;
+    }
+
+    for(int i = 0; i < sizeof(stream_test_cases) / sizeof(stream_test_cases[0]); i++)
+    {
+        char* messages = stream_test_cases[i].messages;
+        size_t messages_length = strlen(messages);
+
+        stream_log.events[0] = '\0';
+
+        for(size_t offset = 0; offset < messages_length; offset += stream_test_cases[i].chunk_size)
+        {
+            size_t chunk_size = stream_test_cases[i].chunk_size;
+            FeedOptionsStream(&stream, messages + offset, (offset + chunk_size > messages_length ? messages_length - offset : chunk_size));
+        }
+
+        if(strcmp(stream_log.events, stream_test_cases[i].expected_events) != 0)
+        {
+            SVRTY_LOG_ERR("Test %d failed.\tExpected \"%s\", got \"%s\".", i, stream_test_cases[i].expected_events, stream_log.events);
+            test_overall_result = TEST_FLG_ERROR;
+            continue;
+        }
+
+        SVRTY_LOG_INF(TEST_MSG_SUCCEED, i);
+    }
+
+    // Tokens longer than GET_OPT_SIZE_STREAM_TOKEN_MAX fail the message, and the stream goes on with the next one.
+    char long_token[GET_OPT_SIZE_STREAM_TOKEN_MAX + 2];
+    memset(long_token, 'a', sizeof(long_token));
+    stream_log.events[0] = '\0';
+
+    int feed_prefix = FeedOptionsStream(&stream, "--StreamKey ", strlen("--StreamKey "));
+    int feed_long_token = FeedOptionsStream(&stream, long_token, sizeof(long_token));
+    int feed_next_message = FeedOptionsStream(&stream, "\n-l3\n", strlen("\n-l3\n"));
+
+    if( feed_prefix         != GET_OPT_SUCCESS              ||
+        feed_long_token     != GET_OPT_ERR_STREAM_TOKEN     ||
+        feed_next_message   != GET_OPT_SUCCESS              ||
+        strcmp(stream_log.events, "E-39 END-39|l=3 END0|") != 0)
+    {
+        SVRTY_LOG_ERR("Long token test failed (%d, %d, %d): \"%s\".", feed_prefix, feed_long_token, feed_next_message, stream_log.events);
+        test_overall_result = TEST_FLG_ERROR;
+    }
+
+    // Blobs are given back to the arena once emitted, and nothing is assigned.
+    if( stream_log.blob_number < 2                                  ||
+        stream_log.blob_values[0] != stream_log.blob_values[1]      ||
+        stream_level != 1 || stream_drain != 0                      ||
+        stream_key.length != 1 || stream_key.data[0] != 0x00        )
+    {
+        SVRTY_LOG_ERR("Stream values leaked (%d blobs), level = %d, drain = %d.", stream_log.blob_number, stream_level, stream_drain);
+        test_overall_result = TEST_FLG_ERROR;
+    }
+
+    EndOptionsReload();
+
+    if(test_overall_result < 0)
+    {
+        SVRTY_LOG_WNG("OptionsStream test failed.");
+    }
+    else
+    {
+        SVRTY_LOG_INF("OptionsStream test succeed!");
+    }
+
+    SVRTY_LOG_INF("********** OptionsStream Test End **********");
+
+    return test_overall_result;
+}
+
+int Test_OptionsArgv()
+{
+    SVRTY_LOG_INF("********** OptionsArgv Test Start **********");
+
+    // Two children per batch, with two overrides each.
+    struct
+    {
+        int                 argv_mode           ;
+        GET_OPT_OVERRIDE    overrides[2][2]     ;
+        int                 expected_result     ;
+        char*               expected_argv[2]    ;
+
+    } argv_test_cases[] =
+    {
+        {GET_OPT_ARGV_MODE_DELTA, {{{"ArgvShard", "0"}, {NULL, NULL}}, {{"ArgvShard", "1"}, {"ArgvDrain", NULL}}},
+            GET_OPT_SUCCESS, {"ArgvTest --ArgvLevel=3 --ArgvName=a b --ArgvShard=0", "ArgvTest --ArgvLevel=3 --ArgvName=a b --ArgvShard=1 --ArgvDrain"}},
+        {GET_OPT_ARGV_MODE_FULL, {{{"ArgvLevel", "4"}, {"ArgvName", "some name"}}, {{"ArgvDrain", "no"}, {"ArgvLevel", "0"}}},
+            GET_OPT_SUCCESS, {"ArgvTest --ArgvShard=0 --ArgvLevel=4 --ArgvName=some name", "ArgvTest --ArgvShard=0 --ArgvName=a b --ArgvLevel=0"}},
+        {GET_OPT_ARGV_MODE_DELTA, {{{"ArgvShard", "0"}, {NULL, NULL}}, {{"ArgvShards", "1"}, {NULL, NULL}}},
+            GET_OPT_ERR_UNKNOWN_OPTION, {NULL, NULL}},
+        {GET_OPT_ARGV_MODE_DELTA, {{{"ArgvShard", NULL}, {NULL, NULL}}, {{NULL, NULL}, {NULL, NULL}}},
+            GET_OPT_ERR_NO_ARG_FOUND, {NULL, NULL}},
+        {GET_OPT_ARGV_MODE_MAX + 1, {{{NULL, NULL}, {NULL, NULL}}, {{NULL, NULL}, {NULL, NULL}}},
+            GET_OPT_ERR_UNKNOWN_TYPE, {NULL, NULL}},
+    };
+
+    int argv_level = 0;
+    int argv_shard = 0;
+    int argv_drain = 0;
+    char argv_name[PATH_MAX + 1] = {};
+    GET_OPT_ARGV* children = NULL;
+    int test_overall_result = TEST_FLG_SUCCESS;
+
+    // Children are built out of the values resolved in reload mode.
+    int build_unparsed = BuildOptionsArgv(NULL, GET_OPT_ARGV_MODE_FULL, NULL, 0, 1, &children);
+
+    SetOptionsReloadMode(1);
+    SetOptionDefinitionInt('s', "ArgvShard", "Argv test.", 0, 8, 0, &argv_shard);
+    SetOptionDefinitionInt('l', "ArgvLevel", "Argv test.", 0, 4, 1, &argv_level);
+    SetOptionDefinitionBool('d', "ArgvDrain", "Argv test.", 0, &argv_drain);
+    SetOptionDefinitionString('n', "ArgvName", "Argv test.", "a", "z", "b", argv_name);
+
+    optind = 0;
+    int parse_options = ParseOptions(5, (char*[]){"ArgvTest", "--ArgvLevel", "3", "--ArgvName", "a b", NULL});
+
+    if(build_unparsed != GET_OPT_ERR_RELOAD_MODE || parse_options < 0)
+    {
+        SVRTY_LOG_ERR("Unexpected argv initialization (%d, %d).", build_unparsed, parse_options);
+        test_overall_result = TEST_FLG_ERROR;
+    }
+
+    for(int i = 0; i < sizeof(argv_test_cases) / sizeof(argv_test_cases[0]) && test_overall_result == TEST_FLG_SUCCESS; i++)
+    {
+        children = NULL;
+        int build_options_argv = BuildOptionsArgv(NULL, argv_test_cases[i].argv_mode, &argv_test_cases[i].overrides[0][0], 2, 2, &children);
+        bool children_match = (build_options_argv == argv_test_cases[i].expected_result);
+
+        for(int child_index = 0; build_options_argv >= 0 && child_index < 2; child_index++)
+        {
+            // Both argv and cmdline hold the same arguments.
+            char child_argv[256] = {};
+            char child_cmdline[256] = {};
+
+            for(int arg_index = 0; arg_index < children[child_index].argc; arg_index++)
+            {
+                strcat(child_argv, arg_index == 0 ? "" : " ");
+                strcat(child_argv, children[child_index].argv[arg_index]);
+            }
+
+            for(size_t byte_index = 0; byte_index + 1 < children[child_index].cmdline_size && byte_index + 1 < sizeof(child_cmdline); byte_index++)
+            {
+                child_cmdline[byte_index] = (children[child_index].cmdline[byte_index] == '\0' ? ' ' : children[child_index].cmdline[byte_index]);
+            }
+
+            if( strcmp(child_argv, argv_test_cases[i].expected_argv[child_index]) != 0      ||
+                strcmp(child_cmdline, argv_test_cases[i].expected_argv[child_index]) != 0   ||
+                children[child_index].argv[children[child_index].argc] != NULL              )
+            {
+                SVRTY_LOG_ERR("Child %d: expected \"%s\", got \"%s\" (\"%s\").", child_index, argv_test_cases[i].expected_argv[child_index], child_argv, child_cmdline);
+                children_match = false;
+            }
+        }
+
+        if(build_options_argv >= 0)
+        {
+            free(children);
+        }
+
+        if(!children_match)
+        {
+            SVRTY_LOG_ERR("Test %d failed.\tExpected %d, got %d.", i, argv_test_cases[i].expected_result, build_options_argv);
+            test_overall_result = TEST_FLG_ERROR;
+            continue;
+        }
+
+        SVRTY_LOG_INF(TEST_MSG_SUCCEED, i);
+    }
+
+    EndOptionsReload();
+
+    if(test_overall_result < 0)
+    {
+        SVRTY_LOG_WNG("OptionsArgv test failed.");
+    }
+    else
+    {
+        SVRTY_LOG_INF("OptionsArgv test succeed!");
+    }
+
+    SVRTY_LOG_INF("********** OptionsArgv Test End **********");
+
+    return test_overall_result;
+}
+
+int Test_OptionsExport()
+{
+    SVRTY_LOG_INF("********** OptionsExport Test Start **********");
+
+    char* expected_json =   "{\"ExportLevel\":3,\"ExportRatio\":0.1,\"ExportScale\":-2.5,\"ExportName\":\"a\\\"b\\\\c\","
+                            "\"ExportDrain\":true,\"ExportEndpoint\":\"127.0.0.1:8080\",\"ExportKey\":\"c0de\"}";
+
+    int export_level = 0;
+    float export_ratio = 0;
+    double export_scale = 0;
+    char export_name[PATH_MAX + 1] = {};
+    int export_drain = 0;
+    struct sockaddr_storage export_endpoint = {};
+    GET_OPT_BLOB export_key = {};
+    GET_OPT_EXPORT opt_export = {};
+    char json[512] = {};
+    uint64_t record[128] = {};
+    int test_overall_result = TEST_FLG_SUCCESS;
+
+    SetOptionDefinitionInt('l', "ExportLevel", "Export test.", 0, 4, 1, &export_level);
+    SetOptionDefinitionFloat('r', "ExportRatio", "Export test.", 0.0, 1.0, 0.5, &export_ratio);
+    SetOptionDefinitionDouble('s', "ExportScale", "Export test.", -4.0, 4.0, 1.0, &export_scale);
+    SetOptionDefinitionStringNL('n', "ExportName", "Export test.", "name", export_name);
+    SetOptionDefinitionBool('d', "ExportDrain", "Export test.", 0, &export_drain);
+    SetOptionDefinitionEndpoint('e', "ExportEndpoint", "Export test.", 0, 65535, NULL, &export_endpoint);
+    SetOptionDefinitionBlob('k', "ExportKey", "Export test.", GET_OPT_TYPE_BLOB_HEX, 0, 0, "c0de", &export_key);
+
+    optind = 0;
+    int parse_options = ParseOptions(11, (char*[]){"ExportTest", "-l", "3", "-r", "0.1", "-s", "-2.5", "-n", "a\"b\\c", "-de", "127.0.0.1:8080", NULL});
+    int init_options_export = (parse_options < 0 ? parse_options : InitOptionsExport(&opt_export));
+
+    if(parse_options < 0 || init_options_export < 0)
+    {
+        SVRTY_LOG_ERR("Unexpected export initialization (%d, %d).", parse_options, init_options_export);
+        FreeOptionsStore();
+        SVRTY_LOG_WNG("OptionsExport test failed.");
+        return TEST_FLG_ERROR;
+    }
+
+    // JSON is compared byte for byte, and must not be written partially into a buffer too small for it.
+    int export_json = ExportOptionsJson(&opt_export, json, sizeof(json));
+    int export_json_short = ExportOptionsJson(&opt_export, json, strlen(expected_json));
+
+    if(export_json != strlen(expected_json) || strcmp(json, expected_json) != 0 || export_json_short != GET_OPT_ERR_EXPORT_SIZE)
+    {
+        SVRTY_LOG_ERR("Unexpected JSON (%d, %d): %s", export_json, export_json_short, json);
+        test_overall_result = TEST_FLG_ERROR;
+    }
+
+    // Records are read back through their slots, and must match the option store.
+    int export_record_short = ExportOptionsRecord(&opt_export, (char*)record, sizeof(GET_OPT_RECORD_HEADER));
+    int export_record = ExportOptionsRecord(&opt_export, (char*)record, sizeof(record));
+
+    GET_OPT_RECORD_HEADER* header = (GET_OPT_RECORD_HEADER*)record;
+    GET_OPT_RECORD_SLOT* slots = (GET_OPT_RECORD_SLOT*)(header + 1);
+    int name_handle = GetOptHandle("ExportName");
+    int endpoint_handle = GetOptHandle("ExportEndpoint");
+
+    if( export_record < (int)sizeof(GET_OPT_RECORD_HEADER)                                                      ||
+        export_record_short != GET_OPT_ERR_EXPORT_SIZE                                                          ||
+        header->magic != 0x52504F47U || header->version != 1 || header->record_size != export_record            ||
+        header->option_number != 7                                                                              ||
+        slots[GetOptHandle("ExportLevel")].integer != GetOptInt(GetOptHandle("ExportLevel"))                    ||
+        slots[GetOptHandle("ExportRatio")].floating != GetOptFloat(GetOptHandle("ExportRatio"))                 ||
+        slots[GetOptHandle("ExportScale")].doubling != GetOptDouble(GetOptHandle("ExportScale"))                ||
+        slots[GetOptHandle("ExportDrain")].integer != 1                                                         ||
+        slots[name_handle].bytes.offset + slots[name_handle].bytes.length > export_record                       ||
+        strcmp((char*)record + slots[name_handle].bytes.offset, GetOptString(name_handle)) != 0                 ||
+        slots[endpoint_handle].bytes.length != sizeof(struct sockaddr_storage)                                  ||
+        memcmp((char*)record + slots[endpoint_handle].bytes.offset, &export_endpoint, sizeof(export_endpoint)) != 0)
+    {
+        SVRTY_LOG_ERR("Unexpected record (%d, %d).", export_record, export_record_short);
+        test_overall_result = TEST_FLG_ERROR;
+    }
+
+    FreeOptionsExport(&opt_export);
+    FreeOptionsStore();
+
+    if(test_overall_result < 0)
+    {
+        SVRTY_LOG_WNG("OptionsExport test failed.");
+    }
+    else
+    {
+        SVRTY_LOG_INF("OptionsExport test succeed!");
+    }
+
+    SVRTY_LOG_INF("********** OptionsExport Test End **********");
+
+    return test_overall_result;
+}
+
+typedef struct
+{
+    int     log         ;
+    int     level       ;
+    int     mode        ;
+    char    log_file[PATH_MAX + 1];
+
+} TrieTestValues;
+
+int DefineTrieOptions(TrieTestValues* values)
+{
+    int set_option_definition = GET_OPT_SUCCESS;
+
+    set_option_definition |= SetOptionDefinitionInt('a', "TrieLog", "Trie test.", 0, 9, 0, &values->log);
+    set_option_definition |= SetOptionDefinitionStringNL('b', "TrieLogFile", "Trie test.", "none", values->log_file);
+    set_option_definition |= SetOptionDefinitionInt('c', "TrieLevel", "Trie test.", 0, 9, 0, &values->level);
+    set_option_definition |= SetOptionDefinitionInt('d', "TrieMode", "Trie test.", 0, 9, 0, &values->mode);
+
+    return set_option_definition;
+}
+
+//////////////////////////////////////////////////////////////////////////////////
+/// @brief Gets long name completions (or suggestions) joined by commas.
+/// @param prefix Long name prefix (or mistyped long name).
+/// @param suggest Whether to get suggestions instead of completions.
+/// @param names Where to join long names, 256 bytes at least.
+/// @return Number of long names found, as CompleteOptionLong or SuggestOptionLong.
+//////////////////////////////////////////////////////////////////////////////////
+int JoinTrieNames(char* prefix, bool suggest, char* names)
+{
+    char* found_names[8];
+    int name_number = (suggest ? SuggestOptionLong(prefix, found_names, 8) : CompleteOptionLong(prefix, found_names, 8));
+
+    names[0] = '\0';
+
+    for(int i = 0; i < name_number && i < 8; i++)
+    {
+        strcat(names, i == 0 ? "" : ",");
+        strncat(names, found_names[i], 64);
+    }
+
+    return name_number;
+}
+
+int Test_OptionsTrie()
+{
+    SVRTY_LOG_INF("********** OptionsTrie Test Start **********");
+
+    struct
+    {
+        char*   opt_long        ;
+        char*   value           ;
+        int     expected_result ;
+        char*   expected_values ;
+
+    } trie_test_cases[] =
+    {
+        {"--TrieLog"        , "2"   , GET_OPT_SUCCESS               , "2 0 0 none"  },
+        {"--TrieLogF"       , "x"   , GET_OPT_SUCCESS               , "0 0 0 x"     },
+        {"--TrieLogFile=y"  , NULL  , GET_OPT_SUCCESS               , "0 0 0 y"     },
+        {"--TrieLe"         , "3"   , GET_OPT_SUCCESS               , "0 3 0 none"  },
+        {"--TrieM"          , "4"   , GET_OPT_SUCCESS               , "0 0 4 none"  },
+        {"--TrieL"          , "1"   , GET_OPT_ERR_AMBIGUOUS_OPTION  , NULL          },
+        {"--TrieLo"         , "1"   , GET_OPT_ERR_AMBIGUOUS_OPTION  , NULL          },
+        {"--TrieX"          , "1"   , GET_OPT_ERR_UNKNOWN_OPTION    , NULL          },
+        {"--TrieModes"      , "1"   , GET_OPT_ERR_UNKNOWN_OPTION    , NULL          },
+    };
+
+    TrieTestValues values = {};
+    char parsed_values[PATH_MAX + 64] = {};
+    int test_overall_result = TEST_FLG_SUCCESS;
+
+    for(int i = 0; i < sizeof(trie_test_cases) / sizeof(trie_test_cases[0]); i++)
+    {
+        int define_trie_options = DefineTrieOptions(&values);
+
+        optind = 0;
+        int argc = (trie_test_cases[i].value == NULL ? 2 : 3);
+        int parse_options = (define_trie_options < 0 ? define_trie_options : ParseOptions(argc, (char*[]){"TrieTest", trie_test_cases[i].opt_long, trie_test_cases[i].value, NULL}));
+
+        if(parse_options >= 0)
+        {
+            FreeOptionsStore();
+        }
+
+        snprintf(parsed_values, sizeof(parsed_values), "%d %d %d %s", values.log, values.level, values.mode, values.log_file);
+
+        if( parse_options != trie_test_cases[i].expected_result ||
+            (parse_options >= 0 && strcmp(parsed_values, trie_test_cases[i].expected_values) != 0))
+        {
+            SVRTY_LOG_ERR("Test %d failed.\tExpected %d, got %d (%s).", i, trie_test_cases[i].expected_result, parse_options, parsed_values);
+            test_overall_result = TEST_FLG_ERROR;
+            continue;
+        }
+
+        SVRTY_LOG_INF(TEST_MSG_SUCCEED, i);
+    }
+
+    // Completions and suggestions, then again once a long name sharing its prefix is removed and defined back.
+    struct
+    {
+        char*   prefix          ;
+        bool    suggest         ;
+        int     expected_number ;
+        char*   expected_names  ;
+
+    } name_test_cases[] =
+    {
+        {"TrieL"        , false , 3 , "TrieLevel,TrieLog,TrieLogFile"           },
+        {"TrieLog"      , false , 2 , "TrieLog,TrieLogFile"                     },
+        {"Trie"         , false , 4 , "TrieLevel,TrieLog,TrieLogFile,TrieMode"  },
+        {"TrieZ"        , false , 0 , ""                                        },
+        {"TrieLag"      , true  , 3 , "TrieLevel,TrieLog,TrieLogFile"           },
+        {"TrieModes"    , true  , 1 , "TrieMode"                                },
+        {"Xyz"          , true  , 0 , ""                                        },
+    };
+
+    char names[256] = {};
+    int define_trie_options = DefineTrieOptions(&values);
+
+    for(int i = 0; i < sizeof(name_test_cases) / sizeof(name_test_cases[0]); i++)
+    {
+        int name_number = JoinTrieNames(name_test_cases[i].prefix, name_test_cases[i].suggest, names);
+
+        if(name_number != name_test_cases[i].expected_number || strcmp(names, name_test_cases[i].expected_names) != 0)
+        {
+            SVRTY_LOG_ERR("Names of %s failed.\tExpected \"%s\", got %d: \"%s\".", name_test_cases[i].prefix, name_test_cases[i].expected_names, name_number, names);
+            test_overall_result = TEST_FLG_ERROR;
+        }
+    }
+
+    char removed_names[256] = {};
+    char reinserted_names[256] = {};
+    int remove_option_definition = RemoveOptionDefinition("TrieLog");
+    int removed_number = JoinTrieNames("TrieLo", false, removed_names);
+    int define_removed = SetOptionDefinitionInt('a', "TrieLog", "Trie test.", 0, 9, 0, &values.log);
+    int reinserted_number = JoinTrieNames("TrieLo", false, reinserted_names);
+
+    optind = 0;
+    int parse_options = ParseOptions(3, (char*[]){"TrieTest", "--TrieLog", "5", NULL});
+
+    if(parse_options >= 0)
+    {
+        FreeOptionsStore();
+    }
+
+    if( define_trie_options < 0 || remove_option_definition < 0 || define_removed < 0   ||
+        removed_number != 1 || strcmp(removed_names, "TrieLogFile") != 0                ||
+        reinserted_number != 2 || strcmp(reinserted_names, "TrieLog,TrieLogFile") != 0  ||
+        parse_options < 0 || values.log != 5                                            )
+    {
+        SVRTY_LOG_ERR("Unexpected removal (%d, %d, %d, %d): \"%s\", \"%s\", log = %d.", define_trie_options, remove_option_definition, define_removed, parse_options, removed_names, reinserted_names, values.log);
+        test_overall_result = TEST_FLG_ERROR;
+    }
+
+    if(test_overall_result < 0)
+    {
+        SVRTY_LOG_WNG("OptionsTrie test failed.");
+    }
+    else
+    {
+        SVRTY_LOG_INF("OptionsTrie test succeed!");
+    }
+
+    SVRTY_LOG_INF("********** OptionsTrie Test End **********");
+
+    return test_overall_result;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////
+/// @brief Test environment variable binding (SetOptionsEnvPrefix). Test cases above.
+///        Each one sets a single variable, then parses --env-threads with or without
+///        a config file and argv value.
+/// @return < 0 if any test went wrong, 0 otherwise.
+///////////////////////////////////////////////////////////////////////////////////////
+int Test_OptionsEnvironment()
+{
+    SVRTY_LOG_INF("********** OptionsEnvironment Test Start **********");
+
+    int number_of_tests = sizeof(Environment_Test_Cases) / sizeof(Environment_Test_Cases[0]);
+    int test_overall_result = TEST_FLG_SUCCESS;
+
+    // Prefixes longer than GET_OPT_SIZE_ENV_PREFIX_MAX are rejected.
+    if(SetOptionsEnvPrefix("GETOPT_TEST_PREFIX_LONGER_THAN_ALLOWED_") != GET_OPT_ERR_LONG_LENGTH_EXCEEDED)
+    {
+        SVRTY_LOG_ERR("Too long environment prefix accepted.");
+        test_overall_result = TEST_FLG_ERROR;
+    }
+
+    for(int i = 0; i < number_of_tests; i++)
+    {
+        Environment_Test_Case* test_case = &Environment_Test_Cases[i];
+        char config_path[] = "/tmp/GetOptionsConfigXXXXXX";
+
+        if(test_case->config_contents != NULL && CreateTestFile(config_path, test_case->config_contents) < 0)
+        {
+            SVRTY_LOG_ERR("Test %d failed.\tCould not write config file.", i);
+            test_overall_result = TEST_FLG_ERROR;
+            continue;
+        }
+
+        int env_threads = 0;
+        SetOptionDefinitionInt('e', "env-threads", "Environment test.", 1, 8, 2, &env_threads);
+        SetOptionsEnvPrefix(test_case->env_prefix);
+        setenv(test_case->env_name, test_case->env_value, 1);
+
+        if(test_case->config_contents != NULL)
+        {
+            LoadOptionsConfigFile(config_path);
+        }
+
+        optind = 0;
+        int parse_options = ParseOptions(test_case->argv_option == NULL ? 1 : 2, (char*[]){"EnvironmentTest", test_case->argv_option, NULL});
+        int env_threads_source = GetOptionSource(&env_threads);
+
+        if(parse_options >= 0)
+        {
+            FreeOptionsStore();
+        }
+
+        unsetenv(test_case->env_name);
+
+        if(test_case->config_contents != NULL)
+        {
+            unlink(config_path);
+        }
+
+        if( parse_options != test_case->expected_result ||
+            (parse_options >= 0 && (env_threads != test_case->expected_value || env_threads_source != test_case->expected_source)))
+        {
+            SVRTY_LOG_ERR("Test %d failed.\tExpected %d (value %d from %d), got %d (value %d from %d).", i, test_case->expected_result, test_case->expected_value, test_case->expected_source, parse_options, env_threads, env_threads_source);
+            test_overall_result = TEST_FLG_ERROR;
+            continue;
+        }
+
+        SVRTY_LOG_INF(TEST_MSG_SUCCEED, i);
+    }
+
+    SetOptionsEnvPrefix(NULL);
+
+    if(test_overall_result < 0)
+    {
+        SVRTY_LOG_WNG("OptionsEnvironment test failed.");
+    }
+    else
+    {
+        SVRTY_LOG_INF("OptionsEnvironment test succeed!");
+    }
+
+    SVRTY_LOG_INF("********** OptionsEnvironment Test End **********");
+
+    return test_overall_result;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Test binary schema files: options saved (one of them removed beforehand) are
+///        loaded back, bound and parsed, while corrupted or truncated files are rejected.
+/// @return < 0 if any test went wrong, 0 otherwise.
+////////////////////////////////////////////////////////////////////////////////////////
+int Test_OptionsSchema()
+{
+    SVRTY_LOG_INF("********** OptionsSchema Test Start **********");
+
+    int schema_level = 0;
+    double schema_ratio = 0.0;
+    int schema_gone = 0;
+    int test_overall_result = TEST_FLG_SUCCESS;
+
+    char schema_path[] = "/tmp/GetOptionsSchemaXXXXXX";
+    int create_test_file = CreateTestFile(schema_path, "");
+
+    SetOptionDefinitionInt('l', "SchemaLevel", "Schema test.", 0, 9, 4, &schema_level);
+    SetOptionDefinitionDouble('r', "SchemaRatio", "Schema test.", 0.0, 1.0, 0.5, &schema_ratio);
+    SetOptionDefinitionInt('g', "SchemaGone", "Schema test.", 0, 9, 1, &schema_gone);
+    int remove_option_definition = RemoveOptionDefinition("SchemaGone");
+    int save_schema = SaveOptionsSchema(schema_path);
+
+    // Options are only kept until parsed, so the registry is empty again afterwards.
+    optind = 0;
+    int parse_options = ParseOptions(1, (char*[]){"SchemaTest", NULL});
+
+    if(parse_options >= 0)
+    {
+        FreeOptionsStore();
+    }
+
+    if(create_test_file < 0 || remove_option_definition != GET_OPT_SUCCESS || save_schema != GET_OPT_SUCCESS || parse_options < 0)
+    {
+        SVRTY_LOG_ERR("Unexpected schema save (%d, %d, %d, %d).", create_test_file, remove_option_definition, save_schema, parse_options);
+        test_overall_result = TEST_FLG_ERROR;
+    }
+
+    // Any byte changed behind the checksum gets the whole file rejected.
+    struct stat schema_stat = {0};
+    int schema_fd = open(schema_path, O_RDWR);
+    char last_byte = 0;
+
+    if(schema_fd < 0 || fstat(schema_fd, &schema_stat) < 0 || pread(schema_fd, &last_byte, 1, schema_stat.st_size - 1) != 1)
+    {
+        SVRTY_LOG_ERR("Could not read the schema file back.");
+        test_overall_result = TEST_FLG_ERROR;
+    }
+
+    char corrupted_byte = last_byte ^ 0x01;
+    pwrite(schema_fd, &corrupted_byte, 1, schema_stat.st_size - 1);
+    int load_corrupted_schema = LoadOptionsSchema(schema_path);
+    pwrite(schema_fd, &last_byte, 1, schema_stat.st_size - 1);
+
+    // Loaded into an empty registry only, and removed options stay so.
+    int load_schema = LoadOptionsSchema(schema_path);
+    int load_schema_twice = LoadOptionsSchema(schema_path);
+    int bind_level = BindOptionDestination("SchemaLevel", &schema_level);
+    int bind_gone = BindOptionDestination("SchemaGone", &schema_gone);
+
+    optind = 0;
+    int parse_gone = ParseOptions(2, (char*[]){"SchemaTest", "--SchemaGone=2", NULL});
+
+    if( load_corrupted_schema   != GET_OPT_ERR_SCHEMA_FILE      ||
+        load_schema             != GET_OPT_SUCCESS              ||
+        load_schema_twice       != GET_OPT_ERR_SCHEMA_FILE      ||
+        bind_level              != GET_OPT_SUCCESS              ||
+        bind_gone               != GET_OPT_ERR_UNKNOWN_OPTION   ||
+        parse_gone              != GET_OPT_ERR_UNKNOWN_OPTION   )
+    {
+        SVRTY_LOG_ERR("Unexpected schema load (%d, %d, %d), bindings (%d, %d), parsing %d.", load_corrupted_schema, load_schema, load_schema_twice, bind_level, bind_gone, parse_gone);
+        test_overall_result = TEST_FLG_ERROR;
+    }
+
+    // Failed parsing frees the registry as well, so the schema is loaded once more. SchemaRatio is left unbound.
+    schema_level = 0;
+    schema_ratio = 0.0;
+
+    load_schema = LoadOptionsSchema(schema_path);
+    bind_level = BindOptionDestination("SchemaLevel", &schema_level);
+
+    optind = 0;
+    parse_options = ParseOptions(3, (char*[]){"SchemaTest", "--SchemaLevel=7", "--SchemaRatio=0.25", NULL});
+
+    if( load_schema                                 != GET_OPT_SUCCESS  ||
+        bind_level                                  != GET_OPT_SUCCESS  ||
+        parse_options                               < 0                 ||
+        schema_level                                != 7                ||
+        schema_ratio                                != 0.0              ||
+        GetOptInt(GetOptHandle("SchemaLevel"))      != 7                ||
+        GetOptDouble(GetOptHandle("SchemaRatio"))   != 0.25             ||
+        GetOptHandle("SchemaGone")                  >= 0                )
+    {
+        SVRTY_LOG_ERR("Unexpected schema values (%d, %d, %d), level = %d, ratio = %f.", load_schema, bind_level, parse_options, schema_level, schema_ratio);
+        test_overall_result = TEST_FLG_ERROR;
+    }
+
+    if(parse_options >= 0)
+    {
+        FreeOptionsStore();
+    }
+
+    // Truncated files do not match the image size in their header.
+    int truncate_schema = ftruncate(schema_fd, schema_stat.st_size - 1);
+    int load_truncated_schema = LoadOptionsSchema(schema_path);
+
+    if(truncate_schema < 0 || load_truncated_schema != GET_OPT_ERR_SCHEMA_FILE || LoadOptionsSchema("/tmp/GetOptionsSchemaMissing") != GET_OPT_ERR_SCHEMA_FILE)
+    {
+        SVRTY_LOG_ERR("Unexpected truncated schema load (%d, %d).", truncate_schema, load_truncated_schema);
+        test_overall_result = TEST_FLG_ERROR;
+    }
+
+    if(schema_fd >= 0)
+    {
+        close(schema_fd);
+    }
+
+    unlink(schema_path);
+
+    if(test_overall_result < 0)
+    {
+        SVRTY_LOG_WNG("OptionsSchema test failed.");
+    }
+    else
+    {
+        SVRTY_LOG_INF("OptionsSchema test succeed!");
+    }
+
+    SVRTY_LOG_INF("********** OptionsSchema Test End **********");
+
+    return test_overall_result;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////
+/// @brief Test reference string options (SetOptionDefinitionStringRef). Test cases
+///        above. Each one is parsed twice, the options arena being freed in between,
+///        so that values are copied into a brand new one the second time.
+/// @return < 0 if any test went wrong, 0 otherwise.
+///////////////////////////////////////////////////////////////////////////////////////
+int Test_OptionsStringRef()
+{
+    SVRTY_LOG_INF("********** OptionsStringRef Test Start **********");
+
+    int number_of_tests = sizeof(StringRef_Test_Cases) / sizeof(StringRef_Test_Cases[0]);
+    int test_overall_result = TEST_FLG_SUCCESS;
+
+    // Defaults must meet the maximum length as well.
+    char* ref_word = NULL;
+    int set_long_default = SetOptionDefinitionStringRef('w', "RefWord", "Reference string test.", GET_OPT_STR_MODE_ARENA, 3, "dflt", &ref_word);
+    int set_unknown_mode = SetOptionDefinitionStringRef('w', "RefWord", "Reference string test.", GET_OPT_STR_MODE_COPY, 0, "dflt", &ref_word);
+
+    if(set_long_default != GET_OPT_ERR_VAL_OUT_OF_BOUNDS || set_unknown_mode != GET_OPT_ERR_UNKNOWN_TYPE)
+    {
+        SVRTY_LOG_ERR("Unexpected reference string definitions (%d, %d).", set_long_default, set_unknown_mode);
+        test_overall_result = TEST_FLG_ERROR;
+    }
+
+    for(int i = 0; i < number_of_tests; i++)
+    {
+        StringRef_Test_Case* test_case = &StringRef_Test_Cases[i];
+        char config_path[] = "/tmp/GetOptionsConfigXXXXXX";
+        char argv_option[100] = {};
+        char default_value[] = "dflt";
+        int parse_options[2] = {};
+        bool test_passed = true;
+
+        if(test_case->config_contents != NULL && CreateTestFile(config_path, test_case->config_contents) < 0)
+        {
+            SVRTY_LOG_ERR("Test %d failed.\tCould not write config file.", i);
+            test_overall_result = TEST_FLG_ERROR;
+            continue;
+        }
+
+        if(test_case->argv_option != NULL)
+        {
+            strcpy(argv_option, test_case->argv_option);
+        }
+
+        for(int j = 0; j < 2; j++)
+        {
+            ref_word = NULL;
+            SetOptionDefinitionStringRef('w', "RefWord", "Reference string test.", test_case->str_mode, test_case->max_length, default_value, &ref_word);
+
+            if(test_case->config_contents != NULL)
+            {
+                LoadOptionsConfigFile(config_path);
+            }
+
+            optind = 0;
+            parse_options[j] = ParseOptions(test_case->argv_option == NULL ? 1 : 2, (char*[]){"StringRefTest", argv_option, NULL});
+
+            if(parse_options[j] >= 0)
+            {
+                FreeOptionsStore();
+            }
+
+            bool in_argv = (ref_word >= argv_option && ref_word < argv_option + sizeof(argv_option));
+
+            // Views of the default value point to it as is.
+            if( parse_options[j] != test_case->expected_result                                                      ||
+                (parse_options[j] >= 0 && (ref_word == NULL || strcmp(ref_word, test_case->expected_value) != 0))   ||
+                (parse_options[j] >= 0 && in_argv != test_case->expected_in_argv)                                   ||
+                (parse_options[j] >= 0 && test_case->str_mode == GET_OPT_STR_MODE_VIEW && test_case->argv_option == NULL && test_case->config_contents == NULL && ref_word != default_value))
+            {
+                test_passed = false;
+            }
+
+            FreeOptionsArena();
+        }
+
+        if(test_case->config_contents != NULL)
+        {
+            unlink(config_path);
+        }
+
+        if(!test_passed)
+        {
+            SVRTY_LOG_ERR("Test %d failed.\tExpected %d (%s), got %d and %d.", i, test_case->expected_result, test_case->expected_value, parse_options[0], parse_options[1]);
+            test_overall_result = TEST_FLG_ERROR;
+            continue;
+        }
+
+        SVRTY_LOG_INF(TEST_MSG_SUCCEED, i);
+    }
+
+    if(test_overall_result < 0)
+    {
+        SVRTY_LOG_WNG("OptionsStringRef test failed.");
+    }
+    else
+    {
+        SVRTY_LOG_INF("OptionsStringRef test succeed!");
+    }
+
+    SVRTY_LOG_INF("********** OptionsStringRef Test End **********");
+
+    return test_overall_result;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Test constraint groups (SetOptionsConstraint). Test cases above. Errors are
+///        recorded in a diagnostics record, so that the offending option is checked too.
+/// @return < 0 if any test went wrong, 0 otherwise.
+////////////////////////////////////////////////////////////////////////////////////////
+int Test_OptionsConstraints()
+{
+    SVRTY_LOG_INF("********** OptionsConstraints Test Start **********");
+
+    int number_of_tests = sizeof(Constraint_Test_Cases) / sizeof(Constraint_Test_Cases[0]);
+    int group_values[3] = {};
+    int test_overall_result = TEST_FLG_SUCCESS;
+
+    // Wrong constraints are rejected when set: unknown type, not enough options or unknown ones.
+    BeginOptionsRegistration();
+    SetOptionDefinitionInt('a', "GroupA", "Constraint test.", 0, 9, 0, &group_values[0]);
+
+    int set_unknown_type = SetOptionsConstraint(GET_OPT_CONSTRAINT_MAX + 1, (char*[]){"GroupA"}, 1);
+    int set_lone_dependent = SetOptionsConstraint(GET_OPT_CONSTRAINT_DEPENDENT, (char*[]){"GroupA"}, 1);
+    int set_unknown_option = SetOptionsConstraint(GET_OPT_CONSTRAINT_REQUIRED, (char*[]){"GroupA", "GroupUnknown"}, 2);
+
+    AbortOptionsRegistration();
+
+    if( set_unknown_type    != GET_OPT_ERR_CONSTRAINT_DEF   ||
+        set_lone_dependent  != GET_OPT_ERR_CONSTRAINT_DEF   ||
+        set_unknown_option  != GET_OPT_ERR_UNKNOWN_OPTION   )
+    {
+        SVRTY_LOG_ERR("Unexpected constraint definitions (%d, %d, %d).", set_unknown_type, set_lone_dependent, set_unknown_option);
+        test_overall_result = TEST_FLG_ERROR;
+    }
+
+    for(int i = 0; i < number_of_tests; i++)
+    {
+        Constraint_Test_Case* test_case = &Constraint_Test_Cases[i];
+        char* argv[5] = {"ConstraintTest"};
+        int argc = 1;
+        int group_size = 0;
+        GET_OPT_DIAG diag = {};
+
+        SetOptionDefinitionInt('a', "GroupA", "Constraint test.", 0, 9, 0, &group_values[0]);
+        SetOptionDefinitionInt('b', "GroupB", "Constraint test.", 0, 9, 0, &group_values[1]);
+        SetOptionDefinitionInt('c', "GroupC", "Constraint test.", 0, 9, 0, &group_values[2]);
+
+        while(group_size < 3 && test_case->group[group_size] != NULL)
+        {
+            group_size++;
+        }
+
+        while(argc <= 3 && test_case->argv_options[argc - 1] != NULL)
+        {
+            argv[argc] = test_case->argv_options[argc - 1];
+            argc++;
+        }
+
+        int set_options_constraint = SetOptionsConstraint(test_case->constraint_type, test_case->group, group_size);
+
+        SetOptionsDiagnostics(&diag);
+
+        optind = 0;
+        int parse_options = ParseOptions(argc, argv);
+
+        SetOptionsDiagnostics(NULL);
+
+        if(parse_options >= 0)
+        {
+            FreeOptionsStore();
+        }
+
+        if( set_options_constraint  != GET_OPT_SUCCESS                                                      ||
+            parse_options           != test_case->expected_result                                           ||
+            (parse_options < 0 && (diag.code != parse_options || strcmp(diag.opt_long, test_case->expected_offender) != 0)))
+        {
+            SVRTY_LOG_ERR("Test %d failed.\tExpected %d (%s), got %d (%s).", i, test_case->expected_result, test_case->expected_offender, parse_options, diag.opt_long);
+            test_overall_result = TEST_FLG_ERROR;
+            continue;
+        }
+
+        SVRTY_LOG_INF(TEST_MSG_SUCCEED, i);
+    }
+
+    if(test_overall_result < 0)
+    {
+        SVRTY_LOG_WNG("OptionsConstraints test failed.");
+    }
+    else
+    {
+        SVRTY_LOG_INF("OptionsConstraints test succeed!");
+    }
+
+    SVRTY_LOG_INF("********** OptionsConstraints Test End **********");
+
+    return test_overall_result;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////
+/// @brief Test choice options (SetOptionDefinitionChoice): given choices store their
+///        index, while anything else (prefixes and case included) is rejected.
+/// @return < 0 if any test went wrong, 0 otherwise.
+///////////////////////////////////////////////////////////////////////////////////////
+int Test_OptionsChoice()
+{
+    SVRTY_LOG_INF("********** OptionsChoice Test Start **********");
+
+    struct
+    {
+        char*   argv_option     ;
+        char*   value           ;
+        int     expected_result ;
+        int     expected_index  ;
+
+    } choice_test_cases[] =
+    {
+        {NULL           , NULL          , GET_OPT_SUCCESS               , 1 },
+        {"--ChoiceMode" , "fast"        , GET_OPT_SUCCESS               , 0 },
+        {"--ChoiceMode" , "safe"        , GET_OPT_SUCCESS               , 1 },
+        {"-m"           , "paranoid"    , GET_OPT_SUCCESS               , 2 },
+        {"--ChoiceMode" , "Fast"        , GET_OPT_ERR_UNKNOWN_CHOICE    , 0 },
+        {"--ChoiceMode" , "fas"         , GET_OPT_ERR_UNKNOWN_CHOICE    , 0 },
+        {"--ChoiceMode" , "fastest"     , GET_OPT_ERR_UNKNOWN_CHOICE    , 0 },
+        {"-m"           , ""            , GET_OPT_ERR_UNKNOWN_CHOICE    , 0 },
+    };
+
+    char* choices[] = {"fast", "safe", "paranoid"};
+    int choice_mode = -1;
+    int test_overall_result = TEST_FLG_SUCCESS;
+
+    // Empty, NULL or repeated choices are rejected, and so are defaults past the last choice.
+    int set_empty_choices = SetOptionDefinitionChoice('m', "ChoiceMode", "Choice test.", choices, 0, 0, &choice_mode);
+    int set_null_choice = SetOptionDefinitionChoice('m', "ChoiceMode", "Choice test.", (char*[]){"fast", NULL}, 2, 0, &choice_mode);
+    int set_repeated_choice = SetOptionDefinitionChoice('m', "ChoiceMode", "Choice test.", (char*[]){"fast", "safe", "fast"}, 3, 0, &choice_mode);
+    int set_wrong_default = SetOptionDefinitionChoice('m', "ChoiceMode", "Choice test.", choices, 3, 3, &choice_mode);
+
+    if( set_empty_choices   != GET_OPT_ERR_CHOICE_DEF           ||
+        set_null_choice     != GET_OPT_ERR_CHOICE_DEF           ||
+        set_repeated_choice != GET_OPT_ERR_CHOICE_DEF           ||
+        set_wrong_default   != GET_OPT_ERR_VAL_OUT_OF_BOUNDS    )
+    {
+        SVRTY_LOG_ERR("Unexpected choice definitions (%d, %d, %d, %d).", set_empty_choices, set_null_choice, set_repeated_choice, set_wrong_default);
+        test_overall_result = TEST_FLG_ERROR;
+    }
+
+    for(int i = 0; i < sizeof(choice_test_cases) / sizeof(choice_test_cases[0]); i++)
+    {
+        choice_mode = -1;
+        SetOptionDefinitionChoice('m', "ChoiceMode", "Choice test.", choices, 3, 1, &choice_mode);
+
+        optind = 0;
+        int parse_options = ParseOptions(choice_test_cases[i].argv_option == NULL ? 1 : 3, (char*[]){"ChoiceTest", choice_test_cases[i].argv_option, choice_test_cases[i].value, NULL});
+
+        if(parse_options >= 0)
+        {
+            FreeOptionsStore();
+        }
+
+        if( parse_options != choice_test_cases[i].expected_result ||
+            (parse_options >= 0 && choice_mode != choice_test_cases[i].expected_index))
+        {
+            SVRTY_LOG_ERR("Test %d failed.\tExpected %d (index %d), got %d (index %d).", i, choice_test_cases[i].expected_result, choice_test_cases[i].expected_index, parse_options, choice_mode);
+            test_overall_result = TEST_FLG_ERROR;
+            continue;
+        }
+
+        SVRTY_LOG_INF(TEST_MSG_SUCCEED, i);
+    }
+
+    if(test_overall_result < 0)
+    {
+        SVRTY_LOG_WNG("OptionsChoice test failed.");
+    }
+    else
+    {
+        SVRTY_LOG_INF("OptionsChoice test succeed!");
+    }
+
+    SVRTY_LOG_INF("********** OptionsChoice Test End **********");
+
+    return test_overall_result;
+}
+
+int main(int argc, char **argv)
+{
+    SeverityLogInitWithMask(1000, 0xFF);
+
+    Test_SetOptionDefinition();
+
+    Test_OptionsDiagnostics();
+
+    TestParseOptions(argc, argv);
+
+    Test_OptionsConfigFile();
+
+    Test_OptionsCacheFile();
+
+    Test_OptionsReload();
+
+    Test_OptionsShared();
+
+    Test_OptionsFlagSet();
+
+    Test_OptionsRemoval();
+
+    Test_OptionsStringConstraint();
+
+    Test_OptionsConverters();
+
+    Test_OptionsBlobs();
+
+    Test_OptionsCmdline();
+
+    Test_OptionsStream();
+
+    Test_OptionsArgv();
+
+    Test_OptionsExport();
+
+    Test_OptionsTrie();
+
+    Test_OptionsEnvironment();
+
+    Test_OptionsSchema();
+
+    Test_OptionsStringRef();
+
+    Test_OptionsConstraints();
+
+    Test_OptionsChoice();
 
     return 0;
 }